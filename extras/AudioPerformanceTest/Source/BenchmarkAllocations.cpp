@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BenchmarkRunner.h"
+
+//==============================================================================
+// Replacing the global allocation functions lets the runner count how often a
+// workload allocates while it is being timed. They live in their own file so
+// that the compiler can't inline them into the code being measured.
+void* operator new (std::size_t size)
+{
+    AllocationCounter::registerAllocation();
+
+    if (auto* p = std::malloc (size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    AllocationCounter::registerAllocation();
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+void operator delete (void* p) noexcept                           { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept              { std::free (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept    { std::free (p); }
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BenchmarkWorkloads.h"
+
+//==============================================================================
+class ConsoleLogger : public Logger
+{
+    void logMessage (const String& message) override
+    {
+        std::cout << message << std::endl;
+
+       #if JUCE_WINDOWS
+        Logger::outputDebugString (message);
+       #endif
+    }
+};
+
+static Array<int> parseIntList (const String& list)
+{
+    Array<int> result;
+
+    for (auto& token : StringArray::fromTokens (list, ",", {}))
+        if (token.getIntValue() > 0)
+            result.add (token.getIntValue());
+
+    return result;
+}
+
+//==============================================================================
+int main (int argc, char **argv)
+{
+    ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << argv[0] << " [--help|-h] [--list] [--filter=name] [--block-sizes=64,256,1024] [--channels=1,2]" << std::endl
+                  << "    [--samples=numSamplesPerRun] [--json=outputFile] [--baseline=baselineFile] [--tolerance=percent]" << std::endl;
+        return 0;
+    }
+
+    // The graph updates itself synchronously when called from the message thread
+    ScopedJuceInitialiser_GUI libraryInitialiser;
+
+    auto benchmarks = createAllBenchmarks();
+
+    if (args.containsOption ("--list"))
+    {
+        for (auto& b : benchmarks)
+            std::cout << b->getName() << std::endl;
+
+        return 0;
+    }
+
+    ConsoleLogger logger;
+    Logger::setCurrentLogger (&logger);
+
+    auto getOption = [&args] (StringRef option, const String& defaultValue)
+    {
+        return args.containsOption (option) ? args.getValueForOption (option) : defaultValue;
+    };
+
+    auto blockSizes  = parseIntList (getOption ("--block-sizes", "64,256,1024"));
+    auto channels    = parseIntList (getOption ("--channels", "1,2"));
+    auto filter      = getOption ("--filter", {});
+    auto tolerance   = getOption ("--tolerance", "10").getDoubleValue() / 100.0;
+
+    BenchmarkRunner runner;
+
+    if (args.containsOption ("--samples"))
+        runner.numSamplesToMeasure = jmax (1, getOption ("--samples", {}).getIntValue());
+
+    Logger::writeToLog (BenchmarkRunner::getHeader());
+
+    Array<BenchmarkResult> results;
+
+    for (auto& benchmark : benchmarks)
+    {
+        if (filter.isNotEmpty() && ! benchmark->getName().containsIgnoreCase (filter))
+            continue;
+
+        for (auto numChannels : channels)
+        {
+            for (auto blockSize : blockSizes)
+            {
+                BenchmarkConfig config;
+                config.blockSize = blockSize;
+                config.numChannels = numChannels;
+
+                auto result = runner.run (*benchmark, config);
+                Logger::writeToLog (BenchmarkRunner::format (result));
+                results.add (result);
+            }
+        }
+    }
+
+    int exitCode = 0;
+
+    if (args.containsOption ("--json"))
+    {
+        auto file = args.getFileForOption ("--json");
+
+        if (! file.replaceWithText (JSON::toString (BenchmarkRunner::toJSON (results))))
+        {
+            Logger::writeToLog ("Couldn't write " + file.getFullPathName());
+            exitCode = 1;
+        }
+    }
+
+    if (args.containsOption ("--baseline"))
+    {
+        auto file = args.getFileForOption ("--baseline");
+
+        if (! file.existsAsFile())
+        {
+            Logger::writeToLog ("Couldn't find " + file.getFullPathName());
+            Logger::setCurrentLogger (nullptr);
+            return 1;
+        }
+
+        auto baseline = BenchmarkRunner::fromJSON (JSON::parse (file));
+
+        Logger::writeToLog ({});
+        Logger::writeToLog ("comparison with " + file.getFileName()
+                              + " (median, tolerance " + String (tolerance * 100.0, 1) + "%)");
+
+        auto numRegressions = BenchmarkRunner::compareWithBaseline (results, baseline, tolerance);
+
+        if (numRegressions > 0)
+        {
+            Logger::writeToLog (String (numRegressions) + " regression(s) found");
+            exitCode = 1;
+        }
+    }
+
+    Logger::setCurrentLogger (nullptr);
+    return exitCode;
+}
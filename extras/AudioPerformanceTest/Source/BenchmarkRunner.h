@@ -0,0 +1,320 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <chrono>
+
+//==============================================================================
+/** Counts the heap allocations made by the benchmarking thread.
+
+    The global operator new replacement in BenchmarkAllocations.cpp calls
+    registerAllocation(), which only counts while a measurement is running on
+    the calling thread, so background threads (e.g. the Convolution loader)
+    don't pollute the results.
+*/
+struct AllocationCounter
+{
+    static void registerAllocation() noexcept
+    {
+        if (isCountingOnThisThread())
+            ++getCount();
+    }
+
+    static void startCounting() noexcept     { getCount() = 0; isCountingOnThisThread() = true; }
+    static int64 stopCounting() noexcept     { isCountingOnThisThread() = false; return getCount(); }
+
+private:
+    static std::atomic<int64>& getCount() noexcept
+    {
+        static std::atomic<int64> count { 0 };
+        return count;
+    }
+
+    static bool& isCountingOnThisThread() noexcept
+    {
+        static thread_local bool counting = false;
+        return counting;
+    }
+};
+
+//==============================================================================
+/** The block size, channel count and sample rate that a benchmark runs at. */
+struct BenchmarkConfig
+{
+    int blockSize = 256;
+    int numChannels = 2;
+    double sampleRate = 48000.0;
+
+    dsp::ProcessSpec toProcessSpec() const noexcept
+    {
+        return { sampleRate, (uint32) blockSize, (uint32) numChannels };
+    }
+};
+
+//==============================================================================
+/** A fixed workload that can be driven block-by-block without an audio device. */
+class Benchmark
+{
+public:
+    virtual ~Benchmark() = default;
+
+    /** Returns the name used to identify this workload in reports and baselines. */
+    virtual String getName() const = 0;
+
+    /** Called before measuring each configuration. Allocations made here aren't counted. */
+    virtual void prepare (const BenchmarkConfig&) = 0;
+
+    /** Processes one block in place. This is the part that gets timed. */
+    virtual void process (AudioBuffer<float>&) = 0;
+};
+
+//==============================================================================
+/** The measurements for one benchmark at one configuration.
+
+    All timings are in nanoseconds per sample, where a sample is one value in
+    one channel, so that different block sizes and channel counts can be
+    compared directly.
+*/
+struct BenchmarkResult
+{
+    String name;
+    int blockSize = 0, numChannels = 0, numBlocks = 0;
+    double meanNsPerSample = 0, p50NsPerSample = 0, p90NsPerSample = 0, p99NsPerSample = 0, maxNsPerSample = 0;
+    double allocationsPerBlock = 0;
+
+    String getKey() const
+    {
+        return name + " " + String (blockSize) + "x" + String (numChannels);
+    }
+
+    var toVar() const
+    {
+        auto* obj = new DynamicObject();
+        obj->setProperty ("name",                name);
+        obj->setProperty ("blockSize",           blockSize);
+        obj->setProperty ("numChannels",         numChannels);
+        obj->setProperty ("numBlocks",           numBlocks);
+        obj->setProperty ("meanNsPerSample",     meanNsPerSample);
+        obj->setProperty ("p50NsPerSample",      p50NsPerSample);
+        obj->setProperty ("p90NsPerSample",      p90NsPerSample);
+        obj->setProperty ("p99NsPerSample",      p99NsPerSample);
+        obj->setProperty ("maxNsPerSample",      maxNsPerSample);
+        obj->setProperty ("allocationsPerBlock", allocationsPerBlock);
+        return var (obj);
+    }
+
+    static BenchmarkResult fromVar (const var& v)
+    {
+        BenchmarkResult r;
+        r.name                = v["name"].toString();
+        r.blockSize           = (int) v["blockSize"];
+        r.numChannels         = (int) v["numChannels"];
+        r.numBlocks           = (int) v["numBlocks"];
+        r.meanNsPerSample     = (double) v["meanNsPerSample"];
+        r.p50NsPerSample      = (double) v["p50NsPerSample"];
+        r.p90NsPerSample      = (double) v["p90NsPerSample"];
+        r.p99NsPerSample      = (double) v["p99NsPerSample"];
+        r.maxNsPerSample      = (double) v["maxNsPerSample"];
+        r.allocationsPerBlock = (double) v["allocationsPerBlock"];
+        return r;
+    }
+};
+
+//==============================================================================
+/** Runs benchmarks, collects per-block timings and compares them with a baseline. */
+class BenchmarkRunner
+{
+public:
+    // Time::getHighResolutionTicks() only has microsecond resolution on some
+    // platforms, which is too coarse for timing small blocks.
+    using Clock = std::chrono::steady_clock;
+
+    /** The number of untimed blocks processed before measuring, which gives
+        lazily-initialised processors a chance to settle.
+    */
+    int numWarmupBlocks = 32;
+
+    /** The number of samples per channel to measure for each configuration. */
+    int numSamplesToMeasure = 1 << 18;
+
+    //==============================================================================
+    BenchmarkResult run (Benchmark& benchmark, const BenchmarkConfig& config)
+    {
+        benchmark.prepare (config);
+
+        AudioBuffer<float> source (config.numChannels, config.blockSize);
+        AudioBuffer<float> buffer (config.numChannels, config.blockSize);
+
+        Random random (0x1234);
+
+        for (int ch = 0; ch < source.getNumChannels(); ++ch)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                source.setSample (ch, i, random.nextFloat() * 0.5f - 0.25f);
+
+        for (int i = 0; i < numWarmupBlocks; ++i)
+        {
+            buffer.makeCopyOf (source, true);
+            benchmark.process (buffer);
+        }
+
+        auto numBlocks = jmax (16, numSamplesToMeasure / config.blockSize);
+
+        std::vector<double> blockTimes;
+        blockTimes.reserve ((size_t) numBlocks);
+
+        int64 numAllocations = 0;
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            buffer.makeCopyOf (source, true);
+
+            AllocationCounter::startCounting();
+            auto start = Clock::now();
+
+            benchmark.process (buffer);
+
+            auto end = Clock::now();
+            numAllocations += AllocationCounter::stopCounting();
+
+            blockTimes.push_back ((double) std::chrono::duration_cast<std::chrono::nanoseconds> (end - start).count());
+        }
+
+        std::sort (blockTimes.begin(), blockTimes.end());
+
+        auto samplesPerBlock = (double) (config.blockSize * config.numChannels);
+        auto percentile = [&] (double p)
+        {
+            auto index = jlimit ((size_t) 0, blockTimes.size() - 1, (size_t) (p * (double) (blockTimes.size() - 1) + 0.5));
+            return blockTimes[index] / samplesPerBlock;
+        };
+
+        BenchmarkResult result;
+        result.name                = benchmark.getName();
+        result.blockSize           = config.blockSize;
+        result.numChannels         = config.numChannels;
+        result.numBlocks           = numBlocks;
+        result.meanNsPerSample     = std::accumulate (blockTimes.begin(), blockTimes.end(), 0.0) / (samplesPerBlock * numBlocks);
+        result.p50NsPerSample      = percentile (0.5);
+        result.p90NsPerSample      = percentile (0.9);
+        result.p99NsPerSample      = percentile (0.99);
+        result.maxNsPerSample      = blockTimes.back() / samplesPerBlock;
+        result.allocationsPerBlock = (double) numAllocations / numBlocks;
+        return result;
+    }
+
+    //==============================================================================
+    static String getHeader()
+    {
+        return String ("benchmark").paddedRight (' ', 40)
+             + "mean    p50     p90     p99     max     | allocs/block"
+             + newLine
+             + String ("(ns/sample)").paddedRight (' ', 40)
+             + "-----   -----   -----   -----   -----   | -----";
+    }
+
+    static String format (const BenchmarkResult& r)
+    {
+        auto f = [] (double v) { return String (v, 2).paddedRight (' ', 8); };
+
+        return r.getKey().paddedRight (' ', 40)
+             + f (r.meanNsPerSample) + f (r.p50NsPerSample) + f (r.p90NsPerSample)
+             + f (r.p99NsPerSample) + f (r.maxNsPerSample) + "| " + String (r.allocationsPerBlock, 2);
+    }
+
+    //==============================================================================
+    static var toJSON (const Array<BenchmarkResult>& results)
+    {
+        Array<var> list;
+
+        for (auto& r : results)
+            list.add (r.toVar());
+
+        auto* obj = new DynamicObject();
+        obj->setProperty ("version", 1);
+        obj->setProperty ("results", list);
+        return var (obj);
+    }
+
+    static Array<BenchmarkResult> fromJSON (const var& json)
+    {
+        Array<BenchmarkResult> results;
+
+        if (auto* list = json["results"].getArray())
+            for (auto& v : *list)
+                results.add (BenchmarkResult::fromVar (v));
+
+        return results;
+    }
+
+    //==============================================================================
+    /** Compares results against a baseline and logs any regressions.
+
+        A result regresses if its median time grows by more than the given
+        fraction, or if it allocates more often than the baseline did. Medians
+        are used rather than means because they're much less sensitive to
+        scheduling noise on a shared machine.
+
+        @returns the number of regressions found
+    */
+    static int compareWithBaseline (const Array<BenchmarkResult>& results,
+                                    const Array<BenchmarkResult>& baseline,
+                                    double tolerance)
+    {
+        int numRegressions = 0;
+
+        for (auto& r : results)
+        {
+            auto* old = std::find_if (baseline.begin(), baseline.end(),
+                                      [&r] (const BenchmarkResult& b) { return b.getKey() == r.getKey(); });
+
+            if (old == baseline.end())
+            {
+                Logger::writeToLog (r.getKey().paddedRight (' ', 40) + "(not in baseline)");
+                continue;
+            }
+
+            auto ratio = old->p50NsPerSample > 0 ? r.p50NsPerSample / old->p50NsPerSample : 1.0;
+            auto slower = ratio > 1.0 + tolerance;
+            auto moreAllocations = r.allocationsPerBlock > old->allocationsPerBlock + 0.01;
+
+            auto line = r.getKey().paddedRight (' ', 40)
+                      + (String (100.0 * (ratio - 1.0), 1) + "%").paddedRight (' ', 10);
+
+            if (slower)           line << " SLOWER";
+            if (moreAllocations)  line << " ALLOCATES (" << String (old->allocationsPerBlock, 2)
+                                       << " -> " << String (r.allocationsPerBlock, 2) << ")";
+
+            Logger::writeToLog (line);
+
+            if (slower || moreAllocations)
+                ++numRegressions;
+        }
+
+        return numRegressions;
+    }
+};
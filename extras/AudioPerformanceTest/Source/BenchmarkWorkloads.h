@@ -0,0 +1,425 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BenchmarkRunner.h"
+
+//==============================================================================
+/** Wraps any juce_dsp processor that has prepare() and process (ProcessContextReplacing). */
+template <typename Processor>
+class DSPProcessorBenchmark  : public Benchmark
+{
+public:
+    using Setup = std::function<void (Processor&, const BenchmarkConfig&)>;
+
+    DSPProcessorBenchmark (String benchmarkName, Setup setupFn)
+        : name (std::move (benchmarkName)), setup (std::move (setupFn))
+    {}
+
+    String getName() const override   { return name; }
+
+    void prepare (const BenchmarkConfig& config) override
+    {
+        processor = std::make_unique<Processor>();
+        setup (*processor, config);
+        processor->prepare (config.toProcessSpec());
+    }
+
+    void process (AudioBuffer<float>& buffer) override
+    {
+        dsp::AudioBlock<float> block (buffer);
+        processor->process (dsp::ProcessContextReplacing<float> (block));
+    }
+
+private:
+    String name;
+    Setup setup;
+    std::unique_ptr<Processor> processor;
+};
+
+//==============================================================================
+class ConvolutionBenchmark  : public Benchmark
+{
+public:
+    String getName() const override   { return "Convolution"; }
+
+    void prepare (const BenchmarkConfig& config) override
+    {
+        // A one second stereo reverb tail, with an exponentially decaying noise IR
+        auto irLength = (int) config.sampleRate;
+        AudioBuffer<float> ir (2, irLength);
+        Random random (0x4321);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < irLength; ++i)
+                ir.setSample (ch, i, (random.nextFloat() * 2.0f - 1.0f) * std::exp (-6.0f * (float) i / (float) irLength));
+
+        convolution = std::make_unique<dsp::Convolution>();
+        convolution->loadImpulseResponse (std::move (ir), config.sampleRate,
+                                          dsp::Convolution::Stereo::yes,
+                                          dsp::Convolution::Trim::no,
+                                          dsp::Convolution::Normalise::yes);
+        convolution->prepare (config.toProcessSpec());
+    }
+
+    void process (AudioBuffer<float>& buffer) override
+    {
+        dsp::AudioBlock<float> block (buffer);
+        convolution->process (dsp::ProcessContextReplacing<float> (block));
+    }
+
+private:
+    std::unique_ptr<dsp::Convolution> convolution;
+};
+
+//==============================================================================
+class OversamplingBenchmark  : public Benchmark
+{
+public:
+    OversamplingBenchmark (int factorLog2, dsp::Oversampling<float>::FilterType type, String typeName)
+        : factor (factorLog2), filterType (type), name ("Oversampling " + String (1 << factorLog2) + "x " + typeName)
+    {}
+
+    String getName() const override   { return name; }
+
+    void prepare (const BenchmarkConfig& config) override
+    {
+        oversampling = std::make_unique<dsp::Oversampling<float>> ((size_t) config.numChannels, (size_t) factor, filterType);
+        oversampling->initProcessing ((size_t) config.blockSize);
+    }
+
+    void process (AudioBuffer<float>& buffer) override
+    {
+        dsp::AudioBlock<float> block (buffer);
+        auto upsampled = oversampling->processSamplesUp (block);
+        upsampled.multiplyBy (0.5f);
+        oversampling->processSamplesDown (block);
+    }
+
+private:
+    int factor;
+    dsp::Oversampling<float>::FilterType filterType;
+    String name;
+    std::unique_ptr<dsp::Oversampling<float>> oversampling;
+};
+
+//==============================================================================
+/** Forward and inverse real FFTs of one block per channel. */
+class FFTBenchmark  : public Benchmark
+{
+public:
+    String getName() const override   { return "FFT real forward+inverse"; }
+
+    void prepare (const BenchmarkConfig& config) override
+    {
+        fft = std::make_unique<dsp::FFT> (roundToInt (std::log2 (nextPowerOfTwo (config.blockSize))));
+        fftData.assign ((size_t) fft->getSize() * 2, 0.0f);
+    }
+
+    void process (AudioBuffer<float>& buffer) override
+    {
+        auto numSamples = jmin (buffer.getNumSamples(), fft->getSize());
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            std::fill (fftData.begin(), fftData.end(), 0.0f);
+            FloatVectorOperations::copy (fftData.data(), buffer.getReadPointer (ch), numSamples);
+
+            fft->performRealOnlyForwardTransform (fftData.data());
+            fft->performRealOnlyInverseTransform (fftData.data());
+
+            FloatVectorOperations::copy (buffer.getWritePointer (ch), fftData.data(), numSamples);
+        }
+    }
+
+private:
+    std::unique_ptr<dsp::FFT> fft;
+    std::vector<float> fftData;
+};
+
+//==============================================================================
+class SynthesiserBenchmark  : public Benchmark
+{
+public:
+    String getName() const override   { return "Synthesiser 16 voices"; }
+
+    void prepare (const BenchmarkConfig& config) override
+    {
+        synth.clearVoices();
+        synth.clearSounds();
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new SineVoice());
+
+        synth.addSound (new SineSound());
+        synth.setCurrentPlaybackSampleRate (config.sampleRate);
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.noteOn (1, 48 + i * 2, 0.5f);
+    }
+
+    void process (AudioBuffer<float>& buffer) override
+    {
+        buffer.clear();
+        synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+    }
+
+private:
+    struct SineSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override      { return true; }
+        bool appliesToChannel (int) override   { return true; }
+    };
+
+    struct SineVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound* sound) override
+        {
+            return dynamic_cast<SineSound*> (sound) != nullptr;
+        }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            angle = 0.0;
+            level = velocity * 0.1;
+            angleDelta = MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate() * MathConstants<double>::twoPi;
+        }
+
+        void stopNote (float, bool) override     { clearCurrentNote(); }
+        void pitchWheelMoved (int) override       {}
+        void controllerMoved (int, int) override  {}
+
+        void renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override
+        {
+            while (--numSamples >= 0)
+            {
+                auto sample = (float) (std::sin (angle) * level);
+
+                for (auto i = outputBuffer.getNumChannels(); --i >= 0;)
+                    outputBuffer.addSample (i, startSample, sample);
+
+                angle += angleDelta;
+                ++startSample;
+            }
+        }
+
+        double angle = 0, angleDelta = 0, level = 0;
+    };
+
+    static constexpr int numVoices = 16;
+
+    Synthesiser synth;
+    MidiBuffer midi;
+};
+
+//==============================================================================
+/** Four parallel chains of two gain nodes each, summed into the graph's output. */
+class AudioProcessorGraphBenchmark  : public Benchmark
+{
+public:
+    String getName() const override   { return "AudioProcessorGraph 4x2 nodes"; }
+
+    void prepare (const BenchmarkConfig& config) override
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        graph = std::make_unique<AudioProcessorGraph>();
+        graph->setPlayConfigDetails (config.numChannels, config.numChannels, config.sampleRate, config.blockSize);
+
+        auto input  = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode));
+        auto output = graph->addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode));
+
+        for (int chain = 0; chain < 4; ++chain)
+        {
+            auto previous = input;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                auto node = graph->addNode (std::make_unique<GainProcessor> (config.numChannels));
+                connect (previous, node, config.numChannels);
+                previous = node;
+            }
+
+            connect (previous, output, config.numChannels);
+        }
+
+        graph->prepareToPlay (config.sampleRate, config.blockSize);
+    }
+
+    void process (AudioBuffer<float>& buffer) override
+    {
+        graph->processBlock (buffer, midi);
+    }
+
+private:
+    struct GainProcessor  : public AudioProcessor
+    {
+        explicit GainProcessor (int numChannels)
+            : AudioProcessor (BusesProperties().withInput  ("Input",  AudioChannelSet::canonicalChannelSet (numChannels))
+                                               .withOutput ("Output", AudioChannelSet::canonicalChannelSet (numChannels)))
+        {}
+
+        const String getName() const override                     { return "Gain"; }
+        void prepareToPlay (double, int) override                  {}
+        void releaseResources() override                           {}
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override   { buffer.applyGain (0.5f); }
+        double getTailLengthSeconds() const override               { return 0; }
+        bool acceptsMidi() const override                          { return false; }
+        bool producesMidi() const override                         { return false; }
+        AudioProcessorEditor* createEditor() override              { return nullptr; }
+        bool hasEditor() const override                            { return false; }
+        int getNumPrograms() override                              { return 1; }
+        int getCurrentProgram() override                           { return 0; }
+        void setCurrentProgram (int) override                      {}
+        const String getProgramName (int) override                 { return {}; }
+        void changeProgramName (int, const String&) override       {}
+        void getStateInformation (MemoryBlock&) override           {}
+        void setStateInformation (const void*, int) override       {}
+    };
+
+    void connect (AudioProcessorGraph::Node::Ptr source, AudioProcessorGraph::Node::Ptr dest, int numChannels)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            graph->addConnection ({ { source->nodeID, ch }, { dest->nodeID, ch } });
+    }
+
+    std::unique_ptr<AudioProcessorGraph> graph;
+    MidiBuffer midi;
+};
+
+//==============================================================================
+/** Streams 24-bit audio from an in-memory file through an AudioFormatReader. */
+class FormatReaderBenchmark  : public Benchmark
+{
+public:
+    explicit FormatReaderBenchmark (std::unique_ptr<AudioFormat> formatToUse)
+        : format (std::move (formatToUse))
+    {}
+
+    String getName() const override   { return format->getFormatName() + " reader"; }
+
+    void prepare (const BenchmarkConfig& config) override
+    {
+        reader.reset();
+        fileData.reset();
+
+        // Ten seconds of noise, so that reads don't simply come from a small cache
+        auto length = (int) config.sampleRate * 10;
+        AudioBuffer<float> noise (config.numChannels, length);
+        Random random (0x5678);
+
+        for (int ch = 0; ch < config.numChannels; ++ch)
+            for (int i = 0; i < length; ++i)
+                noise.setSample (ch, i, random.nextFloat() * 1.8f - 0.9f);
+
+        {
+            auto* stream = new MemoryOutputStream (fileData, false);
+            std::unique_ptr<AudioFormatWriter> writer (format->createWriterFor (stream, config.sampleRate,
+                                                                                (unsigned int) config.numChannels,
+                                                                                24, {}, 0));
+            if (writer == nullptr)
+            {
+                delete stream;
+                jassertfalse;
+                return;
+            }
+
+            writer->writeFromAudioSampleBuffer (noise, 0, length);
+        }
+
+        reader.reset (format->createReaderFor (new MemoryInputStream (fileData, false), true));
+        jassert (reader != nullptr);
+        position = 0;
+    }
+
+    void process (AudioBuffer<float>& buffer) override
+    {
+        if (reader == nullptr)
+            return;
+
+        auto numSamples = buffer.getNumSamples();
+
+        if (position + numSamples > reader->lengthInSamples)
+            position = 0;
+
+        reader->read (&buffer, 0, numSamples, position, true, true);
+        position += numSamples;
+    }
+
+private:
+    std::unique_ptr<AudioFormat> format;
+    MemoryBlock fileData;
+    std::unique_ptr<AudioFormatReader> reader;
+    int64 position = 0;
+};
+
+//==============================================================================
+inline std::vector<std::unique_ptr<Benchmark>> createAllBenchmarks()
+{
+    using namespace dsp;
+
+    std::vector<std::unique_ptr<Benchmark>> benchmarks;
+
+    benchmarks.push_back (std::make_unique<ConvolutionBenchmark>());
+
+    benchmarks.push_back (std::make_unique<OversamplingBenchmark> (1, Oversampling<float>::filterHalfBandPolyphaseIIR,  "IIR"));
+    benchmarks.push_back (std::make_unique<OversamplingBenchmark> (2, Oversampling<float>::filterHalfBandFIREquiripple, "FIR"));
+
+    using IIRDuplicator = ProcessorDuplicator<IIR::Filter<float>, IIR::Coefficients<float>>;
+
+    benchmarks.push_back (std::make_unique<DSPProcessorBenchmark<IIRDuplicator>> ("IIR lowpass", [] (IIRDuplicator& p, const BenchmarkConfig& c)
+    {
+        *p.state = *IIR::Coefficients<float>::makeLowPass (c.sampleRate, 1000.0f);
+    }));
+
+    using FIRDuplicator = ProcessorDuplicator<FIR::Filter<float>, FIR::Coefficients<float>>;
+
+    for (auto order : { 32, 512 })
+    {
+        benchmarks.push_back (std::make_unique<DSPProcessorBenchmark<FIRDuplicator>> ("FIR lowpass " + String (order + 1) + " taps",
+                                                                                     [order] (FIRDuplicator& p, const BenchmarkConfig& c)
+        {
+            p.state = FilterDesign<float>::designFIRLowpassWindowMethod (1000.0f, c.sampleRate, (size_t) order,
+                                                                         WindowingFunction<float>::hann);
+        }));
+    }
+
+    benchmarks.push_back (std::make_unique<DSPProcessorBenchmark<Compressor<float>>> ("Compressor", [] (Compressor<float>& p, const BenchmarkConfig&)
+    {
+        p.setThreshold (-20.0f);
+        p.setRatio (4.0f);
+        p.setAttack (5.0f);
+        p.setRelease (100.0f);
+    }));
+
+    benchmarks.push_back (std::make_unique<FFTBenchmark>());
+    benchmarks.push_back (std::make_unique<SynthesiserBenchmark>());
+    benchmarks.push_back (std::make_unique<AudioProcessorGraphBenchmark>());
+    benchmarks.push_back (std::make_unique<FormatReaderBenchmark> (std::make_unique<WavAudioFormat>()));
+    benchmarks.push_back (std::make_unique<FormatReaderBenchmark> (std::make_unique<AiffAudioFormat>()));
+
+    return benchmarks;
+}
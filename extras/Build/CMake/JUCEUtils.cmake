@@ -833,7 +833,7 @@ endfunction()
 function(juce_add_binary_data target)
     set(one_value_args NAMESPACE HEADER_NAME)
     set(multi_value_args SOURCES)
-    cmake_parse_arguments(JUCE_ARG "" "${one_value_args}" "${multi_value_args}" ${ARGN})
+    cmake_parse_arguments(JUCE_ARG "USE_INCBIN" "${one_value_args}" "${multi_value_args}" ${ARGN})
 
     list(LENGTH JUCE_ARG_SOURCES num_binary_files)
 
@@ -863,9 +863,16 @@ function(juce_add_binary_data target)
 
     list(APPEND binary_file_names "${juce_binary_data_folder}/${JUCE_ARG_HEADER_NAME}")
 
+    set(juceaide_options)
+
+    # .incbin isn't available when targeting Windows, so those builds always get the array literals
+    if(JUCE_ARG_USE_INCBIN AND NOT WIN32)
+        list(APPEND juceaide_options --incbin)
+    endif()
+
     add_custom_command(OUTPUT ${binary_file_names}
         COMMAND juce::juceaide binarydata "${JUCE_ARG_NAMESPACE}" "${JUCE_ARG_HEADER_NAME}"
-            ${juce_binary_data_folder} ${JUCE_ARG_SOURCES}
+            ${juce_binary_data_folder} ${juceaide_options} ${JUCE_ARG_SOURCES}
         WORKING_DIRECTORY ${CMAKE_CURRENT_LIST_DIR}
         DEPENDS ${JUCE_ARG_SOURCES}
         VERBATIM)
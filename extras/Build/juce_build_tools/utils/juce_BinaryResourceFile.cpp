@@ -29,12 +29,92 @@ namespace build_tools
 {
     static const char* resourceFileIdentifierString = "JUCER_BINARY_RESOURCE";
 
+    //==============================================================================
+    /*  Converting the resources into C++ array literals is the slow part of writing
+        the BinaryData files, so this does it on a pool of threads. The files are
+        queued in order, and only a few more than the number of threads are kept in
+        memory at once, so the output is identical to writing them one by one.
+    */
+    class ResourceFile::DataLiteralWriter
+    {
+    public:
+        DataLiteralWriter (const ResourceFile& r, const String& newLines)
+            : owner (r),
+              newLineString (newLines),
+              pool (jlimit (1, jmax (1, r.files.size()), SystemStats::getNumCpus()))
+        {
+            for (int i = 0; i < owner.files.size(); ++i)
+                jobs.add (nullptr);
+        }
+
+        /*  Waits for the literal for the given file to be ready, and returns it.
+            This will return nullptr if the file couldn't be opened.
+        */
+        const MemoryOutputStream* getLiteralFor (int index)
+        {
+            auto maxQueued = jmin (owner.files.size(), index + 1 + pool.getNumThreads() * 2);
+
+            while (numQueued < maxQueued)
+            {
+                jobs.set (numQueued, new Job (owner, numQueued, newLineString));
+                pool.addJob (jobs[numQueued], false);
+                ++numQueued;
+            }
+
+            auto* job = jobs[index];
+            jassert (job != nullptr);
+
+            pool.waitForJobToFinish (job, -1);
+            return job->openedOk ? &job->out : nullptr;
+        }
+
+        /* Frees the memory used by a file's literal once it's been written out. */
+        void release (int index)
+        {
+            jobs.set (index, nullptr);
+        }
+
+    private:
+        struct Job  : public ThreadPoolJob
+        {
+            Job (const ResourceFile& r, int fileIndex, const String& newLineString)
+                : ThreadPoolJob ("BinaryData literal"), owner (r), index (fileIndex)
+            {
+                out.setNewLineString (newLineString);
+            }
+
+            JobStatus runJob() override
+            {
+                openedOk = owner.writeFileData (out, index);
+                return jobHasFinished;
+            }
+
+            const ResourceFile& owner;
+            const int index;
+            MemoryOutputStream out;
+            bool openedOk = false;
+        };
+
+        const ResourceFile& owner;
+        const String newLineString;
+        OwnedArray<Job> jobs;
+        ThreadPool pool;
+        int numQueued = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (DataLiteralWriter)
+    };
+
     //==============================================================================
     void ResourceFile::setClassName (const String& name)
     {
         className = name;
     }
 
+    void ResourceFile::setEmbedFilesUsingIncbin (bool shouldUseIncbin)
+    {
+        useIncbin = shouldUseIncbin;
+    }
+
     void ResourceFile::addFile (const File& file)
     {
         files.add (file);
@@ -129,39 +209,106 @@ namespace build_tools
         return Result::ok();
     }
 
-    Result ResourceFile::writeCpp (MemoryOutputStream& cpp, const File& headerFile, int& i, const int maxFileSize)
+    static String escapePathForIncbin (const File& file)
+    {
+        // the path ends up inside an assembler string, inside a C++ string literal
+        return file.getFullPathName().replace ("\\", "\\\\\\\\")
+                                     .replace ("\"", "\\\\\\\"");
+    }
+
+    static void writeIncbinMacros (MemoryOutputStream& cpp)
+    {
+        cpp << "#if defined (_WIN32) || ! (defined (__GNUC__) || defined (__clang__))" << newLine
+            << " #error \"These resources are embedded with the assembler's .incbin directive, which needs GCC or Clang on a non-Windows platform\"" << newLine
+            << "#endif" << newLine
+            << newLine
+            << "#if defined (__APPLE__)" << newLine
+            << " #define JUCE_BINARY_DATA_SECTION \"__TEXT,__const\"" << newLine
+            << " #define JUCE_BINARY_DATA_SYMBOL(name) \"_\" #name" << newLine
+            << " #define JUCE_BINARY_DATA_HIDDEN \".private_extern \"" << newLine
+            << "#else" << newLine
+            << " #define JUCE_BINARY_DATA_SECTION \".rodata\"" << newLine
+            << " #define JUCE_BINARY_DATA_SYMBOL(name) #name" << newLine
+            << " #define JUCE_BINARY_DATA_HIDDEN \".hidden \"" << newLine
+            << "#endif" << newLine
+            << newLine
+            << "// Defines a symbol containing the contents of a file, followed by two null bytes. The" << newLine
+            << "// symbol is hidden, so that it isn't exported from a shared library or plugin." << newLine
+            << "#define JUCE_BINARY_DATA_INCBIN(name, path) \\" << newLine
+            << "    extern \"C\" __attribute__ ((visibility (\"hidden\"))) const unsigned char name[]; \\" << newLine
+            << "    __asm__ (\".pushsection \" JUCE_BINARY_DATA_SECTION \"\\n\" \\" << newLine
+            << "             \".global \" JUCE_BINARY_DATA_SYMBOL (name) \"\\n\" \\" << newLine
+            << "             JUCE_BINARY_DATA_HIDDEN JUCE_BINARY_DATA_SYMBOL (name) \"\\n\" \\" << newLine
+            << "             \".balign 16\\n\" \\" << newLine
+            << "             JUCE_BINARY_DATA_SYMBOL (name) \":\\n\" \\" << newLine
+            << "             \".incbin \\\"\" path \"\\\"\\n\" \\" << newLine
+            << "             \".byte 0, 0\\n\" \\" << newLine
+            << "             \".popsection\\n\");" << newLine
+            << newLine;
+    }
+
+    bool ResourceFile::writeFileData (MemoryOutputStream& out, int index) const
+    {
+        auto& file = files.getReference (index);
+        FileInputStream fileStream (file);
+
+        if (! fileStream.openedOk())
+            return false;
+
+        out << newLine << "//================== " << file.getFileName() << " ==================" << newLine;
+
+        if (useIncbin)
+        {
+            // The symbol needs to be unique across the whole program, unlike the temporary
+            // arrays. The hash makes sure that this file changes (and so gets recompiled)
+            // whenever the contents of the resource do.
+            auto symbol = "juce_binary_data_" + makeValidIdentifier (className, false, true, false)
+                            + "_" + variableNames[index];
+
+            out << "// Content hash: 0x" << String::toHexString ((int64) calculateStreamHashCode (fileStream)) << newLine
+                << "JUCE_BINARY_DATA_INCBIN (" << symbol << ", \"" << escapePathForIncbin (file) << "\")" << newLine
+                << newLine
+                << "const char* " << variableNames[index] << " = (const char*) " << symbol << ";" << newLine;
+
+            return true;
+        }
+
+        auto tempVariable = "temp_binary_data_" + String (index);
+
+        out << "static const unsigned char " << tempVariable << "[] =" << newLine;
+
+        {
+            MemoryBlock data;
+            fileStream.readIntoMemoryBlock (data);
+            writeDataAsCppLiteral (data, out, true, true);
+        }
+
+        out << newLine << newLine
+            << "const char* " << variableNames[index] << " = (const char*) " << tempVariable << ";" << newLine;
+
+        return true;
+    }
+
+    Result ResourceFile::writeCpp (MemoryOutputStream& cpp, const File& headerFile, int& i, const int maxFileSize,
+                                   DataLiteralWriter& literalWriter)
     {
         bool isFirstFile = (i == 0);
 
         cpp << "/* ==================================== " << resourceFileIdentifierString << " ====================================";
         writeComment (cpp);
+
+        if (useIncbin)
+            writeIncbinMacros (cpp);
+
         cpp << "namespace " << className << newLine
             << "{" << newLine;
 
         while (i < files.size())
         {
-            auto& file = files.getReference(i);
-            auto variableName = variableNames[i];
-
-            FileInputStream fileStream (file);
-
-            if (fileStream.openedOk())
-            {
-                auto tempVariable = "temp_binary_data_" + String (i);
-
-                cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
-                     << "static const unsigned char " << tempVariable << "[] =" << newLine;
-
-                {
-                    MemoryBlock data;
-                    fileStream.readIntoMemoryBlock (data);
-                    writeDataAsCppLiteral (data, cpp, true, true);
-                }
-
-                cpp << newLine << newLine
-                    << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
-            }
+            if (auto* literal = literalWriter.getLiteralFor (i))
+                cpp.write (literal->getData(), literal->getDataSize());
 
+            literalWriter.release (i);
             ++i;
 
             if (cpp.getPosition() > maxFileSize)
@@ -256,6 +403,8 @@ namespace build_tools
             filesCreated.add (headerFile);
         }
 
+        DataLiteralWriter literalWriter (*this, projectLineFeed);
+
         int i = 0;
         int fileIndex = 0;
 
@@ -266,7 +415,7 @@ namespace build_tools
             MemoryOutputStream mo;
             mo.setNewLineString (projectLineFeed);
 
-            auto r = writeCpp (mo, headerFile, i, maxFileSize);
+            auto r = writeCpp (mo, headerFile, i, maxFileSize, literalWriter);
 
             if (r.failed())
                 return { r, std::move (filesCreated) };
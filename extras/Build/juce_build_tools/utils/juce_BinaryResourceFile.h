@@ -36,6 +36,17 @@ namespace build_tools
 
         String getClassName() const { return className; }
 
+        /** By default, the contents of each file are written into the generated .cpp files
+            as C++ array literals, which can be very slow to compile for large resources.
+
+            If this is enabled, the .cpp files instead use the assembler's .incbin directive
+            to pull in each file directly, referring to it by its absolute path. This is only
+            supported by GCC and Clang, and not when targeting Windows.
+        */
+        void setEmbedFilesUsingIncbin (bool shouldUseIncbin);
+
+        bool isEmbeddingFilesUsingIncbin() const { return useIncbin; }
+
         void addFile (const File& file);
 
         String getDataVariableFor (const File& file) const;
@@ -63,10 +74,15 @@ namespace build_tools
         Array<File> files;
         StringArray variableNames;
         String className { "BinaryData" };
+        bool useIncbin = false;
+
+        class DataLiteralWriter;
 
         Result writeHeader (MemoryOutputStream&);
 
-        Result writeCpp (MemoryOutputStream&, const File&, int&, int);
+        bool writeFileData (MemoryOutputStream&, int) const;
+
+        Result writeCpp (MemoryOutputStream&, const File&, int&, int, DataLiteralWriter&);
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResourceFile)
     };
@@ -65,10 +65,42 @@ namespace build_tools
         return t;
     }
 
+    static bool fileContentMatches (const File& file, const void* data, size_t numBytes)
+    {
+        if (file.getSize() != (int64) numBytes)
+            return false;
+
+        if (numBytes == 0)
+            return true;
+
+        FileInputStream in (file);
+
+        if (! in.openedOk())
+            return false;
+
+        // Compare in blocks so that a changed file can usually be rejected after
+        // reading only a small part of it, rather than hashing both versions in full.
+        const int bufferSize = 65536;
+        HeapBlock<char> buffer (bufferSize);
+        auto* newData = static_cast<const char*> (data);
+
+        for (size_t pos = 0; pos < numBytes;)
+        {
+            auto numToRead = (int) jmin ((size_t) bufferSize, numBytes - pos);
+
+            if (in.read (buffer, numToRead) != numToRead
+                 || memcmp (buffer, newData + pos, (size_t) numToRead) != 0)
+                return false;
+
+            pos += (size_t) numToRead;
+        }
+
+        return true;
+    }
+
     bool overwriteFileWithNewDataIfDifferent (const File& file, const void* data, size_t numBytes)
     {
-        if (file.getSize() == (int64) numBytes
-            && calculateMemoryHashCode (data, numBytes) == calculateFileHashCode (file))
+        if (fileContentMatches (file, data, numBytes))
             return true;
 
         if (file.exists())
@@ -78,6 +78,7 @@ int writeBinaryData (juce::ArgumentList&& args)
 
     resourceFile.setClassName (namespaceName.text);
     const auto lineEndings = args.removeOptionIfFound ("--windows") ? "\r\n" : "\n";
+    resourceFile.setEmbedFilesUsingIncbin (args.removeOptionIfFound ("--incbin"));
 
     for (const auto& arg : args.arguments)
         resourceFile.addFile (arg.resolveAsExistingFile());
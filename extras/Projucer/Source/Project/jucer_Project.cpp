@@ -296,6 +296,7 @@ void Project::initialiseProjectValues()
         includeBinaryDataInJuceHeaderValue.referTo (projectRoot, Ids::includeBinaryInJuceHeader, getUndoManager(), true);
 
     binaryDataNamespaceValue.referTo (projectRoot, Ids::binaryDataNamespace, getUndoManager(), "BinaryData");
+    useIncbinForBinaryDataValue.referTo (projectRoot, Ids::useIncbinForBinaryData, getUndoManager(), false);
 
     compilerFlagSchemesValue.referTo (projectRoot, Ids::compilerFlagSchemes, getUndoManager(), Array<var>(), ",");
 
@@ -1381,6 +1382,11 @@ void Project::createPropertyEditors (PropertyListBuilder& props)
     props.add (new TextPropertyComponent (binaryDataNamespaceValue, "BinaryData Namespace", 256, false),
                                           "The namespace containing the binary assets.");
 
+    props.add (new ChoicePropertyComponent (useIncbinForBinaryDataValue, "Embed BinaryData Using .incbin"),
+               "Instead of writing the binary assets into the BinaryData .cpp files as array literals, use the assembler's "
+               ".incbin directive to include them directly from their original files. This makes large assets much faster to "
+               "compile, but is only supported by GCC and Clang on non-Windows platforms, so can't be used in projects with Windows exporters.");
+
     props.add (new ChoicePropertyComponent (cppStandardValue, "C++ Language Standard",
                                             getCppStandardStrings(),
                                             getCppStandardVars()),
@@ -1576,6 +1582,20 @@ void Project::Item::setID (const String& newID)   { state.setProperty (Ids::ID,
 
 std::unique_ptr<Drawable> Project::Item::loadAsImageFile() const
 {
+    if (ProjucerApplication::getApp().isRunningCommandLine)
+    {
+        // When saving from the command line, the exporters run on a thread pool while the
+        // message thread waits for them, so it can't hand out a MessageManagerLock. There's
+        // no UI to protect in that case, so just stop the exporters loading images at once.
+        static CriticalSection commandLineLoadLock;
+        const ScopedLock sl (commandLineLoadLock);
+
+        if (isValid())
+            return Drawable::createFromImageFile (getFile());
+
+        return {};
+    }
+
     const MessageManagerLock mml (ThreadPoolJob::getCurrentThreadPoolJob());
 
     if (! mml.lockWasGained())
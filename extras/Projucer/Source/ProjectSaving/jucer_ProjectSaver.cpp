@@ -611,6 +611,7 @@ void ProjectSaver::writeBinaryDataFiles()
             dataNamespace = "BinaryData";
 
         resourceFile.setClassName (dataNamespace);
+        resourceFile.setEmbedFilesUsingIncbin (project.shouldUseIncbinForBinaryData());
 
         auto maxSize = project.getMaxBinaryFileSize();
 
@@ -757,10 +758,7 @@ void ProjectSaver::writeProjects (const OwnedArray<LibraryModule>& modules, Proj
                     exporter->getAllGroups().add (generatedFilesGroup);
                 }
 
-                if (ProjucerApplication::getApp().isRunningCommandLine)
-                    saveExporter (*exporter, modules);
-                else
-                    threadPool.addJob ([this, &exporter, &modules] { saveExporter (*exporter, modules); });
+                threadPool.addJob ([this, &exporter, &modules] { saveExporter (*exporter, modules); });
             }
             else
             {
@@ -835,10 +833,20 @@ void ProjectSaver::saveExporter (ProjectExporter& exporter, const OwnedArray<Lib
         {
             auto outputString = "Finished saving: " + exporter.getUniqueName();
 
-            if (MessageManager::getInstance()->isThisTheMessageThread())
+            if (ProjucerApplication::getApp().isRunningCommandLine)
+            {
+                // there's no message loop running to post this to when saving from the command line
+                const ScopedLock sl (outputLock);
+                std::cout <<  outputString << std::endl;
+            }
+            else if (MessageManager::getInstance()->isThisTheMessageThread())
+            {
                 std::cout <<  outputString << std::endl;
+            }
             else
+            {
                 MessageManager::callAsync ([outputString] { std::cout <<  outputString << std::endl; });
+            }
         }
     }
     catch (build_tools::SaveError& error)
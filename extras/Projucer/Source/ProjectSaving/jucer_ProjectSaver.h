@@ -116,7 +116,7 @@ private:
     SortedSet<File> filesCreated;
     String projectLineFeed;
 
-    CriticalSection errorLock;
+    CriticalSection errorLock, outputLock;
     StringArray errors;
 
     bool hasBinaryData = false;
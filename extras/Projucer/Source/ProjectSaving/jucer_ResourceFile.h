@@ -39,6 +39,8 @@ public:
     void setClassName (const String& className)         { resourceFile.setClassName (className); }
     String getClassName() const                         { return resourceFile.getClassName(); }
 
+    void setEmbedFilesUsingIncbin (bool shouldUseIncbin) { resourceFile.setEmbedFilesUsingIncbin (shouldUseIncbin); }
+
     void addFile (const File& file)                     { resourceFile.addFile (file); }
     String getDataVariableFor (const File& file) const  { return resourceFile.getDataVariableFor (file); }
     String getSizeVariableFor (const File& file) const  { return resourceFile.getSizeVariableFor (file); }
@@ -282,6 +282,7 @@ namespace Ids
     DECLARE_ID (maxBinaryFileSize);
     DECLARE_ID (includeBinaryInJuceHeader);
     DECLARE_ID (binaryDataNamespace);
+    DECLARE_ID (useIncbinForBinaryData);
     DECLARE_ID (characterSet);
     DECLARE_ID (JUCERPROJECT);
     DECLARE_ID (MAINGROUP);
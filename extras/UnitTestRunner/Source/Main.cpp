@@ -55,7 +55,8 @@ int main (int argc, char **argv)
 
     if (args.containsOption ("--help|-h"))
     {
-        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category category] [--seed seed]" << std::endl;
+        std::cout << argv[0] << " [--help|-h] [--list-categories] [--category category] [--seed seed]" << std::endl
+                  << "    [--benchmark] [--benchmark-output file] [--benchmark-baseline file] [--benchmark-tolerance percent]" << std::endl;
         return 0;
     }
 
@@ -87,6 +88,27 @@ int main (int argc, char **argv)
         return Random::getSystemRandom().nextInt64();
     }();
 
+    if (args.containsOption ("--benchmark"))
+        runner.setBenchmarkingEnabled (true);
+
+    if (args.containsOption ("--benchmark-baseline"))
+    {
+        auto baselineFile = args.getFileForOption ("--benchmark-baseline");
+        auto baseline = JSON::parse (baselineFile);
+
+        if (baseline.isVoid())
+        {
+            std::cout << "Couldn't read a benchmark baseline from " << baselineFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        auto tolerance = args.containsOption ("--benchmark-tolerance")
+                            ? args.getValueForOption ("--benchmark-tolerance").getDoubleValue() / 100.0
+                            : 0.1;
+
+        runner.setBenchmarkBaseline (baseline, tolerance);
+    }
+
     if (args.containsOption ("--category"))
         runner.runTestsInCategory (args.getValueForOption ("--category"), seed);
     else
@@ -94,6 +116,17 @@ int main (int argc, char **argv)
 
     Logger::setCurrentLogger (nullptr);
 
+    if (args.containsOption ("--benchmark-output"))
+    {
+        auto outputFile = args.getFileForOption ("--benchmark-output");
+
+        if (! outputFile.replaceWithText (JSON::toString (runner.getBenchmarkResultsAsJSON())))
+        {
+            std::cout << "Couldn't write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
     for (int i = 0; i < runner.getNumResults(); ++i)
         if (runner.getResult(i)->failures > 0)
             return 1;
@@ -99,6 +99,7 @@
 #include "midi/juce_MidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
+#include "synthesisers/juce_SynthesiserVoiceBank.h"
 #include "mpe/juce_MPEValue.h"
 #include "mpe/juce_MPENote.h"
 #include "mpe/juce_MPEZoneLayout.h"
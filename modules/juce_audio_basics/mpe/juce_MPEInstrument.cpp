@@ -35,9 +35,126 @@ namespace
     }
 }
 
+//==============================================================================
+MPEInstrument::NoteStorage::NoteStorage() noexcept
+{
+    mpeInstrumentFill (indexByChannelAndNote, (uint8) 0);
+    mpeInstrumentFill (numNotesOnChannel, (uint8) 0);
+}
+
+MPENote MPEInstrument::NoteStorage::operator[] (int index) const noexcept
+{
+    return isPositiveAndBelow (index, numNotes) ? notes[(size_t) index] : MPENote();
+}
+
+int MPEInstrument::NoteStorage::indexOf (int midiChannel, int midiNoteNumber) const noexcept
+{
+    if (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128))
+        return indexByChannelAndNote[((midiChannel - 1) << 7) + midiNoteNumber] - 1;
+
+    return -1;
+}
+
+int MPEInstrument::NoteStorage::getNumNotesOnChannel (int midiChannel) const noexcept
+{
+    return isPositiveAndBelow (midiChannel - 1, 16) ? numNotesOnChannel[midiChannel - 1] : 0;
+}
+
+void MPEInstrument::NoteStorage::add (const MPENote& note) noexcept
+{
+    jassert (note.isValid() && numNotes < maxNumPlayingNotes);
+
+    notes[(size_t) numNotes] = note;
+    setIndex (note, numNotes++);
+    ++numNotesOnChannel[note.midiChannel - 1];
+}
+
+void MPEInstrument::NoteStorage::remove (int index) noexcept
+{
+    jassert (isPositiveAndBelow (index, numNotes));
+
+    --numNotesOnChannel[notes[(size_t) index].midiChannel - 1];
+    setIndex (notes[(size_t) index], -1);
+
+    for (auto i = index + 1; i < numNotes; ++i)
+    {
+        notes[(size_t) i - 1] = notes[(size_t) i];
+        setIndex (notes[(size_t) i - 1], i - 1);
+    }
+
+    --numNotes;
+}
+
+void MPEInstrument::NoteStorage::clear() noexcept
+{
+    for (int i = 0; i < numNotes; ++i)
+        setIndex (notes[(size_t) i], -1);
+
+    mpeInstrumentFill (numNotesOnChannel, (uint8) 0);
+    numNotes = 0;
+}
+
+void MPEInstrument::NoteStorage::setIndex (const MPENote& note, int index) noexcept
+{
+    indexByChannelAndNote[((note.midiChannel - 1) << 7) + note.initialNote] = (uint8) (index + 1);
+}
+
+//==============================================================================
+/*  Marks a region in which the notes are being modified, so that any readers
+    on other threads will retry, and collects the listener callbacks so that
+    they can be made once the notes are in a consistent state again.
+*/
+struct MPEInstrument::ScopedNoteStateUpdate
+{
+    explicit ScopedNoteStateUpdate (MPEInstrument& i) noexcept
+        : instrument (i), firstNotification (i.pendingNotifications.size())
+    {
+        if (instrument.noteStateUpdateDepth++ == 0)
+        {
+            instrument.noteStateVersion.fetch_add (1, std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_release);
+        }
+    }
+
+    ~ScopedNoteStateUpdate()
+    {
+        if (--instrument.noteStateUpdateDepth == 0)
+        {
+            instrument.noteStateVersion.fetch_add (1, std::memory_order_release);
+            instrument.deliverPendingNotifications (firstNotification);
+        }
+    }
+
+    MPEInstrument& instrument;
+    const int firstNotification;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedNoteStateUpdate)
+};
+
+// This mustn't be called while a ScopedNoteStateUpdate is active on the same thread!
+template <typename ReadFunction>
+auto MPEInstrument::readNoteState (ReadFunction&& read) const noexcept
+{
+    for (;;)
+    {
+        auto version = noteStateVersion.load (std::memory_order_acquire);
+
+        if ((version & 1) == 0)
+        {
+            auto result = read();
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (noteStateVersion.load (std::memory_order_relaxed) == version)
+                return result;
+        }
+    }
+}
+
 //==============================================================================
 MPEInstrument::MPEInstrument() noexcept
 {
+    pendingNotifications.ensureStorageAllocated (maxNumPlayingNotes + 4);
+
     mpeInstrumentFill (lastPressureLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (lastTimbreLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (isMemberChannelSustained, false);
@@ -176,6 +293,45 @@ void MPEInstrument::processNextMidiEvent (const MidiMessage& message)
     else if (message.isAftertouch())          processMidiAfterTouchMessage (message);
 }
 
+//==============================================================================
+void MPEInstrument::addPendingNotification (PendingNotification::Type type, const MPENote& note)
+{
+    pendingNotifications.add ({ type, note });
+}
+
+void MPEInstrument::deliverPendingNotifications (int firstIndex)
+{
+    // a listener may trigger further changes from inside its callback, which will
+    // add and deliver their own notifications after the ones in this batch
+    for (auto i = firstIndex; i < pendingNotifications.size(); ++i)
+    {
+        const auto notification = pendingNotifications.getUnchecked (i);
+        const auto& note = notification.note;
+
+        switch (notification.type)
+        {
+            case PendingNotification::added:            listeners.call ([&] (Listener& l) { l.noteAdded (note); });            break;
+            case PendingNotification::pressureChanged:  listeners.call ([&] (Listener& l) { l.notePressureChanged (note); });  break;
+            case PendingNotification::pitchbendChanged: listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); }); break;
+            case PendingNotification::timbreChanged:    listeners.call ([&] (Listener& l) { l.noteTimbreChanged (note); });    break;
+            case PendingNotification::keyStateChanged:  listeners.call ([&] (Listener& l) { l.noteKeyStateChanged (note); });  break;
+            case PendingNotification::released:         listeners.call ([&] (Listener& l) { l.noteReleased (note); });         break;
+            default:                                    jassertfalse; break;
+        }
+    }
+
+    pendingNotifications.removeLast (pendingNotifications.size() - firstIndex);
+}
+
+void MPEInstrument::releaseNote (int index)
+{
+    auto& note = notes.getReference (index);
+    note.keyState = MPENote::off;
+    note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+    addPendingNotification (PendingNotification::released, note);
+    notes.remove (index);
+}
+
 //==============================================================================
 void MPEInstrument::processMidiNoteOnMessage (const MidiMessage& message)
 {
@@ -240,20 +396,14 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
     // in MPE mode, "reset all controllers" is per-zone and expected on the master channel;
     // in legacy mode, it is per MIDI channel (within the channel range used).
 
+    const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
+
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
         for (auto i = notes.size(); --i >= 0;)
-        {
-            auto& note = notes.getReference (i);
-
-            if (note.midiChannel == message.getChannel())
-            {
-                note.keyState = MPENote::off;
-                note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-                listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
-            }
-        }
+            if (notes.getReference (i).midiChannel == message.getChannel())
+                releaseNote (i);
     }
     else if (isMasterChannel (message.getChannel()))
     {
@@ -261,17 +411,8 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
                                                : zoneLayout.getUpperZone());
 
         for (auto i = notes.size(); --i >= 0;)
-        {
-            auto& note = notes.getReference (i);
-
-            if (zone.isUsing (note.midiChannel))
-            {
-                note.keyState = MPENote::off;
-                note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-                listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
-            }
-        }
+            if (zone.isUsing (notes.getReference (i).midiChannel))
+                releaseNote (i);
     }
 }
 
@@ -319,6 +460,12 @@ void MPEInstrument::noteOn (int midiChannel,
     if (! isUsingChannel (midiChannel))
         return;
 
+    if (! isPositiveAndBelow (midiNoteNumber, 128))
+    {
+        jassertfalse; // MIDI note numbers must be in the range 0 to 127!
+        return;
+    }
+
     MPENote newNote (midiChannel,
                      midiNoteNumber,
                      midiNoteOnVelocity,
@@ -328,19 +475,24 @@ void MPEInstrument::noteOn (int midiChannel,
                      isMemberChannelSustained[midiChannel - 1] ? MPENote::keyDownAndSustained : MPENote::keyDown);
 
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
     updateNoteTotalPitchbend (newNote);
 
-    if (auto* alreadyPlayingNote = getNotePtr (midiChannel, midiNoteNumber))
+    auto alreadyPlayingIndex = notes.indexOf (midiChannel, midiNoteNumber);
+
+    if (alreadyPlayingIndex >= 0)
     {
         // pathological case: second note-on received for same note -> retrigger it
-        alreadyPlayingNote->keyState = MPENote::off;
-        alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-        listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
-        notes.remove (alreadyPlayingNote);
+        releaseNote (alreadyPlayingIndex);
+    }
+    else if (notes.size() == maxNumPlayingNotes)
+    {
+        // there's no room left for another note, so the oldest one has to make way
+        releaseNote (0);
     }
 
     notes.add (newNote);
-    listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
+    addPendingNotification (PendingNotification::added, newNote);
 }
 
 //==============================================================================
@@ -352,11 +504,15 @@ void MPEInstrument::noteOff (int midiChannel,
         return;
 
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
+
+    auto index = notes.indexOf (midiChannel, midiNoteNumber);
 
-    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
+    if (index >= 0)
     {
-        note->keyState = (note->keyState == MPENote::keyDownAndSustained) ? MPENote::sustained : MPENote::off;
-        note->noteOffVelocity = midiNoteOffVelocity;
+        auto& note = notes.getReference (index);
+        note.keyState = (note.keyState == MPENote::keyDownAndSustained) ? MPENote::sustained : MPENote::off;
+        note.noteOffVelocity = midiNoteOffVelocity;
 
         // If no more notes are playing on this channel in mpe mode, reset the dimension values
         if (! legacyMode.isEnabled && getLastNotePlayedPtr (midiChannel) == nullptr)
@@ -366,14 +522,14 @@ void MPEInstrument::noteOff (int midiChannel,
             timbreDimension.lastValueReceivedOnChannel[midiChannel - 1] = MPEValue::centreValue();
         }
 
-        if (note->keyState == MPENote::off)
+        if (note.keyState == MPENote::off)
         {
-            listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
-            notes.remove (note);
+            addPendingNotification (PendingNotification::released, note);
+            notes.remove (index);
         }
         else
         {
-            listeners.call ([=] (Listener& l) { l.noteKeyStateChanged (*note); });
+            addPendingNotification (PendingNotification::keyStateChanged, note);
         }
     }
 }
@@ -382,24 +538,28 @@ void MPEInstrument::noteOff (int midiChannel,
 void MPEInstrument::pitchbend (int midiChannel, MPEValue value)
 {
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
     updateDimension (midiChannel, pitchbendDimension, value);
 }
 
 void MPEInstrument::pressure (int midiChannel, MPEValue value)
 {
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
     updateDimension (midiChannel, pressureDimension, value);
 }
 
 void MPEInstrument::timbre (int midiChannel, MPEValue value)
 {
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
     updateDimension (midiChannel, timbreDimension, value);
 }
 
 void MPEInstrument::polyAftertouch (int midiChannel, int midiNoteNumber, MPEValue value)
 {
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
 
     for (auto i = notes.size(); --i >= 0;)
     {
@@ -476,7 +636,7 @@ void MPEInstrument::updateDimensionMaster (bool isLowerZone, MPEDimension& dimen
             // master pitchbend is a special case: we don't change the note's own pitchbend,
             // instead we have to update its total (master + note) pitchbend.
             updateNoteTotalPitchbend (note);
-            listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); });
+            addPendingNotification (PendingNotification::pitchbendChanged, note);
         }
         else if (dimension.getValue (note) != value)
         {
@@ -503,9 +663,9 @@ void MPEInstrument::updateDimensionForNote (MPENote& note, MPEDimension& dimensi
 //==============================================================================
 void MPEInstrument::callListenersDimensionChanged (const MPENote& note, const MPEDimension& dimension)
 {
-    if (&dimension == &pressureDimension)  { listeners.call ([&] (Listener& l) { l.notePressureChanged  (note); }); return; }
-    if (&dimension == &timbreDimension)    { listeners.call ([&] (Listener& l) { l.noteTimbreChanged    (note); }); return; }
-    if (&dimension == &pitchbendDimension) { listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); }); return; }
+    if (&dimension == &pressureDimension)  { addPendingNotification (PendingNotification::pressureChanged,  note); return; }
+    if (&dimension == &timbreDimension)    { addPendingNotification (PendingNotification::timbreChanged,    note); return; }
+    if (&dimension == &pitchbendDimension) { addPendingNotification (PendingNotification::pitchbendChanged, note); return; }
 }
 
 //==============================================================================
@@ -552,12 +712,14 @@ void MPEInstrument::updateNoteTotalPitchbend (MPENote& note)
 void MPEInstrument::sustainPedal (int midiChannel, bool isDown)
 {
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
     handleSustainOrSostenuto (midiChannel, isDown, false);
 }
 
 void MPEInstrument::sostenutoPedal (int midiChannel, bool isDown)
 {
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
     handleSustainOrSostenuto (midiChannel, isDown, true);
 }
 
@@ -588,12 +750,12 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
 
             if (note.keyState == MPENote::off)
             {
-                listeners.call ([&] (Listener& l) { l.noteReleased (note); });
+                addPendingNotification (PendingNotification::released, note);
                 notes.remove (i);
             }
             else
             {
-                listeners.call ([&] (Listener& l) { l.noteKeyStateChanged (note); });
+                addPendingNotification (PendingNotification::keyStateChanged, note);
             }
         }
     }
@@ -648,56 +810,56 @@ bool MPEInstrument::isUsingChannel (int midiChannel) const noexcept
 //==============================================================================
 int MPEInstrument::getNumPlayingNotes() const noexcept
 {
-    return notes.size();
+    return readNoteState ([this] { return notes.size(); });
 }
 
 MPENote MPEInstrument::getNote (int midiChannel, int midiNoteNumber) const noexcept
 {
-    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
-        return *note;
-
-    return {};
+    return readNoteState ([&]
+    {
+        auto* note = getNotePtr (midiChannel, midiNoteNumber);
+        return note != nullptr ? *note : MPENote();
+    });
 }
 
 MPENote MPEInstrument::getNote (int index) const noexcept
 {
-    return notes[index];
+    return readNoteState ([&] { return notes[index]; });
 }
 
 //==============================================================================
 MPENote MPEInstrument::getMostRecentNote (int midiChannel) const noexcept
 {
-    if (auto* note = getLastNotePlayedPtr (midiChannel))
-        return *note;
-
-    return {};
+    return readNoteState ([&]
+    {
+        auto* note = getLastNotePlayedPtr (midiChannel);
+        return note != nullptr ? *note : MPENote();
+    });
 }
 
 MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) const noexcept
 {
-    for (auto i = notes.size(); --i >= 0;)
+    jassert (otherThanThisNote.isValid());
+
+    return readNoteState ([&]
     {
-        auto& note = notes.getReference (i);
+        for (auto i = notes.size(); --i >= 0;)
+        {
+            auto& note = notes.getReference (i);
 
-        if (note != otherThanThisNote)
-            return note;
-    }
+            if (note.noteID != otherThanThisNote.noteID)
+                return note;
+        }
 
-    return {};
+        return MPENote();
+    });
 }
 
 //==============================================================================
 const MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
-    {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
-    }
-
-    return nullptr;
+    auto index = notes.indexOf (midiChannel, midiNoteNumber);
+    return index >= 0 ? &notes.getReference (index) : nullptr;
 }
 
 MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) noexcept
@@ -727,6 +889,9 @@ MPENote* MPEInstrument::getNotePtr (int midiChannel, TrackingMode mode) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexcept
 {
+    if (notes.getNumNotesOnChannel (midiChannel) == 0)
+        return nullptr;
+
     for (auto i = notes.size(); --i >= 0;)
     {
         auto& note = notes.getReference (i);
@@ -747,6 +912,9 @@ MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
 {
+    if (notes.getNumNotesOnChannel (midiChannel) == 0)
+        return nullptr;
+
     int initialNoteMax = -1;
     const MPENote* result = nullptr;
 
@@ -773,6 +941,9 @@ MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) noexcept
 
 const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
 {
+    if (notes.getNumNotesOnChannel (midiChannel) == 0)
+        return nullptr;
+
     int initialNoteMin = 128;
     const MPENote* result = nullptr;
 
@@ -801,16 +972,10 @@ MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) noexcept
 void MPEInstrument::releaseAllNotes()
 {
     const ScopedLock sl (lock);
+    const ScopedNoteStateUpdate update (*this);
 
     for (auto i = notes.size(); --i >= 0;)
-    {
-        auto& note = notes.getReference (i);
-        note.keyState = MPENote::off;
-        note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-        listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-    }
-
-    notes.clear();
+        releaseNote (i);
 }
 
 
@@ -2144,6 +2309,104 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("note lookup after removing notes");
+        {
+            UnitTestInstrument test;
+            test.enableLegacyMode();
+
+            for (int channel = 1; channel <= 16; ++channel)
+                for (int note = 60; note < 66; ++note)
+                    test.noteOn (channel, note, MPEValue::from7BitInt (100));
+
+            expectEquals (test.getNumPlayingNotes(), 96);
+
+            for (int channel = 1; channel <= 16; channel += 3)
+                for (int note = 60; note < 66; note += 2)
+                    test.noteOff (channel, note, MPEValue::from7BitInt (64));
+
+            expectEquals (test.getNumPlayingNotes(), 78);
+
+            for (int channel = 1; channel <= 16; ++channel)
+            {
+                for (int note = 60; note < 66; ++note)
+                {
+                    auto shouldBePlaying = ((channel - 1) % 3 != 0) || (note % 2 != 0);
+                    auto found = test.getNote (channel, note);
+
+                    expect (found.isValid() == shouldBePlaying);
+
+                    if (shouldBePlaying)
+                    {
+                        expectEquals ((int) found.midiChannel, channel);
+                        expectEquals ((int) found.initialNote, note);
+                    }
+                }
+
+                expectEquals ((int) test.getMostRecentNote (channel).initialNote, 65);
+            }
+
+            // the order of the remaining notes must be unchanged
+            for (int i = 1; i < test.getNumPlayingNotes(); ++i)
+            {
+                auto previous = test.getNote (i - 1), next = test.getNote (i);
+                expect (previous.midiChannel < next.midiChannel
+                         || (previous.midiChannel == next.midiChannel && previous.initialNote < next.initialNote));
+            }
+        }
+
+        beginTest ("exceeding the maximum number of playing notes");
+        {
+            UnitTestInstrument test;
+            test.enableLegacyMode();
+
+            for (int i = 0; i <= MPEInstrument::maxNumPlayingNotes; ++i)
+                test.noteOn (1 + i / 128, i % 128, MPEValue::from7BitInt (100));
+
+            expectEquals (test.getNumPlayingNotes(), MPEInstrument::maxNumPlayingNotes);
+            expectEquals (test.noteAddedCallCounter, MPEInstrument::maxNumPlayingNotes + 1);
+            expectEquals (test.noteReleasedCallCounter, 1);
+            expectHasFinishedNote (test, 1, 0, 64);
+            expect (! test.getNote (1, 0).isValid());
+            expect (test.getNote (1, 1).isValid());
+            expect (test.getNote (2, 0).isValid());
+        }
+
+        beginTest ("listener callbacks see the updated state");
+        {
+            struct StateCheckingListener  : public MPEInstrument::Listener
+            {
+                explicit StateCheckingListener (MPEInstrument& i) : instrument (i) {}
+
+                void notePitchbendChanged (MPENote changedNote) override
+                {
+                    pitchbends.add (instrument.getNote (changedNote.midiChannel, changedNote.initialNote).pitchbend.as14BitInt());
+                }
+
+                void noteReleased (MPENote) override
+                {
+                    numPlayingWhenReleased.add (instrument.getNumPlayingNotes());
+                }
+
+                MPEInstrument& instrument;
+                Array<int> pitchbends, numPlayingWhenReleased;
+            };
+
+            MPEInstrument test;
+            test.setZoneLayout (testLayout);
+            StateCheckingListener listener (test);
+            test.addListener (&listener);
+
+            test.noteOn (2, 60, MPEValue::from7BitInt (100));
+            test.noteOn (3, 61, MPEValue::from7BitInt (100));
+            test.pitchbend (2, MPEValue::from14BitInt (1234));
+            expect (listener.pitchbends == Array<int> { 1234 });
+
+            test.releaseAllNotes();
+            expect (listener.numPlayingWhenReleased == Array<int> { 0, 0 });
+
+            test.removeListener (&listener);
+        }
     }
 
 private:
@@ -48,6 +48,12 @@ namespace juce
     you should instead use the classes MPESynthesiserBase, which adds
     the ability to render audio and to manage voices.
 
+    The playing notes are kept in fixed-size storage inside the instrument, so
+    processing MIDI never allocates memory, and the note-query methods such as
+    getNote() and getNumPlayingNotes() can be called from any thread (e.g. from
+    an audio or UI thread while the MIDI is being processed elsewhere) without
+    taking a lock.
+
     @see MPENote, MPEZoneLayout, MPESynthesiser
 
     @tags{Audio}
@@ -213,6 +219,13 @@ public:
     void releaseAllNotes();
 
     //==============================================================================
+    /** The maximum number of notes that the instrument can keep track of at once.
+
+        If a note-on arrives while this many notes are already playing, the oldest
+        note will be released to make room for it.
+    */
+    static constexpr int maxNumPlayingNotes = 128;
+
     /** Returns the number of MPE notes currently played by the instrument. */
     int getNumPlayingNotes() const noexcept;
 
@@ -247,10 +260,15 @@ public:
     /** Derive from this class to be informed about any changes in the expressive
         MIDI notes played by this instrument.
 
-        Note: This listener type receives its callbacks immediately, and not
+        Note: This listener type receives its callbacks synchronously, and not
         via the message thread (so you might be for example in the MIDI thread).
         Therefore you should never do heavy work such as graphics rendering etc.
         inside those callbacks.
+
+        The callbacks caused by a single incoming message (e.g. a master channel
+        pitchbend that affects several notes) are delivered together, after the
+        instrument has finished updating all of its notes, so the instrument's
+        state will already be up to date when they are called.
     */
     class JUCE_API  Listener
     {
@@ -350,7 +368,46 @@ protected:
 
 private:
     //==============================================================================
-    Array<MPENote> notes;
+    struct NoteStorage
+    {
+        NoteStorage() noexcept;
+
+        int size() const noexcept                               { return numNotes; }
+        bool isEmpty() const noexcept                           { return numNotes == 0; }
+        MPENote& getReference (int index) noexcept              { jassert (isPositiveAndBelow (index, numNotes)); return notes[(size_t) index]; }
+        const MPENote& getReference (int index) const noexcept  { jassert (isPositiveAndBelow (index, numNotes)); return notes[(size_t) index]; }
+        MPENote operator[] (int index) const noexcept;
+
+        int indexOf (int midiChannel, int midiNoteNumber) const noexcept;
+        int getNumNotesOnChannel (int midiChannel) const noexcept;
+
+        void add (const MPENote&) noexcept;
+        void remove (int index) noexcept;
+        void clear() noexcept;
+
+    private:
+        void setIndex (const MPENote&, int index) noexcept;
+
+        std::array<MPENote, (size_t) maxNumPlayingNotes> notes;
+        uint8 indexByChannelAndNote[16 * 128]; // (index + 1), or 0 for no note
+        uint8 numNotesOnChannel[16];
+        int numNotes = 0;
+    };
+
+    struct PendingNotification
+    {
+        enum Type { added, pressureChanged, pitchbendChanged, timbreChanged, keyStateChanged, released };
+
+        Type type;
+        MPENote note;
+    };
+
+    struct ScopedNoteStateUpdate;
+
+    NoteStorage notes;
+    std::atomic<uint32> noteStateVersion { 0 };
+    int noteStateUpdateDepth = 0;
+    Array<PendingNotification, DummyCriticalSection, maxNumPlayingNotes + 4> pendingNotifications;
     MPEZoneLayout zoneLayout;
     ListenerList<Listener> listeners;
 
@@ -377,6 +434,12 @@ private:
     MPEDimension pitchbendDimension, pressureDimension, timbreDimension;
 
     void resetLastReceivedValues();
+    void addPendingNotification (PendingNotification::Type, const MPENote&);
+    void deliverPendingNotifications (int firstIndex);
+    void releaseNote (int index);
+
+    template <typename ReadFunction>
+    auto readNoteState (ReadFunction&&) const noexcept;
 
     void updateDimension (int midiChannel, MPEDimension&, MPEValue);
     void updateDimensionMaster (bool, MPEDimension&, MPEValue);
@@ -260,6 +260,10 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (voicesLock);
     newVoice->setCurrentSampleRate (getSampleRate());
+
+    if (auto* bank = newVoice->getVoiceBank())
+        voiceBanks.addIfNotAlreadyThere (bank);
+
     voices.add (newVoice);
 }
 
@@ -267,6 +271,7 @@ void MPESynthesiser::clearVoices()
 {
     const ScopedLock sl (voicesLock);
     voices.clear();
+    voiceBanks.clear();
 }
 
 MPESynthesiserVoice* MPESynthesiser::getVoice (const int index) const
@@ -279,6 +284,7 @@ void MPESynthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (voicesLock);
     voices.remove (index);
+    updateVoiceBanks();
 }
 
 void MPESynthesiser::reduceNumVoices (const int newNumVoices)
@@ -295,6 +301,17 @@ void MPESynthesiser::reduceNumVoices (const int newNumVoices)
         else
             voices.remove (0); // if there's no voice to steal, kill the oldest voice
     }
+
+    updateVoiceBanks();
+}
+
+void MPESynthesiser::updateVoiceBanks()
+{
+    voiceBanks.clearQuick();
+
+    for (auto* voice : voices)
+        if (auto* bank = voice->getVoiceBank())
+            voiceBanks.addIfNotAlreadyThere (bank);
 }
 
 void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
@@ -313,26 +330,29 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 }
 
 //==============================================================================
-void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
+template <typename floatType>
+void MPESynthesiser::renderVoicesAndBanks (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
 {
     const ScopedLock sl (voicesLock);
 
     for (auto* voice : voices)
     {
-        if (voice->isActive())
+        if (voice->isActive() && (voiceBanks.isEmpty() || voice->getVoiceBank() == nullptr))
             voice->renderNextBlock (buffer, startSample, numSamples);
     }
+
+    for (auto* bank : voiceBanks)
+        bank->renderNextBlock (buffer, startSample, numSamples);
 }
 
-void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
+void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    const ScopedLock sl (voicesLock);
+    renderVoicesAndBanks (buffer, startSample, numSamples);
+}
 
-    for (auto* voice : voices)
-    {
-        if (voice->isActive())
-            voice->renderNextBlock (buffer, startSample, numSamples);
-    }
+void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
+{
+    renderVoicesAndBanks (buffer, startSample, numSamples);
 }
 
 } // namespace juce
@@ -239,7 +239,8 @@ protected:
 
     //==============================================================================
     /** This will simply call renderNextBlock for each currently active
-        voice and fill the buffer with the sum.
+        voice and fill the buffer with the sum. Voices that belong to a
+        SynthesiserVoiceBank are rendered by calling the bank once instead.
         Override this method if you need to do more work to render your audio.
     */
     void renderNextSubBlock (AudioBuffer<float>& outputAudio,
@@ -303,6 +304,12 @@ protected:
 
 private:
     //==============================================================================
+    template <typename floatType>
+    void renderVoicesAndBanks (AudioBuffer<floatType>&, int startSample, int numSamples);
+
+    void updateVoiceBanks();
+
+    Array<SynthesiserVoiceBank*> voiceBanks;
     bool shouldStealVoices = false;
     uint32 lastNoteOnCounter = 0;
 
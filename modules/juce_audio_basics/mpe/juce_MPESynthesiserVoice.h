@@ -141,6 +141,18 @@ public:
                                   int /*startSample*/,
                                   int /*numSamples*/) {}
 
+    /** Returns the bank which renders this voice's audio, if it belongs to one.
+
+        If this returns a bank, the MPESynthesiser won't call this voice's renderNextBlock()
+        method, but will call the bank's renderNextBlock() method once for all the voices
+        that share it. The default implementation returns nullptr.
+
+        The value returned mustn't change once the voice has been added to a synthesiser.
+
+        @see SynthesiserVoiceBank
+    */
+    virtual SynthesiserVoiceBank* getVoiceBank() const          { return nullptr; }
+
     /** Changes the voice's reference sample rate.
 
         The rate is set so that subclasses know the output rate and can set their pitch
@@ -72,6 +72,19 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+//==============================================================================
+void SynthesiserVoiceBank::renderNextBlock (AudioBuffer<double>& outputBuffer,
+                                            int startSample, int numSamples)
+{
+    AudioBuffer<double> subBuffer (outputBuffer.getArrayOfWritePointers(),
+                                   outputBuffer.getNumChannels(),
+                                   startSample, numSamples);
+
+    tempBuffer.makeCopyOf (subBuffer, true);
+    renderNextBlock (tempBuffer, 0, numSamples);
+    subBuffer.makeCopyOf (tempBuffer, true);
+}
+
 //==============================================================================
 Synthesiser::Synthesiser()
 {
@@ -94,12 +107,17 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    voiceBanks.clear();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
     newVoice->setCurrentPlaybackSampleRate (sampleRate);
+
+    if (auto* bank = newVoice->getVoiceBank())
+        voiceBanks.addIfNotAlreadyThere (bank);
+
     return voices.add (newVoice);
 }
 
@@ -107,6 +125,16 @@ void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    updateVoiceBanks();
+}
+
+void Synthesiser::updateVoiceBanks()
+{
+    voiceBanks.clearQuick();
+
+    for (auto* voice : voices)
+        if (auto* bank = voice->getVoiceBank())
+            voiceBanks.addIfNotAlreadyThere (bank);
 }
 
 void Synthesiser::clearSounds()
@@ -228,16 +256,33 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
     processNextBlock (outputAudio, inputMidi, startSample, numSamples);
 }
 
-void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
+template <typename floatType>
+void Synthesiser::renderVoicesAndBanks (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
 {
+    if (voiceBanks.isEmpty())
+    {
+        for (auto* voice : voices)
+            voice->renderNextBlock (buffer, startSample, numSamples);
+
+        return;
+    }
+
     for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+        if (voice->getVoiceBank() == nullptr)
+            voice->renderNextBlock (buffer, startSample, numSamples);
+
+    for (auto* bank : voiceBanks)
+        bank->renderNextBlock (buffer, startSample, numSamples);
+}
+
+void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    renderVoicesAndBanks (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    renderVoicesAndBanks (buffer, startSample, numSamples);
 }
 
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
@@ -582,4 +627,210 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     return low;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SynthesiserVoiceBankTests  : public UnitTest
+{
+    SynthesiserVoiceBankTests()
+        : UnitTest ("SynthesiserVoiceBank", UnitTestCategories::audio)
+    {}
+
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override      { return true; }
+        bool appliesToChannel (int) override   { return true; }
+    };
+
+    static float getSineSample (double phase, double level)
+    {
+        return (float) (std::sin (phase) * level);
+    }
+
+    struct SineVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0;
+            delta = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+            level = velocity;
+        }
+
+        void stopNote (float, bool) override    { clearCurrentNote(); }
+        void pitchWheelMoved (int) override     {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                auto sample = getSineSample (phase, level);
+                phase += delta;
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.addSample (ch, i, sample);
+            }
+        }
+
+        using SynthesiserVoice::renderNextBlock;
+
+        double phase = 0, delta = 0, level = 0;
+    };
+
+    struct SineBank  : public SynthesiserVoiceBank
+    {
+        enum { numLanes = 8 };
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            ++numRenderCalls;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                float mix = 0;
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    if (active[lane])
+                    {
+                        mix += getSineSample (phase[lane], level[lane]);
+                        phase[lane] += delta[lane];
+                    }
+                }
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.addSample (ch, i, mix);
+            }
+        }
+
+        using SynthesiserVoiceBank::renderNextBlock;
+
+        double phase[numLanes] = {}, delta[numLanes] = {}, level[numLanes] = {};
+        bool active[numLanes] = {};
+        int numRenderCalls = 0;
+    };
+
+    struct BankVoice  : public SynthesiserVoice
+    {
+        BankVoice (SineBank& b, int laneIndex)  : bank (b), lane (laneIndex) {}
+
+        bool canPlaySound (SynthesiserSound*) override      { return true; }
+        SynthesiserVoiceBank* getVoiceBank() const override  { return &bank; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            bank.phase[lane] = 0;
+            bank.delta[lane] = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+            bank.level[lane] = velocity;
+            bank.active[lane] = true;
+        }
+
+        void stopNote (float, bool) override
+        {
+            bank.active[lane] = false;
+            clearCurrentNote();
+        }
+
+        void pitchWheelMoved (int) override      {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>&, int, int) override
+        {
+            // the synthesiser should never call this for a voice that belongs to a bank
+            jassertfalse;
+            ++numDirectRenderCalls;
+        }
+
+        using SynthesiserVoice::renderNextBlock;
+
+        SineBank& bank;
+        const int lane;
+        int numDirectRenderCalls = 0;
+    };
+
+    static MidiBuffer createTestMidi()
+    {
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn  (1, 60, 0.5f), 0);
+        midi.addEvent (MidiMessage::noteOn  (1, 64, 0.25f), 37);
+        midi.addEvent (MidiMessage::noteOn  (1, 67, 0.75f), 100);
+        midi.addEvent (MidiMessage::noteOff (1, 64), 300);
+        midi.addEvent (MidiMessage::noteOn  (1, 72, 1.0f), 301);
+        return midi;
+    }
+
+    static void render (Synthesiser& synth, AudioBuffer<float>& buffer)
+    {
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        buffer.clear();
+
+        auto midi = createTestMidi();
+        synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+    }
+
+    void runTest() override
+    {
+        beginTest ("Banked voices render the same output as individual voices");
+        {
+            Synthesiser reference;
+            reference.addSound (new TestSound());
+
+            for (int i = 0; i < SineBank::numLanes; ++i)
+                reference.addVoice (new SineVoice());
+
+            SineBank bank;
+            Synthesiser banked;
+            banked.addSound (new TestSound());
+
+            for (int i = 0; i < SineBank::numLanes; ++i)
+                banked.addVoice (new BankVoice (bank, i));
+
+            AudioBuffer<float> expected (2, 512), actual (2, 512);
+            render (reference, expected);
+            render (banked, actual);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < expected.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (actual.getSample (ch, i), expected.getSample (ch, i), 1.0e-5f);
+
+            expect (actual.getMagnitude (0, 512) > 0.5f);
+
+            // one call for each sub-block between MIDI events rather than one per voice (the
+            // events at 300 and 301 fall into the same sub-block)
+            expectEquals (bank.numRenderCalls, 4);
+
+            for (int i = 0; i < banked.getNumVoices(); ++i)
+                expectEquals (static_cast<BankVoice*> (banked.getVoice (i))->numDirectRenderCalls, 0);
+        }
+
+        beginTest ("Banks and individual voices can be mixed");
+        {
+            SineBank bank;
+            Synthesiser synth;
+            synth.addSound (new TestSound());
+            synth.addVoice (new SineVoice());
+            synth.addVoice (new BankVoice (bank, 0));
+
+            AudioBuffer<float> buffer (1, 256);
+            render (synth, buffer);
+            expect (bank.numRenderCalls > 0);
+
+            synth.removeVoice (1);
+            bank.numRenderCalls = 0;
+            render (synth, buffer);
+            expectEquals (bank.numRenderCalls, 0);
+        }
+    }
+};
+
+static SynthesiserVoiceBankTests synthesiserVoiceBankTests;
+
+#endif
+
 } // namespace juce
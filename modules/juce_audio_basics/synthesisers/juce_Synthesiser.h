@@ -192,6 +192,18 @@ public:
                                   int startSample,
                                   int numSamples);
 
+    /** Returns the bank which renders this voice's audio, if it belongs to one.
+
+        If this returns a bank, the Synthesiser won't call this voice's renderNextBlock()
+        method, but will call the bank's renderNextBlock() method once for all the voices
+        that share it. The default implementation returns nullptr.
+
+        The value returned mustn't change once the voice has been added to a synthesiser.
+
+        @see SynthesiserVoiceBank
+    */
+    virtual SynthesiserVoiceBank* getVoiceBank() const          { return nullptr; }
+
     /** Changes the voice's reference sample rate.
 
         The rate is set so that subclasses know the output rate and can set their pitch
@@ -563,13 +575,15 @@ protected:
     CriticalSection lock;
 
     OwnedArray<SynthesiserVoice> voices;
+    Array<SynthesiserVoiceBank*> voiceBanks;
     ReferenceCountedArray<SynthesiserSound> sounds;
 
     /** The last pitch-wheel values for each midi channel. */
     int lastPitchWheelValues [16];
 
     /** Renders the voices for the given range.
-        By default this just calls renderNextBlock() on each voice, but you may need
+        By default this calls renderNextBlock() on each voice that doesn't belong to a
+        SynthesiserVoiceBank, and then on each of the voice banks, but you may need
         to override it to handle custom cases.
     */
     virtual void renderVoices (AudioBuffer<float>& outputAudio,
@@ -631,6 +645,11 @@ private:
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
+    template <typename floatType>
+    void renderVoicesAndBanks (AudioBuffer<floatType>&, int startSample, int numSamples);
+
+    void updateVoiceBanks();
+
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // Note the new parameters for these methods.
     virtual int findFreeVoice (const bool) const { return 0; }
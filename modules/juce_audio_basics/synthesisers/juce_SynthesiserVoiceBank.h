@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders the audio for a group of synthesiser voices in one go.
+
+    Normally a Synthesiser or MPESynthesiser asks each of its voices to render
+    itself in turn, and each voice adds its output into the buffer separately.
+    But if a voice's getVoiceBank() method returns a SynthesiserVoiceBank, the
+    synthesiser will skip that voice's own renderNextBlock() method, and will
+    instead call the bank's renderNextBlock() once per sub-block for all the
+    voices that share it.
+
+    This lets you hold the state of all the voices of one type in a structure-of-arrays
+    layout - e.g. with the oscillator phases, envelope levels and filter states
+    of every voice in contiguous arrays - so that a whole set of voices can be
+    advanced together using SIMD operations, and their mixed output can be added
+    to the destination buffer in a single pass rather than once per voice.
+
+    The voice objects are still used to allocate, start and stop notes. Typically
+    each one just holds an index into the bank's arrays, and its startNote() and
+    stopNote() methods update the bank's state for that index. When a voice has
+    finished playing, it must still call clearCurrentNote() so that the synthesiser
+    can reuse it.
+
+    The bank must not be deleted while any voices that refer to it still exist.
+
+    @see SynthesiserVoice::getVoiceBank, MPESynthesiserVoice::getVoiceBank
+
+    @tags{Audio}
+*/
+class JUCE_API  SynthesiserVoiceBank
+{
+public:
+    /** Destructor. */
+    virtual ~SynthesiserVoiceBank() = default;
+
+    /** Renders the next block of data for all of the bank's active voices.
+
+        The output must be added to the current contents of the buffer, and only
+        the region between startSample and (startSample + numSamples) should be
+        altered. This is called for every sub-block that the synthesiser renders,
+        so if none of the bank's voices are playing, it should return quickly
+        without doing anything.
+    */
+    virtual void renderNextBlock (AudioBuffer<float>& outputBuffer,
+                                  int startSample,
+                                  int numSamples) = 0;
+
+    /** A double-precision version of renderNextBlock().
+        By default, this renders into a temporary float buffer and copies the result.
+    */
+    virtual void renderNextBlock (AudioBuffer<double>& outputBuffer,
+                                  int startSample,
+                                  int numSamples);
+
+private:
+    AudioBuffer<float> tempBuffer;
+};
+
+} // namespace juce
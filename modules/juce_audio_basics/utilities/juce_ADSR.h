@@ -31,6 +31,12 @@ namespace juce
     with setParameters() then call getNextSample() to get the envelope value to be applied
     to each audio sample or applyEnvelopeToBuffer() to apply the envelope to a whole buffer.
 
+    If you need the envelope values for a whole block at once, getNextBlock() is much
+    faster than calling getNextSample() in a loop, as it renders each stage of the envelope
+    as a single ramp.
+
+    @see ADSRBank
+
     @tags{Audio}
 */
 class ADSR
@@ -79,7 +85,7 @@ public:
         calculateRates (newParameters);
 
         if (currentState != State::idle)
-            checkCurrentState();
+            checkState (currentState, envelopeVal, releaseRate);
     }
 
     /** Returns the parameters currently being used by an ADSR object.
@@ -113,42 +119,19 @@ public:
     /** Starts the attack phase of the envelope. */
     void noteOn()
     {
-        if (attackRate > 0.0f)
-        {
-            currentState = State::attack;
-        }
-        else if (decayRate > 0.0f)
-        {
-            envelopeVal = 1.0f;
-            currentState = State::decay;
-        }
-        else
-        {
-            currentState = State::sustain;
-        }
+        startAttack (currentState, envelopeVal);
     }
 
     /** Starts the release phase of the envelope. */
     void noteOff()
     {
-        if (currentState != State::idle)
-        {
-            if (currentParameters.release > 0.0f)
-            {
-                releaseRate = static_cast<float> (envelopeVal / (currentParameters.release * sr));
-                currentState = State::release;
-            }
-            else
-            {
-                reset();
-            }
-        }
+        startRelease (currentState, envelopeVal, releaseRate);
     }
 
     //==============================================================================
     /** Returns the next sample value for an ADSR object.
 
-        @see applyEnvelopeToBuffer
+        @see getNextBlock, applyEnvelopeToBuffer
     */
     float getNextSample()
     {
@@ -194,10 +177,23 @@ public:
         return envelopeVal;
     }
 
+    /** Writes the next numSamples envelope values into a buffer.
+
+        This produces the same values as calling getNextSample() numSamples times (to
+        within floating point rounding), but each stage of the envelope is calculated
+        as a single ramp, which the compiler can vectorise.
+
+        @see getNextSample, applyEnvelopeToBuffer
+    */
+    void getNextBlock (float* destination, int numSamples) noexcept
+    {
+        renderStages (currentState, envelopeVal, releaseRate, destination, numSamples);
+    }
+
     /** This method will conveniently apply the next numSamples number of envelope values
         to an AudioBuffer.
 
-        @see getNextSample
+        @see getNextSample, getNextBlock
     */
     template <typename FloatType>
     void applyEnvelopeToBuffer (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
@@ -205,20 +201,27 @@ public:
         jassert (startSample + numSamples <= buffer.getNumSamples());
 
         auto numChannels = buffer.getNumChannels();
+        float envelope[256];
 
-        while (--numSamples >= 0)
+        while (numSamples > 0)
         {
-            auto env = getNextSample();
+            auto numThisTime = jmin (numSamples, (int) numElementsInArray (envelope));
+            getNextBlock (envelope, numThisTime);
 
             for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+                multiplyByEnvelope (buffer.getWritePointer (i, startSample), envelope, numThisTime);
 
-            ++startSample;
+            startSample += numThisTime;
+            numSamples -= numThisTime;
         }
     }
 
 private:
     //==============================================================================
+    friend class ADSRBank;
+
+    enum class State { idle, attack, decay, sustain, release };
+
     void calculateRates (const Parameters& parameters)
     {
         // need to call setSampleRate() first!
@@ -228,16 +231,118 @@ private:
         decayRate   = (parameters.decay   > 0.0f ? static_cast<float> ((1.0f - sustainLevel) / (parameters.decay * sr))   : -1.0f);
     }
 
-    void checkCurrentState()
+    //==============================================================================
+    // These operate on the state of a single envelope, so that ADSRBank can use them too.
+    void startAttack (State& state, float& value) const noexcept
     {
-        if      (currentState == State::attack  && attackRate <= 0.0f)   currentState = decayRate > 0.0f ? State::decay : State::sustain;
-        else if (currentState == State::decay   && decayRate <= 0.0f)    currentState = State::sustain;
-        else if (currentState == State::release && releaseRate <= 0.0f)  reset();
+        if (attackRate > 0.0f)
+        {
+            state = State::attack;
+        }
+        else if (decayRate > 0.0f)
+        {
+            value = 1.0f;
+            state = State::decay;
+        }
+        else
+        {
+            state = State::sustain;
+        }
     }
 
-    //==============================================================================
-    enum class State { idle, attack, decay, sustain, release };
+    void startRelease (State& state, float& value, float& release) const noexcept
+    {
+        if (state != State::idle)
+        {
+            if (currentParameters.release > 0.0f)
+            {
+                release = static_cast<float> (value / (currentParameters.release * sr));
+                state = State::release;
+            }
+            else
+            {
+                value = 0.0f;
+                state = State::idle;
+            }
+        }
+    }
+
+    void checkState (State& state, float& value, float release) const noexcept
+    {
+        if      (state == State::attack  && attackRate <= 0.0f)   state = decayRate > 0.0f ? State::decay : State::sustain;
+        else if (state == State::decay   && decayRate <= 0.0f)    state = State::sustain;
+        else if (state == State::release && release <= 0.0f)      { value = 0.0f; state = State::idle; }
+    }
+
+    void renderStages (State& state, float& value, float release, float* destination, int numSamples) const noexcept
+    {
+        while (numSamples > 0)
+        {
+            if (state == State::idle)
+            {
+                FloatVectorOperations::clear (destination, numSamples);
+                return;
+            }
+
+            if (state == State::sustain)
+            {
+                value = sustainLevel;
+                FloatVectorOperations::fill (destination, sustainLevel, numSamples);
+                return;
+            }
+
+            auto increment = 0.0f, target = 0.0f, distance = 0.0f;
+
+            if (state == State::attack)        { increment = attackRate; target = 1.0f;         distance = target - value; }
+            else if (state == State::decay)    { increment = -decayRate; target = sustainLevel; distance = value - target; }
+            else                               { increment = -release;   target = 0.0f;         distance = value; }
+
+            // the number of steps until this stage reaches its target, as getNextSample() would take them
+            auto step = std::abs (increment);
+            auto numSteps = (step > 0.0f && distance > 0.0f) ? std::ceil (distance / step) : 1.0f;
+            auto numToEnd = numSteps > (float) numSamples ? numSamples + 1 : jmax (1, (int) numSteps);
+            auto numThisTime = jmin (numToEnd, numSamples);
+
+            fillRamp (destination, value, increment, numThisTime);
+
+            if (numThisTime == numToEnd)
+            {
+                value = target;
+                destination[numThisTime - 1] = target;
+
+                if (state == State::attack)      state = decayRate > 0.0f ? State::decay : State::sustain;
+                else if (state == State::decay)  state = State::sustain;
+                else                             state = State::idle;
+            }
+            else
+            {
+                value += increment * (float) numThisTime;
+            }
+
+            destination += numThisTime;
+            numSamples -= numThisTime;
+        }
+    }
+
+    static void fillRamp (float* destination, float start, float increment, int numSamples) noexcept
+    {
+        // each value is calculated independently so that this loop can be vectorised
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = start + increment * (float) (i + 1);
+    }
+
+    static void multiplyByEnvelope (float* destination, const float* envelope, int numSamples) noexcept
+    {
+        FloatVectorOperations::multiply (destination, envelope, numSamples);
+    }
 
+    static void multiplyByEnvelope (double* destination, const float* envelope, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] *= envelope[i];
+    }
+
+    //==============================================================================
     State currentState = State::idle;
     Parameters currentParameters;
 
@@ -245,4 +350,129 @@ private:
     float envelopeVal = 0.0f, sustainLevel = 0.0f, attackRate = 0.0f, decayRate = 0.0f, releaseRate = 0.0f;
 };
 
+//==============================================================================
+/**
+    A set of ADSR envelopes which share the same parameters.
+
+    This is intended for polyphonic synths, where each voice needs its own envelope
+    but all of them use the same attack, decay, sustain and release settings. The
+    state of the envelopes is kept in contiguous arrays rather than in separate ADSR
+    objects, and getNextBlock() renders all of them in one call, skipping over any
+    that are idle.
+
+    Each envelope is identified by its index, so a voice will typically just remember
+    which index it's using, e.g. the lane it occupies in a SynthesiserVoiceBank.
+
+    @see ADSR
+
+    @tags{Audio}
+*/
+class ADSRBank
+{
+public:
+    //==============================================================================
+    /** Creates a bank containing the given number of idle envelopes. */
+    explicit ADSRBank (int numEnvelopesToUse = 0)
+    {
+        setNumEnvelopes (numEnvelopesToUse);
+    }
+
+    /** Changes the number of envelopes in the bank.
+        This will reset all of the envelopes to their idle state, and may allocate memory.
+    */
+    void setNumEnvelopes (int newNumEnvelopes)
+    {
+        jassert (newNumEnvelopes >= 0);
+
+        states.assign ((size_t) newNumEnvelopes, ADSR::State::idle);
+        values.assign ((size_t) newNumEnvelopes, 0.0f);
+        releaseRates.assign ((size_t) newNumEnvelopes, 0.0f);
+    }
+
+    /** Returns the number of envelopes in the bank. */
+    int getNumEnvelopes() const noexcept                        { return (int) states.size(); }
+
+    //==============================================================================
+    /** Sets the sample rate that will be used for the envelopes.
+        This must be called before getNextBlock() or setParameters().
+    */
+    void setSampleRate (double sampleRate)                      { envelope.setSampleRate (sampleRate); }
+
+    /** Sets the parameters that will be used by all the envelopes in the bank. */
+    void setParameters (const ADSR::Parameters& newParameters)
+    {
+        envelope.setParameters (newParameters);
+
+        for (size_t i = 0; i < states.size(); ++i)
+            if (states[i] != ADSR::State::idle)
+                envelope.checkState (states[i], values[i], releaseRates[i]);
+    }
+
+    /** Returns the parameters currently being used by the envelopes. */
+    const ADSR::Parameters& getParameters() const noexcept      { return envelope.getParameters(); }
+
+    //==============================================================================
+    /** Resets all of the envelopes to their idle state. */
+    void reset() noexcept
+    {
+        std::fill (states.begin(), states.end(), ADSR::State::idle);
+        std::fill (values.begin(), values.end(), 0.0f);
+    }
+
+    /** Resets one of the envelopes to its idle state. */
+    void reset (int index) noexcept
+    {
+        states[checkIndex (index)] = ADSR::State::idle;
+        values[(size_t) index] = 0.0f;
+    }
+
+    /** Starts the attack phase of one of the envelopes. */
+    void noteOn (int index) noexcept
+    {
+        envelope.startAttack (states[checkIndex (index)], values[(size_t) index]);
+    }
+
+    /** Starts the release phase of one of the envelopes. */
+    void noteOff (int index) noexcept
+    {
+        envelope.startRelease (states[checkIndex (index)], values[(size_t) index], releaseRates[(size_t) index]);
+    }
+
+    /** Returns true if one of the envelopes is in its attack, decay, sustain or release stage. */
+    bool isActive (int index) const noexcept                    { return states[checkIndex (index)] != ADSR::State::idle; }
+
+    /** Returns the current value of one of the envelopes. */
+    float getCurrentValue (int index) const noexcept            { return values[checkIndex (index)]; }
+
+    //==============================================================================
+    /** Writes the next numSamples values of every envelope in the bank.
+
+        The destinations array must contain getNumEnvelopes() pointers, each of which
+        must have space for numSamples values. Idle envelopes write zeros. The results
+        are the same as calling ADSR::getNextBlock() on a separate ADSR for each envelope.
+    */
+    void getNextBlock (float* const* destinations, int numSamples) noexcept
+    {
+        for (size_t i = 0; i < states.size(); ++i)
+        {
+            if (states[i] == ADSR::State::idle)
+                FloatVectorOperations::clear (destinations[i], numSamples);
+            else
+                envelope.renderStages (states[i], values[i], releaseRates[i], destinations[i], numSamples);
+        }
+    }
+
+private:
+    //==============================================================================
+    size_t checkIndex (int index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, getNumEnvelopes()));
+        return (size_t) index;
+    }
+
+    ADSR envelope;
+    std::vector<ADSR::State> states;
+    std::vector<float> values, releaseRates;
+};
+
 } // namespace juce
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ADSRTests  : public UnitTest
+{
+public:
+    ADSRTests()  : UnitTest ("ADSR", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr auto sampleRate = 44100.0;
+        const ADSR::Parameters parameters { 0.01f, 0.05f, 0.4f, 0.02f };
+
+        beginTest ("Idle");
+        {
+            ADSR adsr;
+            adsr.setSampleRate (sampleRate);
+            adsr.setParameters (parameters);
+
+            HeapBlock<float> block (100);
+            adsr.getNextBlock (block, 100);
+
+            for (int i = 0; i < 100; ++i)
+                expectEquals (block[i], 0.0f);
+
+            expect (! adsr.isActive());
+        }
+
+        beginTest ("Blocks match per-sample envelope");
+        {
+            for (auto blockSize : { 1, 7, 64, 512, 4096 })
+            {
+                ADSR perSample, blockwise;
+
+                for (auto* adsr : { &perSample, &blockwise })
+                {
+                    adsr->setSampleRate (sampleRate);
+                    adsr->setParameters (parameters);
+                    adsr->noteOn();
+                }
+
+                expectEnvelopesMatch (perSample, blockwise, 6000, blockSize);
+
+                perSample.noteOff();
+                blockwise.noteOff();
+                expectEnvelopesMatch (perSample, blockwise, 1500, blockSize);
+
+                expect (! perSample.isActive());
+                expect (! blockwise.isActive());
+            }
+        }
+
+        beginTest ("Zero-length stages");
+        {
+            ADSR perSample, blockwise;
+
+            for (auto* adsr : { &perSample, &blockwise })
+            {
+                adsr->setSampleRate (sampleRate);
+                adsr->setParameters ({ 0.0f, 0.0f, 0.7f, 0.0f });
+                adsr->noteOn();
+            }
+
+            expectEnvelopesMatch (perSample, blockwise, 100, 32);
+
+            perSample.noteOff();
+            blockwise.noteOff();
+            expect (! blockwise.isActive());
+            expectEnvelopesMatch (perSample, blockwise, 100, 32);
+        }
+
+        beginTest ("Apply envelope to buffer");
+        {
+            ADSR reference, adsr;
+
+            for (auto* a : { &reference, &adsr })
+            {
+                a->setSampleRate (sampleRate);
+                a->setParameters (parameters);
+                a->noteOn();
+            }
+
+            AudioBuffer<float> buffer (2, 1000);
+
+            for (int ch = 0; ch < 2; ++ch)
+                FloatVectorOperations::fill (buffer.getWritePointer (ch), 0.5f, 1000);
+
+            adsr.applyEnvelopeToBuffer (buffer, 0, 1000);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto expected = 0.5f * reference.getNextSample();
+                expectWithinAbsoluteError (buffer.getSample (0, i), expected, 1.0e-4f);
+                expectWithinAbsoluteError (buffer.getSample (1, i), expected, 1.0e-4f);
+            }
+        }
+
+        beginTest ("ADSRBank matches separate envelopes");
+        {
+            constexpr int numEnvelopes = 5, blockSize = 256;
+
+            ADSRBank bank (numEnvelopes);
+            bank.setSampleRate (sampleRate);
+            bank.setParameters (parameters);
+
+            OwnedArray<ADSR> envelopes;
+
+            for (int i = 0; i < numEnvelopes; ++i)
+            {
+                auto* adsr = envelopes.add (new ADSR());
+                adsr->setSampleRate (sampleRate);
+                adsr->setParameters (parameters);
+            }
+
+            AudioBuffer<float> bankOutput (numEnvelopes, blockSize), expected (1, blockSize);
+
+            for (int blockIndex = 0; blockIndex < 40; ++blockIndex)
+            {
+                // start and stop the envelopes at different times
+                for (int i = 0; i < numEnvelopes; ++i)
+                {
+                    if (blockIndex == i * 3)
+                    {
+                        bank.noteOn (i);
+                        envelopes[i]->noteOn();
+                    }
+                    else if (blockIndex == i * 3 + 10)
+                    {
+                        bank.noteOff (i);
+                        envelopes[i]->noteOff();
+                    }
+                }
+
+                bank.getNextBlock (bankOutput.getArrayOfWritePointers(), blockSize);
+
+                for (int i = 0; i < numEnvelopes; ++i)
+                {
+                    envelopes[i]->getNextBlock (expected.getWritePointer (0), blockSize);
+
+                    for (int s = 0; s < blockSize; ++s)
+                        expectEquals (bankOutput.getSample (i, s), expected.getSample (0, s));
+
+                    expect (bank.isActive (i) == envelopes[i]->isActive());
+                }
+            }
+
+            for (int i = 0; i < numEnvelopes; ++i)
+                expect (! bank.isActive (i));
+        }
+    }
+
+private:
+    void expectEnvelopesMatch (ADSR& perSample, ADSR& blockwise, int numSamples, int blockSize)
+    {
+        // the block renderer calculates each ramp directly rather than by accumulation,
+        // so the two can differ by rounding, or by a single step at the end of a stage
+        const auto tolerance = 1.0e-5f + 1.0f / (0.01f * 44100.0f);
+
+        HeapBlock<float> block ((size_t) blockSize);
+
+        for (int pos = 0; pos < numSamples; pos += blockSize)
+        {
+            auto numThisTime = jmin (blockSize, numSamples - pos);
+            blockwise.getNextBlock (block, numThisTime);
+
+            for (int i = 0; i < numThisTime; ++i)
+                expectWithinAbsoluteError (block[i], perSample.getNextSample(), tolerance);
+        }
+    }
+};
+
+static ADSRTests adsrTests;
+
+} // namespace juce
@@ -82,6 +82,116 @@ public:
             for (int i = 0; i < values.getNumSamples(); ++i)
                 expectWithinAbsoluteError (values.getSample (0, i), values.getSample (1, i), 1.0e-9);
         }
+
+        beginTest ("Block ramps");
+        {
+            expectBlockRampsMatch<ValueSmoothingTypes::Linear> (0.25f, 3.5f);
+            expectBlockRampsMatch<ValueSmoothingTypes::Linear> (1.0f, -2.0f);
+            expectBlockRampsMatch<ValueSmoothingTypes::Multiplicative> (20.0f, 20000.0f);
+            expectBlockRampsMatch<ValueSmoothingTypes::Multiplicative> (1.0f, 0.001f);
+        }
+
+        beginTest ("SmoothedValueBank");
+        {
+            expectBankMatches<ValueSmoothingTypes::Linear>();
+            expectBankMatches<ValueSmoothingTypes::Multiplicative>();
+        }
+    }
+
+private:
+    template <typename SmoothingType>
+    void expectBlockRampsMatch (float start, float end)
+    {
+        for (auto blockSize : { 1, 5, 64, 1000 })
+        {
+            SmoothedValue<float, SmoothingType> perSample (start), blockwise (start);
+
+            for (auto* sv : { &perSample, &blockwise })
+            {
+                sv->reset (500);
+                sv->setTargetValue (end);
+            }
+
+            HeapBlock<float> block ((size_t) blockSize);
+            const auto absoluteError = jmax (std::abs (start), std::abs (end)) * 1.0e-6f;
+
+            for (int pos = 0; pos < 700; pos += blockSize)
+            {
+                blockwise.getNextValues (block, blockSize);
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    auto expected = perSample.getNextValue();
+                    expectWithinAbsoluteError (block[i], expected, std::abs (expected) * 1.0e-5f + absoluteError);
+                }
+
+                expectWithinAbsoluteError (blockwise.getCurrentValue(), perSample.getCurrentValue(),
+                                           std::abs (perSample.getCurrentValue()) * 1.0e-5f + absoluteError);
+                expect (blockwise.isSmoothing() == perSample.isSmoothing());
+            }
+
+            expectEquals (blockwise.getCurrentValue(), end);
+        }
+    }
+
+    template <typename SmoothingType>
+    void expectBankMatches()
+    {
+        constexpr int numValues = 4, blockSize = 64;
+        const float targets[] = { 2.0f, 0.5f, 10.0f, 1.0f };
+
+        SmoothedValueBank<float, SmoothingType> bank (numValues);
+        OwnedArray<SmoothedValue<float, SmoothingType>> separate;
+
+        bank.reset (200);
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            bank.setCurrentAndTargetValue (i, 1.0f);
+            bank.setTargetValue (i, targets[i]);
+
+            auto* sv = separate.add (new SmoothedValue<float, SmoothingType> (1.0f));
+            sv->reset (200);
+            sv->setTargetValue (targets[i]);
+        }
+
+        expect (bank.isAnySmoothing());
+        expect (! bank.isSmoothing (3));
+
+        AudioBuffer<float> bankRamps (numValues, blockSize), expected (1, blockSize);
+        float* destinations[] = { bankRamps.getWritePointer (0), nullptr,
+                                  bankRamps.getWritePointer (2), bankRamps.getWritePointer (3) };
+
+        for (int block = 0; block < 5; ++block)
+        {
+            if (block == 2)
+            {
+                bank.setTargetValue (0, 3.0f);
+                separate[0]->setTargetValue (3.0f);
+            }
+
+            bank.getNextValues (destinations, blockSize);
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                separate[i]->getNextValues (expected.getWritePointer (0), blockSize);
+
+                if (destinations[i] != nullptr)
+                    for (int s = 0; s < blockSize; ++s)
+                        expectWithinAbsoluteError (bankRamps.getSample (i, s), expected.getSample (0, s), 1.0e-5f);
+
+                expectWithinAbsoluteError (bank.getCurrentValue (i), separate[i]->getCurrentValue(), 1.0e-5f);
+                expect (bank.isSmoothing (i) == separate[i]->isSmoothing());
+            }
+        }
+
+        bank.skip (1000);
+        expect (! bank.isAnySmoothing());
+
+        for (int i = 1; i < numValues; ++i)
+            expectEquals (bank.getCurrentValue (i), targets[i]);
+
+        expectEquals (bank.getCurrentValue (0), 3.0f);
     }
 };
 
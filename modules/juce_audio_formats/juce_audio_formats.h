@@ -127,3 +127,4 @@
 #include "codecs/juce_WavAudioFormat.h"
 #include "codecs/juce_WindowsMediaAudioFormat.h"
 #include "sampler/juce_Sampler.h"
+#include "sampler/juce_StreamingSampler.h"
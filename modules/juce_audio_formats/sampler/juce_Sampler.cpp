@@ -33,6 +33,19 @@ SamplerSound::SamplerSound (const String& soundName,
                             double attackTimeSecs,
                             double releaseTimeSecs,
                             double maxSampleLengthSeconds)
+    : SamplerSound (soundName, source, notes, midiNoteForNormalPitch,
+                    attackTimeSecs, releaseTimeSecs, maxSampleLengthSeconds, Storage::floatingPoint)
+{
+}
+
+SamplerSound::SamplerSound (const String& soundName,
+                            AudioFormatReader& source,
+                            const BigInteger& notes,
+                            int midiNoteForNormalPitch,
+                            double attackTimeSecs,
+                            double releaseTimeSecs,
+                            double maxSampleLengthSeconds,
+                            Storage storageToUse)
     : name (soundName),
       sourceSampleRate (source.sampleRate),
       midiNotes (notes),
@@ -43,9 +56,23 @@ SamplerSound::SamplerSound (const String& soundName,
         length = jmin ((int) source.lengthInSamples,
                        (int) (maxSampleLengthSeconds * sourceSampleRate));
 
-        data.reset (new AudioBuffer<float> (jmin (2, (int) source.numChannels), length + 4));
+        if (storageToUse == Storage::smallestLossless)
+            storageToUse = (source.usesFloatingPointData || source.bitsPerSample > 24) ? Storage::floatingPoint
+                                                                                       : (source.bitsPerSample > 16 ? Storage::packed24Bit
+                                                                                                                    : Storage::packed16Bit);
+
+        storage = storageToUse;
+
+        if (storage == Storage::floatingPoint)
+        {
+            data.reset (new AudioBuffer<float> (jmin (2, (int) source.numChannels), length + 4));
 
-        source.read (data.get(), 0, length + 4, 0, true, true);
+            source.read (data.get(), 0, length + 4, 0, true, true);
+        }
+        else
+        {
+            loadPackedData (source);
+        }
 
         params.attack  = static_cast<float> (attackTimeSecs);
         params.release = static_cast<float> (releaseTimeSecs);
@@ -56,6 +83,86 @@ SamplerSound::~SamplerSound()
 {
 }
 
+//==============================================================================
+static size_t getPackedChannelSize (int numSamples, int bytesPerSample) noexcept
+{
+    // (leaves at least one spare byte, so the last 24-bit sample can be loaded as a 32-bit word)
+    return ((size_t) numSamples * (size_t) bytesPerSample + 16) & ~(size_t) 15;
+}
+
+void SamplerSound::loadPackedData (AudioFormatReader& source)
+{
+    numPackedChannels = jmin (2, (int) source.numChannels);
+
+    auto numSamples = length + 4;
+    auto bytesPerSample = storage == Storage::packed16Bit ? 2 : 3;
+    auto channelSize = getPackedChannelSize (numSamples, bytesPerSample);
+
+    packedData.calloc (channelSize * (size_t) numPackedChannels);
+
+    // The source is read a chunk at a time, so the whole sample never has to be held as floats
+    AudioBuffer<float> chunk (numPackedChannels, 16384);
+
+    for (int pos = 0; pos < numSamples; pos += chunk.getNumSamples())
+    {
+        auto num = jmin (chunk.getNumSamples(), numSamples - pos);
+        source.read (&chunk, 0, num, pos, true, true);
+
+        for (int ch = 0; ch < numPackedChannels; ++ch)
+        {
+            auto* src = chunk.getReadPointer (ch);
+            auto* channelData = packedData + channelSize * (size_t) ch;
+
+            if (storage == Storage::packed16Bit)
+            {
+                auto* dest = reinterpret_cast<int16*> (channelData) + pos;
+
+                for (int i = 0; i < num; ++i)
+                    dest[i] = (int16) jlimit (-32768, 32767, roundToInt (src[i] * 32768.0f));
+            }
+            else
+            {
+                auto* dest = channelData + pos * 3;
+
+                for (int i = 0; i < num; ++i)
+                    ByteOrder::littleEndian24BitToChars (jlimit (-8388608, 8388607, roundToInt (src[i] * 8388608.0f)),
+                                                         dest + i * 3);
+            }
+        }
+    }
+}
+
+void SamplerSound::unpackSamples (float* const* dest, int startSample, int numSamples) const noexcept
+{
+    auto bytesPerSample = storage == Storage::packed16Bit ? 2 : 3;
+    auto channelSize = getPackedChannelSize (length + 4, bytesPerSample);
+
+    for (int ch = 0; ch < numPackedChannels; ++ch)
+    {
+        auto* channelData = packedData + channelSize * (size_t) ch;
+        auto* d = dest[ch];
+
+        // These loops are kept simple enough for the compiler to vectorise
+        if (storage == Storage::packed16Bit)
+        {
+            auto* src = reinterpret_cast<const int16*> (channelData) + startSample;
+
+            for (int i = 0; i < numSamples; ++i)
+                d[i] = (float) src[i] * (1.0f / 32768.0f);
+        }
+        else
+        {
+            auto* src = channelData + startSample * 3;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto word = ByteOrder::swapIfBigEndian (readUnaligned<uint32> (src + i * 3));
+                d[i] = (float) (((int32) (word << 8)) >> 8) * (1.0f / 8388608.0f);
+            }
+        }
+    }
+}
+
 bool SamplerSound::appliesToNote (int midiNoteNumber)
 {
     return midiNotes[midiNoteNumber];
@@ -118,48 +225,181 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
 {
     if (auto* playingSound = static_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
     {
-        auto& data = *playingSound->data;
-        const float* const inL = data.getReadPointer (0);
-        const float* const inR = data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr;
-
-        float* outL = outputBuffer.getWritePointer (0, startSample);
-        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
-
-        while (--numSamples >= 0)
+        if (auto* data = playingSound->data.get())
         {
-            auto pos = (int) sourceSamplePosition;
-            auto alpha = (float) (sourceSamplePosition - pos);
-            auto invAlpha = 1.0f - alpha;
+            renderSamples (*playingSound,
+                           data->getReadPointer (0),
+                           data->getNumChannels() > 1 ? data->getReadPointer (1) : nullptr,
+                           0, outputBuffer, startSample, numSamples);
+        }
+        else if (playingSound->packedData != nullptr)
+        {
+            float* unpacked[] = { unpackBuffer[0], unpackBuffer[1] };
+            auto numAvailable = playingSound->length + 4;
 
-            // just using a very simple linear interpolation here..
-            float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
-            float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
-                                       : l;
+            while (numSamples > 0)
+            {
+                // render as many samples as can be interpolated from one buffer-full of unpacked data
+                auto firstSample = (int) sourceSamplePosition;
+                auto numToRender = jlimit (1, numSamples, (int) ((unpackBufferSize - 3) / pitchRatio));
+                auto numToUnpack = jmin ((int) unpackBufferSize, numAvailable - firstSample, (int) (pitchRatio * numToRender) + 3);
 
-            auto envelopeValue = adsr.getNextSample();
+                playingSound->unpackSamples (unpacked, firstSample, numToUnpack);
 
-            l *= lgain * envelopeValue;
-            r *= rgain * envelopeValue;
+                if (! renderSamples (*playingSound, unpacked[0],
+                                     playingSound->numPackedChannels > 1 ? unpacked[1] : nullptr,
+                                     firstSample, outputBuffer, startSample, numToRender))
+                    break;
 
-            if (outR != nullptr)
-            {
-                *outL++ += l;
-                *outR++ += r;
-            }
-            else
-            {
-                *outL++ += (l + r) * 0.5f;
+                startSample += numToRender;
+                numSamples  -= numToRender;
             }
+        }
+    }
+}
+
+bool SamplerVoice::renderSamples (const SamplerSound& playingSound, const float* inL, const float* inR, int inputStart,
+                                  AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    float* outL = outputBuffer.getWritePointer (0, startSample);
+    float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
 
-            sourceSamplePosition += pitchRatio;
+    while (--numSamples >= 0)
+    {
+        auto pos = (int) sourceSamplePosition;
+        auto alpha = (float) (sourceSamplePosition - pos);
+        auto invAlpha = 1.0f - alpha;
+        pos -= inputStart;
 
-            if (sourceSamplePosition > playingSound->length)
-            {
-                stopNote (0.0f, false);
-                break;
-            }
+        // just using a very simple linear interpolation here..
+        float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
+        float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
+                                   : l;
+
+        auto envelopeValue = adsr.getNextSample();
+
+        l *= lgain * envelopeValue;
+        r *= rgain * envelopeValue;
+
+        if (outR != nullptr)
+        {
+            *outL++ += l;
+            *outR++ += r;
+        }
+        else
+        {
+            *outL++ += (l + r) * 0.5f;
+        }
+
+        sourceSamplePosition += pitchRatio;
+
+        if (sourceSamplePosition > playingSound.length)
+        {
+            stopNote (0.0f, false);
+            return false;
         }
     }
+
+    return true;
 }
 
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SamplerTests  : public UnitTest
+{
+    SamplerTests()
+        : UnitTest ("Sampler", UnitTestCategories::audio)
+    {}
+
+    static MemoryBlock createWavData (int bitsPerSample, int numChannels, Random& rng)
+    {
+        AudioBuffer<float> sample (numChannels, 20000);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < sample.getNumSamples(); ++i)
+                sample.setSample (ch, i, rng.nextFloat() * 2.0f - 1.0f);
+
+        MemoryBlock wavData;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (new MemoryOutputStream (wavData, false),
+                                                                                         44100.0, (unsigned int) numChannels,
+                                                                                         bitsPerSample, {}, 0));
+            writer->writeFromAudioSampleBuffer (sample, 0, sample.getNumSamples());
+        }
+
+        return wavData;
+    }
+
+    static AudioBuffer<float> render (const MemoryBlock& wavData, SamplerSound::Storage storage, int note)
+    {
+        std::unique_ptr<AudioFormatReader> reader (WavAudioFormat().createReaderFor (new MemoryInputStream (wavData, false), true));
+
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+
+        Synthesiser synth;
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.addVoice (new SamplerVoice());
+        synth.addSound (new SamplerSound ("test", *reader, notes, 60, 0.01, 0.1, 10.0, storage));
+
+        AudioBuffer<float> output (2, 30000);
+        output.clear();
+
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn (1, note, 1.0f), 0);
+        synth.renderNextBlock (output, midi, 0, output.getNumSamples());
+
+        return output;
+    }
+
+    void expectSameOutput (const MemoryBlock& wavData, SamplerSound::Storage storage)
+    {
+        for (auto note : { 60, 64, 36, 96 })
+        {
+            auto expected = render (wavData, SamplerSound::Storage::floatingPoint, note);
+            auto actual   = render (wavData, storage, note);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < expected.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (actual.getSample (ch, i), expected.getSample (ch, i), 1.0e-6f);
+        }
+    }
+
+    void runTest() override
+    {
+        auto rng = getRandom();
+
+        beginTest ("Packed 16-bit storage");
+        {
+            auto wavData = createWavData (16, 2, rng);
+            expectSameOutput (wavData, SamplerSound::Storage::packed16Bit);
+            expectSameOutput (createWavData (16, 1, rng), SamplerSound::Storage::packed16Bit);
+
+            std::unique_ptr<AudioFormatReader> reader (WavAudioFormat().createReaderFor (new MemoryInputStream (wavData, false), true));
+            SamplerSound sound ("test", *reader, {}, 60, 0.0, 0.0, 10.0, SamplerSound::Storage::smallestLossless);
+            expect (sound.getStorage() == SamplerSound::Storage::packed16Bit);
+            expect (sound.getAudioData() == nullptr);
+        }
+
+        beginTest ("Packed 24-bit storage");
+        {
+            auto wavData = createWavData (24, 2, rng);
+            expectSameOutput (wavData, SamplerSound::Storage::packed24Bit);
+
+            std::unique_ptr<AudioFormatReader> reader (WavAudioFormat().createReaderFor (new MemoryInputStream (wavData, false), true));
+            SamplerSound sound ("test", *reader, {}, 60, 0.0, 0.0, 10.0, SamplerSound::Storage::smallestLossless);
+            expect (sound.getStorage() == SamplerSound::Storage::packed24Bit);
+        }
+    }
+};
+
+static SamplerTests samplerTests;
+
+#endif
+
 } // namespace juce
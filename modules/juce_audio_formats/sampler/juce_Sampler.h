@@ -31,7 +31,8 @@ namespace juce
     A subclass of SynthesiserSound that represents a sampled audio clip.
 
     This is a pretty basic sampler, and just attempts to load the whole audio stream
-    into memory.
+    into memory. To reduce the amount of memory this takes, the sample can be kept
+    as packed 16 or 24-bit integers rather than floats - see SamplerSound::Storage.
 
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
@@ -44,6 +45,16 @@ class JUCE_API  SamplerSound    : public SynthesiserSound
 {
 public:
     //==============================================================================
+    /** The formats in which a SamplerSound can hold its sample data. */
+    enum class Storage
+    {
+        floatingPoint,      /**< 32-bit floats - the fastest to play, but the largest. */
+        packed16Bit,        /**< Packed 16-bit integers, which are converted while playing. */
+        packed24Bit,        /**< Packed 24-bit integers, which are converted while playing. */
+        smallestLossless    /**< Whichever of the formats above can hold the source's
+                                 data without losing any precision. */
+    };
+
     /** Creates a sampled sound from an audio reader.
 
         This will attempt to load the audio from the source into memory and store
@@ -70,6 +81,21 @@ public:
                   double releaseTimeSecs,
                   double maxSampleLengthSeconds);
 
+    /** Creates a sampled sound from an audio reader, using the given storage format.
+
+        The parameters are the same as for the other constructor, apart from storage,
+        which selects the format in which the sample is kept in memory. Converting to
+        a format with fewer bits than the source will lose some precision.
+    */
+    SamplerSound (const String& name,
+                  AudioFormatReader& source,
+                  const BigInteger& midiNotes,
+                  int midiNoteForNormalPitch,
+                  double attackTimeSecs,
+                  double releaseTimeSecs,
+                  double maxSampleLengthSeconds,
+                  Storage storage);
+
     /** Destructor. */
     ~SamplerSound() override;
 
@@ -78,10 +104,14 @@ public:
     const String& getName() const noexcept                  { return name; }
 
     /** Returns the audio sample data.
-        This could return nullptr if there was a problem loading the data.
+        This could return nullptr if there was a problem loading the data, or if the
+        sound is using one of the packed integer storage formats.
     */
     AudioBuffer<float>* getAudioData() const noexcept       { return data.get(); }
 
+    /** Returns the format in which the sample data is being held. */
+    Storage getStorage() const noexcept                     { return storage; }
+
     //==============================================================================
     /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
     void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
@@ -96,12 +126,17 @@ private:
 
     String name;
     std::unique_ptr<AudioBuffer<float>> data;
+    HeapBlock<char> packedData;
+    Storage storage = Storage::floatingPoint;
     double sourceSampleRate;
     BigInteger midiNotes;
-    int length = 0, midiRootNote = 0;
+    int length = 0, midiRootNote = 0, numPackedChannels = 0;
 
     ADSR::Parameters params;
 
+    void loadPackedData (AudioFormatReader&);
+    void unpackSamples (float* const* dest, int startSample, int numSamples) const noexcept;
+
     JUCE_LEAK_DETECTOR (SamplerSound)
 };
 
@@ -147,6 +182,13 @@ private:
 
     ADSR adsr;
 
+    // Packed samples are converted into this a section at a time while rendering
+    enum { unpackBufferSize = 1024 };
+    float unpackBuffer[2][unpackBufferSize];
+
+    bool renderSamples (const SamplerSound&, const float* inL, const float* inR, int inputStart,
+                        AudioBuffer<float>&, int startSample, int numSamples);
+
     JUCE_LEAK_DETECTOR (SamplerVoice)
 };
 
@@ -0,0 +1,530 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+SamplerDiskStreamer::SamplerDiskStreamer (int chunkSize, bool useBackgroundThread)
+    : Thread ("Sampler disk streamer"),
+      readBuffer (2, jmax (256, chunkSize))
+{
+    if (useBackgroundThread)
+        startThread (7);
+}
+
+SamplerDiskStreamer::~SamplerDiskStreamer()
+{
+    // All the voices using this streamer must have been deleted first!
+    jassert (voices.isEmpty());
+
+    stopThread (4000);
+}
+
+void SamplerDiskStreamer::addVoice (StreamingSamplerVoice* voice)
+{
+    const ScopedLock sl (voiceLock);
+    voices.add (voice);
+}
+
+void SamplerDiskStreamer::removeVoice (StreamingSamplerVoice* voice)
+{
+    const ScopedLock sl (voiceLock);
+    voices.removeFirstMatchingValue (voice);
+}
+
+bool SamplerDiskStreamer::serviceMostUrgentVoice()
+{
+    const ScopedLock sl (voiceLock);
+
+    StreamingSamplerVoice* mostUrgent = nullptr;
+    double lowestUrgency = 0;
+
+    for (auto* voice : voices)
+    {
+        double urgency;
+
+        if (voice->getStreamingUrgency (urgency, readBuffer.getNumSamples() / 4)
+             && (mostUrgent == nullptr || urgency < lowestUrgency))
+        {
+            mostUrgent = voice;
+            lowestUrgency = urgency;
+        }
+    }
+
+    return mostUrgent != nullptr && mostUrgent->readNextChunk (readBuffer);
+}
+
+void SamplerDiskStreamer::run()
+{
+    while (! threadShouldExit())
+        if (! serviceMostUrgentVoice())
+            wait (2);
+}
+
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              AudioFormatReader* source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double maxSampleLengthSeconds,
+                                              double preloadTimeSecs)
+    : name (soundName),
+      reader (source),
+      sourceSampleRate (source->sampleRate),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (sourceSampleRate > 0 && source->lengthInSamples > 0)
+    {
+        length = jmin ((int) source->lengthInSamples,
+                       (int) (maxSampleLengthSeconds * sourceSampleRate));
+
+        preloadLength = jlimit (0, getStreamEnd(), (int) (preloadTimeSecs * sourceSampleRate));
+
+        // One extra sample, so that the voice can interpolate across the end of the head
+        preloadBuffer.setSize (jmin (2, (int) source->numChannels), preloadLength + 1);
+        source->read (&preloadBuffer, 0, preloadLength + 1, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+void StreamingSamplerSound::readFromSource (AudioBuffer<float>& buffer, int numSamples, int64 startSample)
+{
+    const ScopedLock sl (readerLock);
+    reader->read (&buffer, 0, numSamples, startSample, true, true);
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (SamplerDiskStreamer& s, int bufferSize)
+    : streamer (s),
+      ringBuffer (2, jmax (1024, bufferSize)),
+      fifo (jmax (1024, bufferSize))
+{
+    streamer.addVoice (this);
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    streamer.removeVoice (this);
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (sound->sourceSampleRate);
+        adsr.setParameters (sound->params);
+
+        streamRate = (float) pitchRatio;
+        streamPriority = 1.0f + velocity;
+        startStreaming (*sound);
+
+        adsr.noteOn();
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+
+        // notes that are fading out can wait for their data behind ones that are still held
+        streamPriority = 0.25f;
+    }
+    else
+    {
+        clearCurrentNote();
+        adsr.reset();
+        stopStreaming();
+    }
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+//==============================================================================
+void StreamingSamplerVoice::startStreaming (StreamingSamplerSound& sound)
+{
+    const SpinLock::ScopedLockType sl (streamLock);
+
+    fifo.reset();
+    streamSound = &sound;
+    streamPosition = sound.preloadLength;
+    ++streamGeneration;
+
+    ringBufferStart = sound.preloadLength;
+    playPosition = 0;
+}
+
+void StreamingSamplerVoice::stopStreaming()
+{
+    const SpinLock::ScopedLockType sl (streamLock);
+
+    streamSound = nullptr;
+    ++streamGeneration;
+}
+
+bool StreamingSamplerVoice::getStreamingUrgency (double& urgency, int minChunkSize)
+{
+    const SpinLock::ScopedLockType sl (streamLock);
+
+    if (auto* sound = static_cast<StreamingSamplerSound*> (streamSound.get()))
+    {
+        auto numRemaining = sound->getStreamEnd() - streamPosition;
+
+        if (numRemaining > 0 && fifo.getFreeSpace() >= jmin ((int64) minChunkSize, numRemaining))
+        {
+            // the number of output samples this voice can play before it runs dry
+            auto samplesAhead = (double) (streamPosition - playPosition.load()) / jmax (0.001f, streamRate.load());
+            urgency = samplesAhead / streamPriority.load();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool StreamingSamplerVoice::readNextChunk (AudioBuffer<float>& buffer)
+{
+    SynthesiserSound::Ptr sound;
+    int64 startPosition;
+    uint32 generation;
+    int numToRead;
+
+    // Only this thread writes to the fifo, and the audio thread can't read any of the
+    // space that prepareToWrite() returns until finishedWrite() is called, so the lock
+    // only has to be held while the stream's state is read and updated, not for the
+    // disk read or the copy into the ring buffer.
+
+    {
+        const SpinLock::ScopedLockType sl (streamLock);
+
+        sound = streamSound;
+
+        if (sound == nullptr)
+            return false;
+
+        startPosition = streamPosition;
+        generation = streamGeneration;
+        numToRead = (int) jmin ((int64) jmin (fifo.getFreeSpace(), buffer.getNumSamples()),
+                                static_cast<StreamingSamplerSound*> (sound.get())->getStreamEnd() - startPosition);
+    }
+
+    if (numToRead <= 0)
+        return false;
+
+    static_cast<StreamingSamplerSound*> (sound.get())->readFromSource (buffer, numToRead, startPosition);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        ringBuffer.copyFrom (ch, start1, buffer, ch, 0, size1);
+
+        if (size2 > 0)
+            ringBuffer.copyFrom (ch, start2, buffer, ch, size1, size2);
+    }
+
+    const SpinLock::ScopedLockType sl (streamLock);
+
+    // If the voice has been restarted or stopped in the meantime, this data isn't wanted
+    if (generation == streamGeneration)
+    {
+        fifo.finishedWrite (size1 + size2);
+        streamPosition += size1 + size2;
+    }
+
+    return true;
+}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        auto& head = playingSound->preloadBuffer;
+        auto preloadLength = playingSound->preloadLength;
+        const float* const headL = head.getReadPointer (0);
+        const float* const headR = head.getNumChannels() > 1 ? head.getReadPointer (1) : nullptr;
+
+        // Anything that the streamer delivers while this block is rendering gets used next time
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+        auto numReady = size1 + size2;
+        auto ringSize = ringBuffer.getNumSamples();
+        const float* const ringL = ringBuffer.getReadPointer (0);
+        const float* const ringR = headR != nullptr ? ringBuffer.getReadPointer (1) : nullptr;
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+        bool hasUnderrun = false;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int) sourceSamplePosition;
+            auto alpha = (float) (sourceSamplePosition - pos);
+            auto invAlpha = 1.0f - alpha;
+            float l, r;
+
+            if (pos < preloadLength)
+            {
+                l = (headL[pos] * invAlpha + headL[pos + 1] * alpha);
+                r = (headR != nullptr) ? (headR[pos] * invAlpha + headR[pos + 1] * alpha)
+                                       : l;
+            }
+            else
+            {
+                auto offset = (int) (pos - ringBufferStart);
+
+                if (offset + 1 < numReady)
+                {
+                    auto i0 = start1 + offset;
+                    if (i0 >= ringSize)  i0 -= ringSize;
+
+                    auto i1 = i0 + 1;
+                    if (i1 >= ringSize)  i1 -= ringSize;
+
+                    l = (ringL[i0] * invAlpha + ringL[i1] * alpha);
+                    r = (ringR != nullptr) ? (ringR[i0] * invAlpha + ringR[i1] * alpha)
+                                           : l;
+                }
+                else
+                {
+                    // The streamer hasn't kept up, so this voice is silent until the data arrives,
+                    // but it carries on moving through the sample so that it stays in time
+                    if (! hasUnderrun)
+                    {
+                        hasUnderrun = true;
+                        ++numUnderruns;
+                        ++streamer.numUnderruns;
+                    }
+
+                    l = r = 0.0f;
+                }
+            }
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > playingSound->length)
+            {
+                stopNote (0.0f, false);
+                return;
+            }
+        }
+
+        auto numConsumed = jlimit (0, numReady, (int) ((int64) sourceSamplePosition - ringBufferStart));
+        fifo.finishedRead (numConsumed);
+        ringBufferStart += numConsumed;
+        playPosition = (int64) sourceSamplePosition;
+
+        if (! adsr.isActive())
+        {
+            clearCurrentNote();
+            stopStreaming();
+        }
+    }
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct StreamingSamplerTests  : public UnitTest
+{
+    StreamingSamplerTests()
+        : UnitTest ("StreamingSampler", UnitTestCategories::audio)
+    {}
+
+    static AudioFormatReader* createReader (const MemoryBlock& wavData)
+    {
+        return WavAudioFormat().createReaderFor (new MemoryInputStream (wavData, false), true);
+    }
+
+    // The streamer has no thread, so it's driven from here before each block is rendered,
+    // starting once numSamplesBeforeStreaming samples have been played.
+    static AudioBuffer<float> renderNote (Synthesiser& synth, int note, int numSamples,
+                                          SamplerDiskStreamer* streamer = nullptr,
+                                          int numSamplesBeforeStreaming = 0)
+    {
+        AudioBuffer<float> output (2, numSamples);
+        output.clear();
+
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn (1, note, 0.8f), 0);
+        midi.addEvent (MidiMessage::noteOff (1, note), numSamples / 2);
+
+        for (int pos = 0; pos < numSamples; pos += 512)
+        {
+            auto num = jmin (512, numSamples - pos);
+            MidiBuffer blockMidi;
+            blockMidi.addEvents (midi, pos, num, -pos);
+
+            if (streamer != nullptr && pos >= numSamplesBeforeStreaming)
+                while (streamer->serviceMostUrgentVoice())
+                {}
+
+            synth.renderNextBlock (output, blockMidi, pos, num);
+        }
+
+        return output;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Matches an in-memory sampler");
+
+        const double sampleRate = 44100.0;
+        const int sampleLength = 40000;
+
+        MemoryBlock wavData;
+
+        {
+            AudioBuffer<float> sample (2, sampleLength);
+            auto rng = getRandom();
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < sampleLength; ++i)
+                    sample.setSample (ch, i, rng.nextFloat() * 2.0f - 1.0f);
+
+            std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (new MemoryOutputStream (wavData, false),
+                                                                                         sampleRate, 2, 24, {}, 0));
+            writer->writeFromAudioSampleBuffer (sample, 0, sampleLength);
+        }
+
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+
+        Synthesiser memorySynth;
+        memorySynth.setCurrentPlaybackSampleRate (sampleRate);
+        memorySynth.addVoice (new SamplerVoice());
+
+        {
+            std::unique_ptr<AudioFormatReader> reader (createReader (wavData));
+            memorySynth.addSound (new SamplerSound ("test", *reader, notes, 60, 0.01, 0.1, 10.0));
+        }
+
+        SamplerDiskStreamer streamer (2048, false);
+        auto* voice = new StreamingSamplerVoice (streamer, 8192);
+
+        {
+            Synthesiser streamingSynth;
+            streamingSynth.setCurrentPlaybackSampleRate (sampleRate);
+            streamingSynth.addVoice (voice);
+            streamingSynth.addSound (new StreamingSamplerSound ("test", createReader (wavData), notes, 60, 0.01, 0.1, 10.0, 0.05));
+
+            for (auto note : { 60, 67, 53 })
+            {
+                auto expected = renderNote (memorySynth, note, 44100);
+                auto actual   = renderNote (streamingSynth, note, 44100, &streamer);
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < expected.getNumSamples(); ++i)
+                        expectWithinAbsoluteError (actual.getSample (ch, i), expected.getSample (ch, i), 1.0e-6f);
+            }
+
+            expectEquals (voice->getNumUnderruns(), 0);
+            expectEquals (streamer.getNumUnderruns(), 0);
+
+            beginTest ("Stays in time after an underrun");
+
+            // The preload head lasts for 2205 samples, and nothing more arrives until 4096
+            auto expected = renderNote (memorySynth, 60, 20000);
+            auto actual   = renderNote (streamingSynth, 60, 20000, &streamer, 4096);
+
+            expect (voice->getNumUnderruns() > 0);
+            expect (streamer.getNumUnderruns() > 0);
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < expected.getNumSamples(); ++i)
+                {
+                    if (i < 2200 || i >= 4096)
+                        expectWithinAbsoluteError (actual.getSample (ch, i), expected.getSample (ch, i), 1.0e-6f);
+                    else if (i >= 2206)
+                        expectEquals (actual.getSample (ch, i), 0.0f);
+                }
+            }
+        }
+    }
+};
+
+static StreamingSamplerTests streamingSamplerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class StreamingSamplerVoice;
+
+//==============================================================================
+/**
+    A shared background thread which streams sample data from disk for a set of
+    StreamingSamplerVoice objects.
+
+    Each voice registers itself with one of these when it's created. The thread
+    repeatedly picks the voice that is closest to running out of buffered audio -
+    taking into account its playback speed and whether its key is still held down,
+    so that notes which are releasing are serviced after sustaining ones - and
+    reads the next chunk of its sample into the voice's ring buffer.
+
+    If a voice does run out of data, it plays silence until the stream catches up,
+    and the underrun is counted so that you can detect when the disk can't keep up.
+    The voice keeps moving through its sample and envelope while it's silent, so it
+    stays in time with the other voices.
+
+    @see StreamingSamplerSound, StreamingSamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  SamplerDiskStreamer  : private Thread
+{
+public:
+    //==============================================================================
+    /** Creates the streamer.
+        @param chunkSize            the maximum number of samples that will be read from a
+                                    sample's reader in one go
+        @param useBackgroundThread  if true, a background thread is started to read the data.
+                                    If false, you'll need to call serviceMostUrgentVoice()
+                                    yourself, e.g. before rendering each block when rendering
+                                    offline, where the output mustn't depend on timing
+    */
+    explicit SamplerDiskStreamer (int chunkSize = 16384, bool useBackgroundThread = true);
+
+    /** Destructor.
+        Any voices that use this streamer must be deleted before it is.
+    */
+    ~SamplerDiskStreamer() override;
+
+    //==============================================================================
+    /** Returns the total number of times a voice has run out of streamed data since
+        the streamer was created, or since resetUnderrunCount() was last called.
+    */
+    int getNumUnderruns() const noexcept            { return numUnderruns.load(); }
+
+    /** Resets the counter returned by getNumUnderruns(). */
+    void resetUnderrunCount() noexcept              { numUnderruns = 0; }
+
+    //==============================================================================
+    /** Reads the next chunk of data for the voice that's closest to running out.
+
+        The background thread calls this repeatedly, but if the streamer was created
+        without one, you can call it until it returns false to fill all the voices'
+        buffers. Don't call it while the background thread is running.
+
+        @returns false if none of the voices needed any more data
+    */
+    bool serviceMostUrgentVoice();
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    CriticalSection voiceLock;
+    Array<StreamingSamplerVoice*> voices;
+    AudioBuffer<float> readBuffer;
+    std::atomic<int> numUnderruns { 0 };
+
+    void addVoice (StreamingSamplerVoice*);
+    void removeVoice (StreamingSamplerVoice*);
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerDiskStreamer)
+};
+
+//==============================================================================
+/**
+    A SynthesiserSound that plays a sample which is streamed from disk.
+
+    Only the first part of the sample (the "preload head") is loaded into memory
+    when the sound is created, which lets a note start instantly. The rest of it
+    is read from the AudioFormatReader by a SamplerDiskStreamer while the note is
+    playing, so very large sample sets can be used without having to fit into RAM.
+
+    The preload head needs to be long enough to cover the time it takes for the
+    streamer to get the first chunk from disk, at the fastest rate the sample will
+    be played back.
+
+    @see StreamingSamplerVoice, SamplerDiskStreamer, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streaming sound from an audio reader.
+
+        @param name         a name for the sample
+        @param source       the audio to play. This object takes ownership of the reader,
+                            which must remain readable for as long as the sound exists
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param maxSampleLengthSeconds   a maximum length of audio to play from the audio
+                                        source, in seconds
+        @param preloadTimeSecs  the length of the part of the sample that is kept in memory,
+                                in seconds
+    */
+    StreamingSamplerSound (const String& name,
+                           AudioFormatReader* source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double maxSampleLengthSeconds,
+                           double preloadTimeSecs = 0.5);
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the number of samples that will be played. */
+    int getLengthInSamples() const noexcept                 { return length; }
+
+    /** Returns the number of samples at the start of the sound which are held in memory. */
+    int getPreloadLength() const noexcept                   { return preloadLength; }
+
+    //==============================================================================
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    AudioBuffer<float> preloadBuffer;
+    double sourceSampleRate;
+    BigInteger midiNotes;
+    int length = 0, preloadLength = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    // The stream covers the same padding samples past the end that SamplerSound loads
+    int getStreamEnd() const noexcept                       { return length > 0 ? length + 4 : 0; }
+    void readFromSource (AudioBuffer<float>&, int numSamples, int64 startSample);
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+//==============================================================================
+/**
+    A SynthesiserVoice that can play a StreamingSamplerSound.
+
+    Each voice has its own ring buffer, which its SamplerDiskStreamer fills with the
+    part of the sample that follows the preload head while the voice is playing
+    from the head.
+
+    @see StreamingSamplerSound, SamplerDiskStreamer, SamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice
+{
+public:
+    //==============================================================================
+    /** Creates a voice which will use the given streamer to fetch its audio.
+
+        @param streamer         the streamer which will read the samples. This must not be
+                                deleted before the voice
+        @param bufferSize       the size of the voice's ring buffer, in samples
+    */
+    explicit StreamingSamplerVoice (SamplerDiskStreamer& streamer, int bufferSize = 32768);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    /** Returns the number of times this voice has run out of streamed data. */
+    int getNumUnderruns() const noexcept                    { return numUnderruns.load(); }
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    //==============================================================================
+    friend class SamplerDiskStreamer;
+
+    SamplerDiskStreamer& streamer;
+
+    // Rendering state, only used on the audio thread
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0;
+    int64 ringBufferStart = 0;
+
+    ADSR adsr;
+
+    // The ring buffer is written by the streamer's thread and read by the audio thread.
+    // The lock only guards the stream request and resetting the fifo, and is never held
+    // while the streamer reads from disk or copies data into the ring buffer.
+    AudioBuffer<float> ringBuffer;
+    AbstractFifo fifo;
+    SpinLock streamLock;
+    SynthesiserSound::Ptr streamSound;
+    int64 streamPosition = 0;
+    uint32 streamGeneration = 0;
+
+    std::atomic<int64> playPosition { 0 };
+    std::atomic<float> streamRate { 1.0f }, streamPriority { 1.0f };
+    std::atomic<int> numUnderruns { 0 };
+
+    void startStreaming (StreamingSamplerSound&);
+    void stopStreaming();
+    bool getStreamingUrgency (double& urgency, int minChunkSize);
+    bool readNextChunk (AudioBuffer<float>& buffer);
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+} // namespace juce
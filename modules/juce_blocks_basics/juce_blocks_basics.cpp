@@ -42,3 +42,7 @@ namespace juce
 #include "topology/juce_RuleBasedTopologySource.cpp"
 #include "visualisers/juce_DrumPadLEDProgram.cpp"
 #include "visualisers/juce_BitmapLEDProgram.cpp"
+
+#if JUCE_UNIT_TESTS
+ #include "littlefoot/juce_LittleFootRunner_test.cpp"
+#endif
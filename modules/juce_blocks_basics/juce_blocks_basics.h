@@ -81,5 +81,6 @@ namespace juce
 namespace juce
 {
  #include "littlefoot/juce_LittleFootRunner.h"
+ #include "littlefoot/juce_LittleFootBatchRunner.h"
  #include "littlefoot/juce_LittleFootCompiler.h"
 }
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace littlefoot
+{
+
+//==============================================================================
+/**
+    A call to one of a program's functions, which has been recorded so that it can
+    be replayed later, e.g. a touch event or a message sent by the host.
+
+    @see BatchRunner
+
+    @tags{Blocks}
+*/
+struct RecordedCall
+{
+    RecordedCall() = default;
+
+    /** Creates a call to the function with the given signature, using the same
+        format as a NativeFunction, e.g. "touchStart/viffff".
+        The arguments must be int32 or float values.
+    */
+    template <typename... Args>
+    RecordedCall (const char* functionSignature, Args... arguments) noexcept
+        : function (NativeFunction::createID (functionSignature))
+    {
+        static_assert (sizeof... (arguments) <= maxNumArgs, "Too many arguments");
+        addArguments (arguments...);
+    }
+
+    static constexpr int maxNumArgs = 8;
+
+    FunctionID function = 0;        /**< The ID of the function to call. */
+    int numArgs = 0;                /**< The number of values in args. */
+    int32 args[maxNumArgs] = {};    /**< The arguments, with any floats converted by Program::floatToInt(). */
+
+private:
+    void addArguments() noexcept {}
+
+    template <typename... Args>
+    void addArguments (int32 arg, Args... rest) noexcept    { args[numArgs++] = arg; addArguments (rest...); }
+
+    template <typename... Args>
+    void addArguments (float arg, Args... rest) noexcept    { args[numArgs++] = Program::floatToInt (arg); addArguments (rest...); }
+};
+
+//==============================================================================
+/**
+    Replays sequences of recorded function calls on a set of Runners, spreading the
+    work across the threads of a ThreadPool.
+
+    This is intended for simulating and testing many instances of a program on the
+    host, e.g. running each of them against some recorded touch data. Each instance
+    needs its own Runner, which must already have its program and native functions
+    loaded, and which must be different from all the others, as several instances
+    will run at the same time. Native functions will be called on the pool's threads.
+
+    @code
+    BatchRunner<Runner<8192, 8192>> batch;
+
+    for (auto& r : runners)
+        batch.addInstance (*r, touchData.begin(), touchData.size());
+
+    auto results = batch.run (threadPool, 100000);
+    @endcode
+
+    @tags{Blocks}
+*/
+template <typename RunnerType>
+struct BatchRunner
+{
+    BatchRunner() = default;
+
+    using ErrorCode = typename RunnerType::ErrorCode;
+
+    /** The outcome of running one instance's calls. */
+    struct InstanceResult
+    {
+        ErrorCode error = ErrorCode::ok;    /**< The error returned by the call that failed, or ok if none did. */
+        int numCallsCompleted = 0;          /**< The number of calls that finished successfully. */
+    };
+
+    /** Adds an instance to the batch.
+        The runner and the array of calls must stay valid until run() has returned.
+    */
+    void addInstance (RunnerType& runner, const RecordedCall* calls, int numCalls)
+    {
+        jassert (numCalls == 0 || calls != nullptr);
+        instances.add ({ &runner, calls, numCalls });
+    }
+
+    /** Returns the number of instances that have been added. */
+    int getNumInstances() const noexcept        { return instances.size(); }
+
+    /** Removes all the instances. */
+    void clear()                                { instances.clear(); }
+
+    /** Runs each instance's calls in order, and returns a result for each instance.
+
+        Calls to functions that a program doesn't contain are skipped, as they would be
+        on a device. An instance stops at the first call that fails, including any call
+        that performs more than maxInstructionsPerCall instructions (as long as that's
+        greater than 0), and an instance whose runner doesn't have a valid program fails
+        with ErrorCode::unknownFunction.
+
+        The calling thread helps to run the instances, and this doesn't return until
+        they've all finished.
+    */
+    Array<InstanceResult> run (ThreadPool& pool, int maxInstructionsPerCall = 0)
+    {
+        Array<InstanceResult> results;
+        results.resize (instances.size());
+
+        std::atomic<int> nextInstance { 0 }, numJobsRunning { 0 };
+        WaitableEvent jobsFinished;
+
+        auto runInstances = [&]
+        {
+            for (;;)
+            {
+                auto index = nextInstance++;
+
+                if (index >= instances.size())
+                    break;
+
+                results.getReference (index) = runInstance (instances.getReference (index), maxInstructionsPerCall);
+            }
+        };
+
+        auto numJobs = jlimit (0, pool.getNumThreads(), instances.size() - 1);
+        numJobsRunning = numJobs;
+
+        for (int i = 0; i < numJobs; ++i)
+        {
+            pool.addJob ([&]
+            {
+                runInstances();
+
+                if (--numJobsRunning == 0)
+                    jobsFinished.signal();
+            });
+        }
+
+        runInstances();
+
+        if (numJobs > 0)
+            jobsFinished.wait();
+
+        return results;
+    }
+
+private:
+    //==============================================================================
+    struct Instance
+    {
+        RunnerType* runner;
+        const RecordedCall* calls;
+        int numCalls;
+    };
+
+    Array<Instance> instances;
+
+    static InstanceResult runInstance (const Instance& instance, int maxInstructionsPerCall)
+    {
+        InstanceResult result;
+
+        // the runner checks for a time-out once every 64 instructions
+        auto maxNumChecks = maxInstructionsPerCall > 0 ? jmax (1, maxInstructionsPerCall / 64) : 0;
+
+        for (int i = 0; i < instance.numCalls; ++i)
+        {
+            auto& call = instance.calls[i];
+            typename RunnerType::FunctionExecutionContext context (*instance.runner, call.function);
+
+            if (! instance.runner->isProgramValid())
+            {
+                result.error = ErrorCode::unknownFunction;
+                break;
+            }
+
+            if (context.isValid())
+            {
+                int numChecks = 0;
+                context.setArgumentArray (call.args, call.numArgs);
+
+                auto error = context.run ([&] { return maxNumChecks > 0 && ++numChecks >= maxNumChecks; });
+
+                if (error != ErrorCode::ok)
+                {
+                    result.error = error;
+                    break;
+                }
+            }
+
+            ++result.numCallsCompleted;
+        }
+
+        return result;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (BatchRunner)
+};
+
+}
@@ -435,6 +435,7 @@ struct Runner
         nativeFunctions = functions;
         numNativeFunctions = numFunctions;
         nativeFunctionCallbackContext = userDataForCallback;
+        threadedCodeNeedsUpdating = true;
     }
 
     /** Returns the number of native functions available. */
@@ -448,6 +449,8 @@ struct Runner
     {
         for (uint32 i = 0; i < sizeof (allMemory); ++i)
             allMemory[i] = 0;
+
+        threadedCodeNeedsUpdating = true;
     }
 
     /** Clears all the non-program data. */
@@ -490,16 +493,43 @@ struct Runner
         }
     }
 
-    /** Calls one of the functions in the program, by its textual signature. */
+    /** Enables or disables threaded-code execution.
+
+        When this is enabled, the first function call after a program has been loaded
+        decodes the bytecode into a table of instructions with their operands already
+        unpacked, and functions are then run by following that table rather than by
+        interpreting the bytecode. Jump targets, global variable indexes and native
+        function lookups are checked once while decoding instead of every time they're
+        executed. The results are identical to the interpreter's, but the table is
+        allocated on the heap, so this is intended for running programs on the host
+        rather than on a device.
+
+        The program must be loaded with setDataByte() so that the runner can tell when
+        it has changed.
+    */
+    void setThreadedCodeEnabled (bool shouldUseThreadedCode) noexcept
+    {
+        useThreadedCode = shouldUseThreadedCode;
+        threadedCodeNeedsUpdating = true;
+    }
+
+    /** Returns true if threaded-code execution has been enabled. */
+    bool isThreadedCodeEnabled() const noexcept         { return useThreadedCode; }
+
+    /** Calls one of the functions in the program, by its textual signature.
+        This never times out, so use a FunctionExecutionContext if you need to limit how long it runs for.
+    */
     ErrorCode callFunction (const char* functionSignature) noexcept
     {
-        return FunctionExecutionContext (*this, functionSignature).run();
+        return FunctionExecutionContext (*this, functionSignature).run ([] { return false; });
     }
 
-    /** Calls one of the functions in the program, by its function ID. */
+    /** Calls one of the functions in the program, by its function ID.
+        This never times out, so use a FunctionExecutionContext if you need to limit how long it runs for.
+    */
     ErrorCode callFunction (FunctionID function) noexcept
     {
-        return FunctionExecutionContext (*this, function).run();
+        return FunctionExecutionContext (*this, function).run ([] { return false; });
     }
 
     /** */
@@ -592,6 +622,24 @@ struct Runner
     /** */
     Program program;
 
+    //==============================================================================
+    struct FunctionExecutionContext;
+
+   #ifndef DOXYGEN
+    /* One instruction of a program that has been decoded for threaded-code execution. */
+    struct ThreadedInstruction
+    {
+        using PerformFunction = const ThreadedInstruction* (*) (FunctionExecutionContext&, const ThreadedInstruction&);
+
+        PerformFunction perform = nullptr;      // returns the next instruction to perform
+        const ThreadedInstruction* target = nullptr;
+        const NativeFunction* nativeFunction = nullptr;
+        int32 operand = 0;
+        uint16 address = 0, nextAddress = 0;
+        OpCode op = OpCode::halt;
+    };
+   #endif
+
     //==============================================================================
     /**
     */
@@ -616,6 +664,9 @@ struct Runner
         {
             if (r.heapStart != nullptr)
             {
+                if (r.threadedCodeNeedsUpdating)
+                    updateThreadedCode (r);
+
                 auto& prog = r.program;
                 auto numFunctions = prog.getNumFunctions();
 
@@ -650,6 +701,17 @@ struct Runner
         template <typename... Args>
         void setArguments (Args... args) noexcept   { pushArguments (args...); push0(); /* (dummy return address) */ }
 
+        /** Sets the arguments from an array of values, where any floats have been
+            converted with Program::floatToInt().
+        */
+        void setArgumentArray (const int32* args, int numArgs) noexcept
+        {
+            for (int i = numArgs; --i >= 0;)
+                push32 (args[i]);
+
+            push0(); // (dummy return address)
+        }
+
         /** */
         template <typename TimeOutCheckFunction>
         ErrorCode run (TimeOutCheckFunction hasTimedOut) noexcept
@@ -660,6 +722,29 @@ struct Runner
             error = ErrorCode::unknownInstruction;
             uint16 opsPerformed = 0;
 
+            if (auto* instruction = getThreadedInstructionAt (programCounter))
+            {
+                // While the threaded code is running, programCounter stays null unless an
+                // instruction stops it, either by setting an error or by jumping somewhere
+                // that the decoded code doesn't cover, which the interpreter then carries on from.
+                programCounter = nullptr;
+                threadedCodeEnd = runner->threadedCode.end() - 1;
+
+                while (auto perform = instruction->perform)
+                {
+                    if ((++opsPerformed & 63) == 0 && hasTimedOut())
+                    {
+                        programCounter = programBase + instruction->address;
+                        return ErrorCode::executionTimedOut;
+                    }
+
+                    instruction = perform (*this, *instruction);
+                }
+
+                if (programCounter == nullptr)
+                    programCounter = programEnd;
+            }
+
             for (;;)
             {
                 if (programCounter >= programEnd)
@@ -693,6 +778,7 @@ struct Runner
         Runner* runner;
         const uint8* programCounter = nullptr;
         const uint8* programEnd;
+        const ThreadedInstruction* threadedCodeEnd = nullptr;
         const uint8* programBase;
         uint8* heapStart;
         int32* stack;
@@ -784,35 +870,272 @@ struct Runner
         void testLE_float() noexcept                { tos = (Program::intToFloat (tos) <= 0.0f); }
         void getHeapByte() noexcept                 { tos = runner->getHeapByte ((uint32) tos); }
         void getHeapInt() noexcept                  { tos = runner->getHeapInt  ((uint32) tos); }
-        void getHeapBits() noexcept                 { if (checkStackUnderflow()) tos = runner->getHeapBits ((uint32) tos, (uint32) *stack++); }
+        void getHeapBits() noexcept                 { if (checkStackUnderflow()) tos = (int32) runner->getHeapBits ((uint32) tos, (uint32) *stack++); }
         void setHeapByte() noexcept                 { if (checkStackUnderflow()) runner->setHeapByte ((uint32) tos, (uint8)  *stack++); drop(); }
         void setHeapInt() noexcept                  { if (checkStackUnderflow()) runner->setHeapInt  ((uint32) tos, (uint32) *stack++); drop(); }
 
         void callNative (FunctionID functionID) noexcept
         {
-            auto numFunctions = runner->numNativeFunctions;
-            auto* functions = runner->nativeFunctions;
+            if (auto* f = runner->findNativeFunction (functionID))
+                return callNativeFunction (*f);
+
+            setError (ErrorCode::unknownFunction);
+        }
 
-            for (int i = 0; i < numFunctions; ++i)
+        void callNativeFunction (const NativeFunction& f) noexcept
+        {
+            if (flushTopToStack())
+            {
+                tos = f.function (runner->nativeFunctionCallbackContext, stack);
+                stack += f.numArgs;
+
+                if (checkStackUnderflow() && f.returnType == Type::void_)
+                    drop();
+            }
+        }
+
+        //==============================================================================
+        const ThreadedInstruction* getThreadedInstructionAt (const uint8* address) const noexcept
+        {
+           #if ! LITTLEFOOT_DEBUG_TRACE
+            auto offset = address - programBase;
+
+            if (offset >= 0 && offset < runner->threadedCodeIndex.size())
             {
-                const auto& f = functions[i];
+                auto index = runner->threadedCodeIndex.getUnchecked ((int) offset);
 
-                if (f.functionID == functionID)
+                if (index != noThreadedInstruction)
+                    return runner->threadedCode.begin() + index;
+            }
+           #else
+            ignoreUnused (address);
+           #endif
+
+            return nullptr;
+        }
+
+        // Called after an instruction has set the program counter, to find out where to carry on.
+        const ThreadedInstruction* resumeThreadedCode() noexcept
+        {
+            if (programCounter < programEnd)
+            {
+                if (auto* next = getThreadedInstructionAt (programCounter))
                 {
-                    if (flushTopToStack())
-                    {
-                        tos = f.function (runner->nativeFunctionCallbackContext, stack);
-                        stack += f.numArgs;
+                    programCounter = nullptr;
+                    return next;
+                }
+            }
 
-                        if (checkStackUnderflow() && f.returnType == Type::void_)
-                            drop();
-                    }
+            return threadedCodeEnd;
+        }
+
+        const ThreadedInstruction* getNextThreadedInstruction (const ThreadedInstruction& i) noexcept
+        {
+            return programCounter == nullptr ? &i + 1 : resumeThreadedCode();
+        }
+
+        // These perform each op using the same functions as the interpreter, so they all behave
+        // identically. The decoder replaces some of them with the faster versions below when it
+        // can check their operands in advance. (The exception is call, which needs to know the
+        // program counter, so always uses threadedCall if its target can't be checked).
+       #define LITTLEFOOT_THREADED_OP(name)         static const ThreadedInstruction* threaded_ ## name (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept  { c.name(); return c.getNextThreadedInstruction (i); }
+       #define LITTLEFOOT_THREADED_OP_INT8(name)    static const ThreadedInstruction* threaded_ ## name (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept  { c.name ((int8) i.operand); return c.getNextThreadedInstruction (i); }
+       #define LITTLEFOOT_THREADED_OP_INT16(name)   static const ThreadedInstruction* threaded_ ## name (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept  { c.name ((int16) i.operand); return c.getNextThreadedInstruction (i); }
+       #define LITTLEFOOT_THREADED_OP_INT32(name)   static const ThreadedInstruction* threaded_ ## name (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept  { c.name (i.operand); return c.getNextThreadedInstruction (i); }
+        LITTLEFOOT_OPCODES (LITTLEFOOT_THREADED_OP, LITTLEFOOT_THREADED_OP_INT8, LITTLEFOOT_THREADED_OP_INT16, LITTLEFOOT_THREADED_OP_INT32)
+       #undef LITTLEFOOT_THREADED_OP
+       #undef LITTLEFOOT_THREADED_OP_INT8
+       #undef LITTLEFOOT_THREADED_OP_INT16
+       #undef LITTLEFOOT_THREADED_OP_INT32
+
+        static const ThreadedInstruction* threadedCall (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept
+        {
+            // call() pushes the program counter as the return address
+            c.programCounter = c.programBase + i.nextAddress;
+            c.call ((int16) i.operand);
+            return c.resumeThreadedCode();
+        }
+
+        static const ThreadedInstruction* threadedUnknownInstruction (FunctionExecutionContext& c, const ThreadedInstruction&) noexcept
+        {
+            c.setError (ErrorCode::unknownInstruction);
+            return c.threadedCodeEnd;
+        }
+
+        static const ThreadedInstruction* threadedJumpToCheckedTarget (FunctionExecutionContext&, const ThreadedInstruction& i) noexcept
+        {
+            return i.target;
+        }
 
+        static const ThreadedInstruction* threadedJumpIfTrueToCheckedTarget (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept
+        {
+            bool v = c.tos;
+            c.drop();
+
+            if (! v)
+                return c.getNextThreadedInstruction (i);
+
+            c.programCounter = nullptr;
+            return i.target;
+        }
+
+        static const ThreadedInstruction* threadedJumpIfFalseToCheckedTarget (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept
+        {
+            bool v = c.tos;
+            c.drop();
+
+            if (v)
+                return c.getNextThreadedInstruction (i);
+
+            c.programCounter = nullptr;
+            return i.target;
+        }
+
+        static const ThreadedInstruction* threadedCallCheckedTarget (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept
+        {
+            if (! c.flushTopToStack())
+                return c.threadedCodeEnd;
+
+            c.tos = (int32) i.nextAddress;
+            return i.target;
+        }
+
+        static const ThreadedInstruction* threadedDupFromCheckedGlobal (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept
+        {
+            if (! c.flushTopToStack())
+                return c.threadedCodeEnd;
+
+            c.tos = c.globals[(uint16) i.operand];
+            return &i + 1;
+        }
+
+        static const ThreadedInstruction* threadedDropToCheckedGlobal (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept
+        {
+            c.globals[(uint16) i.operand] = c.tos;
+            c.drop();
+            return c.getNextThreadedInstruction (i);
+        }
+
+        static const ThreadedInstruction* threadedCallResolvedNative (FunctionExecutionContext& c, const ThreadedInstruction& i) noexcept
+        {
+            c.callNativeFunction (*i.nativeFunction);
+            return c.getNextThreadedInstruction (i);
+        }
+
+        static typename ThreadedInstruction::PerformFunction getThreadedFunction (OpCode op) noexcept
+        {
+            switch (op)
+            {
+               #define LITTLEFOOT_THREADED_OP(name)   case OpCode::name:  return threaded_ ## name;
+                LITTLEFOOT_OPCODES (LITTLEFOOT_THREADED_OP, LITTLEFOOT_THREADED_OP, LITTLEFOOT_THREADED_OP, LITTLEFOOT_THREADED_OP)
+               #undef LITTLEFOOT_THREADED_OP
+
+                case OpCode::endOfOpcodes:
+                default:  return threadedUnknownInstruction;
+            }
+        }
+
+        static constexpr uint16 noThreadedInstruction = 0xffff;
+
+        /*  Decodes the program's code into the runner's threadedCode array, with an
+            index of which instruction starts at each byte address. The code is decoded
+            in a single pass from the end of the function table to the end of the program,
+            which is also the order in which the interpreter would run it. If that doesn't
+            work out (e.g. an operand runs past the end of the program) the arrays are left
+            empty, and everything is left to the interpreter.
+        */
+        static void updateThreadedCode (Runner& r)
+        {
+            r.threadedCodeNeedsUpdating = false;
+            r.threadedCode.clearQuick();
+            r.threadedCodeIndex.clearQuick();
+
+            if (! r.useThreadedCode)
+                return;
+
+            auto& prog = r.program;
+            auto programSize = prog.getProgramSize();
+            auto codeStart = Program::programHeaderSize + prog.getNumFunctions() * (uint32) (sizeof (FunctionID) + sizeof (int16));
+
+            Array<ThreadedInstruction> code;
+            Array<uint16> index;
+            index.insertMultiple (0, (uint16) noThreadedInstruction, (int) programSize);
+
+            for (auto address = codeStart; address < programSize;)
+            {
+                ThreadedInstruction i;
+                i.op = (OpCode) prog.programStart[address];
+                i.address = (uint16) address;
+                i.perform = getThreadedFunction (i.op);
+
+                auto* operand = prog.programStart + address + 1;
+                uint32 numOperandBytes = i.op < OpCode::endOfOpcodes ? Program::getNumExtraBytesForOpcode (i.op) : 0;
+
+                if (address + 1 + numOperandBytes > programSize)
                     return;
+
+                if (numOperandBytes == 1)       i.operand = (int8) *operand;
+                else if (numOperandBytes == 2)  i.operand = Program::readInt16 (operand);
+                else if (numOperandBytes == 4)  i.operand = Program::readInt32 (operand);
+
+                address += 1 + numOperandBytes;
+                i.nextAddress = (uint16) address;
+
+                index.set ((int) i.address, (uint16) code.size());
+                code.add (i);
+            }
+
+            code.add ({}); // the end marker, which has a null perform function
+
+            auto findInstruction = [&] (int32 operand) -> const ThreadedInstruction*
+            {
+                auto targetAddress = (uint16) operand;
+
+                if (targetAddress < programSize)
+                {
+                    auto targetIndex = index.getUnchecked ((int) targetAddress);
+
+                    if (targetIndex != noThreadedInstruction)
+                        return code.begin() + targetIndex;
+                }
+
+                return nullptr;
+            };
+
+            auto numGlobals = prog.getNumGlobals();
+
+            for (auto& i : code)
+            {
+                if (i.op == OpCode::jump || i.op == OpCode::jumpIfTrue
+                     || i.op == OpCode::jumpIfFalse || i.op == OpCode::call)
+                {
+                    if ((i.target = findInstruction (i.operand)) != nullptr)
+                        i.perform = i.op == OpCode::jump        ? threadedJumpToCheckedTarget
+                                  : i.op == OpCode::jumpIfTrue  ? threadedJumpIfTrueToCheckedTarget
+                                  : i.op == OpCode::jumpIfFalse ? threadedJumpIfFalseToCheckedTarget
+                                                                : threadedCallCheckedTarget;
+                    else if (i.op == OpCode::call)
+                        i.perform = threadedCall;
+                }
+                else if (i.op == OpCode::dupFromGlobal)
+                {
+                    if ((uint16) i.operand < numGlobals)
+                        i.perform = threadedDupFromCheckedGlobal;
+                }
+                else if (i.op == OpCode::dropToGlobal)
+                {
+                    if ((uint16) i.operand < numGlobals)
+                        i.perform = threadedDropToCheckedGlobal;
+                }
+                else if (i.op == OpCode::callNative)
+                {
+                    if ((i.nativeFunction = r.findNativeFunction ((FunctionID) i.operand)) != nullptr)
+                        i.perform = threadedCallResolvedNative;
                 }
             }
 
-            setError (ErrorCode::unknownFunction);
+            r.threadedCode.swapWith (code);
+            r.threadedCodeIndex.swapWith (index);
         }
 
         void dumpDebugTrace() const
@@ -841,6 +1164,18 @@ private:
     int32* stackEnd   = nullptr;
     int32* globals    = nullptr;
     uint16 heapSize   = 0;
+    bool useThreadedCode = false, threadedCodeNeedsUpdating = true;
+    Array<ThreadedInstruction> threadedCode;
+    Array<uint16> threadedCodeIndex;
+
+    const NativeFunction* findNativeFunction (FunctionID functionID) const noexcept
+    {
+        for (int i = 0; i < numNativeFunctions; ++i)
+            if (nativeFunctions[i].functionID == functionID)
+                return nativeFunctions + i;
+
+        return nullptr;
+    }
 
     Runner& reinitialiseProgramLayoutIfProgramHasChanged() noexcept
     {
@@ -863,6 +1198,8 @@ private:
                 for (uint32 i = 0; i < numGlobals; ++i)
                     globals[i] = 0; // clear globals
 
+                threadedCodeNeedsUpdating = true;
+
                #if LITTLEFOOT_DUMP_PROGRAM
                 MemoryOutputStream m;
                 program.dumpAllFunctions (m);
@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace LittleFootRunnerTestHelpers
+{
+    using TestRunner = littlefoot::Runner<8192, 4096>;
+    using littlefoot::int32;
+
+    static const char* const testProgram = R"littlefoot(
+        int counter;
+        int pixels[64];
+        float position;
+
+        int fib (int n)
+        {
+            if (n < 2)
+                return n;
+
+            return fib (n - 1) + fib (n - 2);
+        }
+
+        void repaint()
+        {
+            for (int i = 0; i < 64; ++i)
+                pixels[i] = makeARGB (255, (i * 4 + counter) % 256, i, counter & 255);
+
+            for (int i = 0; i < 64; ++i)
+                fillPixel (pixels[i], i % 8, i / 8);
+
+            ++counter;
+        }
+
+        void touchStart (int index, float x, float y, float z, float vz)
+        {
+            position = x * 2.0 + y;
+            setHeapInt (index * 4, int (position * 100.0));
+        }
+
+        void touchMove (int index, float x, float y, float z, float vz)
+        {
+            position = position * 0.5 + x;
+            counter += fib (index + 8) + getHeapInt (index * 4);
+        }
+
+        void touchEnd (int index, float x, float y, float z, float vz)
+        {
+            if (z > 0.5)
+                counter = counter / (index + 1);
+        }
+
+        void spin()
+        {
+            while (true)
+                ++counter;
+        }
+    )littlefoot";
+
+    struct NativeState
+    {
+        int64 total = 0;
+        int numCalls = 0;
+    };
+
+    static int32 makeARGB (void*, const int32* args)
+    {
+        return (args[0] << 24) | ((args[1] & 255) << 16) | ((args[2] & 255) << 8) | (args[3] & 255);
+    }
+
+    static int32 fillPixel (void* context, const int32* args)
+    {
+        auto& state = *static_cast<NativeState*> (context);
+        state.total = state.total * 31 + args[0] + args[1] * 8 + args[2];
+        ++state.numCalls;
+        return 0;
+    }
+
+    static const littlefoot::NativeFunction nativeFunctions[] =
+    {
+        { "makeARGB/iiiii",  makeARGB },
+        { "fillPixel/viii",  fillPixel }
+    };
+
+    static const char* const compilerFunctions[] =
+    {
+        "makeARGB/iiiii",
+        "fillPixel/viii",
+        nullptr
+    };
+
+    static Array<littlefoot::uint8> compileTestProgram()
+    {
+        littlefoot::Compiler compiler;
+        compiler.addNativeFunctions (compilerFunctions);
+        auto result = compiler.compile (testProgram, 64);
+        jassert (result.wasOk());
+        ignoreUnused (result);
+        return compiler.compiledObjectCode;
+    }
+
+    struct Instance
+    {
+        Instance (const Array<littlefoot::uint8>& program, bool useThreadedCode)
+        {
+            runner->setNativeFunctions (nativeFunctions, numElementsInArray (nativeFunctions), &state);
+            runner->setThreadedCodeEnabled (useThreadedCode);
+
+            for (int i = 0; i < program.size(); ++i)
+                runner->setDataByte ((uint32) i, program[i]);
+        }
+
+        bool hasSameStateAs (const Instance& other) const
+        {
+            return state.total == other.state.total
+                && state.numCalls == other.state.numCalls
+                && std::memcmp (runner->allMemory, other.runner->allMemory, sizeof (runner->allMemory)) == 0;
+        }
+
+        std::unique_ptr<TestRunner> runner { new TestRunner() };
+        NativeState state;
+    };
+
+    static Array<littlefoot::RecordedCall> createRecordedCalls (Random& r, int numCalls)
+    {
+        Array<littlefoot::RecordedCall> calls;
+
+        for (int i = 0; i < numCalls; ++i)
+        {
+            auto index = (int32) r.nextInt (3);
+            auto x = r.nextFloat() * 2.0f, y = r.nextFloat() * 2.0f, z = r.nextFloat();
+
+            switch (r.nextInt (6))
+            {
+                case 0:   calls.add ({ "repaint/v" }); break;
+                case 1:   calls.add ({ "touchStart/viffff", index, x, y, z, 0.0f }); break;
+                case 2:   calls.add ({ "touchMove/viffff", index, x, y, z, 0.0f }); break;
+                case 3:   calls.add ({ "touchEnd/viffff", index, x, y, z, 0.0f }); break;
+                case 4:   calls.add ({ "handleMessage/viii", index, index, index }); break;
+                default:  if (r.nextInt (20) == 0) calls.add ({ "spin/v" }); break;
+            }
+        }
+
+        return calls;
+    }
+}
+
+//==============================================================================
+class LittleFootRunnerTests  : public UnitTest
+{
+public:
+    LittleFootRunnerTests()
+        : UnitTest ("LittleFoot Runner", UnitTestCategories::blocks)
+    {}
+
+    void runTest() override
+    {
+        using namespace LittleFootRunnerTestHelpers;
+        using ErrorCode = TestRunner::ErrorCode;
+
+        beginTest ("Threaded code matches the interpreter");
+
+        auto program = compileTestProgram();
+        expect (! program.isEmpty());
+
+        {
+            Instance interpreted (program, false), threaded (program, true);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                expect (interpreted.runner->callFunction ("repaint/v") == ErrorCode::ok);
+                expect (threaded.runner->callFunction ("repaint/v") == ErrorCode::ok);
+                expect (interpreted.hasSameStateAs (threaded));
+            }
+
+            expect (threaded.state.numCalls == 64 * 3);
+
+            Random r (1234);
+
+            for (auto& call : createRecordedCalls (r, 500))
+            {
+                TestRunner::FunctionExecutionContext c1 (*interpreted.runner, call.function);
+                TestRunner::FunctionExecutionContext c2 (*threaded.runner, call.function);
+                expect (c1.isValid() == c2.isValid());
+
+                if (c1.isValid())
+                {
+                    c1.setArgumentArray (call.args, call.numArgs);
+                    c2.setArgumentArray (call.args, call.numArgs);
+
+                    int checks1 = 0, checks2 = 0;
+                    auto e1 = c1.run ([&] { return ++checks1 > 100; });
+                    auto e2 = c2.run ([&] { return ++checks2 > 100; });
+
+                    expect (e1 == e2);
+                    expect (interpreted.hasSameStateAs (threaded));
+                }
+            }
+        }
+
+        beginTest ("Threaded code times out and resumes like the interpreter");
+        {
+            Instance interpreted (program, false), threaded (program, true);
+
+            TestRunner::FunctionExecutionContext c1 (*interpreted.runner, "spin/v");
+            TestRunner::FunctionExecutionContext c2 (*threaded.runner, "spin/v");
+
+            for (int i = 0; i < 3; ++i)
+            {
+                int checks1 = 0, checks2 = 0;
+                expect (c1.run ([&] { return ++checks1 > 10; }) == ErrorCode::executionTimedOut);
+                expect (c2.run ([&] { return ++checks2 > 10; }) == ErrorCode::executionTimedOut);
+                expect (interpreted.hasSameStateAs (threaded));
+            }
+        }
+
+        beginTest ("Threaded code is updated when the program changes");
+        {
+            Instance threaded (program, true);
+            expect (threaded.runner->callFunction ("repaint/v") == ErrorCode::ok);
+
+            littlefoot::Compiler compiler;
+            compiler.addNativeFunctions (compilerFunctions);
+            expect (compiler.compile ("int value; void repaint() { value = 42; fillPixel (value, 0, 0); }", 64).wasOk());
+
+            for (int i = 0; i < compiler.compiledObjectCode.size(); ++i)
+                threaded.runner->setDataByte ((uint32) i, compiler.compiledObjectCode[i]);
+
+            threaded.state = {};
+            expect (threaded.runner->callFunction ("repaint/v") == ErrorCode::ok);
+            expect (threaded.state.numCalls == 1 && threaded.state.total == 42);
+        }
+
+        beginTest ("BatchRunner");
+        {
+            OwnedArray<Instance> batchInstances, sequentialInstances;
+            OwnedArray<Array<littlefoot::RecordedCall>> calls;
+            littlefoot::BatchRunner<TestRunner> batch;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                Random r (i);
+                calls.add (new Array<littlefoot::RecordedCall> (createRecordedCalls (r, 100)));
+                batchInstances.add (new Instance (program, (i & 1) != 0));
+                sequentialInstances.add (new Instance (program, false));
+                batch.addInstance (*batchInstances[i]->runner, calls[i]->begin(), calls[i]->size());
+            }
+
+            ThreadPool pool (3);
+            auto results = batch.run (pool, 100000);
+            expect (results.size() == 16);
+
+            bool anyTimedOut = false;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                littlefoot::BatchRunner<TestRunner> single;
+                single.addInstance (*sequentialInstances[i]->runner, calls[i]->begin(), calls[i]->size());
+                auto expected = single.run (pool, 100000).getFirst();
+
+                expect (results[i].error == expected.error);
+                expect (results[i].numCallsCompleted == expected.numCallsCompleted);
+                expect (batchInstances[i]->hasSameStateAs (*sequentialInstances[i]));
+
+                anyTimedOut = anyTimedOut || results[i].error == ErrorCode::executionTimedOut;
+            }
+
+            // some of the recorded calls to spin() should have been stopped
+            expect (anyTimedOut);
+        }
+    }
+};
+
+static LittleFootRunnerTests littleFootRunnerTests;
+
+//==============================================================================
+class LittleFootRunnerBenchmarks  : public UnitTest
+{
+public:
+    LittleFootRunnerBenchmarks()
+        : UnitTest ("LittleFoot Runner benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        using namespace LittleFootRunnerTestHelpers;
+
+        auto program = compileTestProgram();
+        Random r (4321);
+        auto calls = createRecordedCalls (r, 200);
+
+        calls.removeIf ([] (const littlefoot::RecordedCall& call)
+        {
+            return call.function == littlefoot::NativeFunction::createID ("spin/v");
+        });
+
+        for (auto useThreadedCode : { false, true })
+        {
+            beginTest (useThreadedCode ? "Threaded code" : "Interpreter");
+
+            Instance instance (program, useThreadedCode);
+
+            benchmark ("repaint() x 100", [&]
+            {
+                for (int i = 0; i < 100; ++i)
+                    instance.runner->callFunction ("repaint/v");
+            }, 20, 2);
+
+            benchmark ("200 recorded calls", [&]
+            {
+                littlefoot::BatchRunner<TestRunner> batch;
+                batch.addInstance (*instance.runner, calls.begin(), calls.size());
+
+                ThreadPool pool (1);
+                expect (batch.run (pool).getFirst().numCallsCompleted == calls.size());
+            }, 20, 2);
+        }
+
+        beginTest ("BatchRunner");
+
+        OwnedArray<Instance> instances;
+
+        for (int i = 0; i < 64; ++i)
+            instances.add (new Instance (program, true));
+
+        for (auto numThreads : { 1, jmax (2, SystemStats::getNumCpus()) })
+        {
+            ThreadPool pool (numThreads);
+
+            benchmark ("64 instances x 200 recorded calls, " + String (numThreads) + " thread(s)", [&]
+            {
+                littlefoot::BatchRunner<TestRunner> batch;
+
+                for (auto* instance : instances)
+                    batch.addInstance (*instance->runner, calls.begin(), calls.size());
+
+                for (auto& result : batch.run (pool))
+                    expect (result.error == TestRunner::ErrorCode::ok);
+            }, 10, 1);
+        }
+    }
+};
+
+static LittleFootRunnerBenchmarks littleFootRunnerBenchmarks;
+
+} // namespace juce
@@ -381,6 +381,7 @@ private:
 
 	friend class b2World;
 	friend class b2Island;
+	friend class b2ParallelIslandSolver;
 	friend class b2ContactManager;
 	friend class b2ContactSolver;
 	friend class b2Contact;
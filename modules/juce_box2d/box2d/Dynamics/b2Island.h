@@ -27,6 +27,7 @@ class b2Contact;
 class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
+struct b2ContactImpulse;
 struct b2ContactVelocityConstraint;
 struct b2Profile;
 
@@ -36,6 +37,17 @@ class b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+
+	/// This is used by b2ParallelIslandSolver. The island uses the given arrays rather than
+	/// allocating its own, and the bodies must already have island indices that refer to the
+	/// positions and velocities. Static bodies may be in several islands, so they're left for
+	/// the caller to update, and the contact impulses are stored rather than reported.
+	b2Island(b2Body** bodies, int32 bodyCount,
+			b2Contact** contacts, int32 contactCount,
+			b2Joint** joints, int32 jointCount,
+			b2Position* positions, b2Velocity* velocities,
+			b2ContactImpulse* impulses, b2StackAllocator* allocator);
+
 	~b2Island();
 
 	void Clear()
@@ -88,6 +100,10 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	b2ContactImpulse* m_impulses;
+	bool m_sharesStaticBodies;
+	bool m_fellAsleep;
 };
 
 #endif
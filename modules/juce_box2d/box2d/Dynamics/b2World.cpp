@@ -34,6 +34,224 @@
 #include "../Common/b2Timer.h"
 #include <new>
 
+/// This is an internal class, which b2World uses to solve its islands on the threads
+/// of a juce::ThreadPool.
+/// Islands aren't joined together by static bodies, so a static body can be in many
+/// islands. Each static body gets a slot at the start of every island's positions and
+/// velocities, so that it has the same island index in all of them, and the things that
+/// b2Island would write to a static body are done afterwards, one island at a time.
+/// That means the islands can be solved in any order, and the results don't depend on
+/// the number of threads.
+class b2ParallelIslandSolver
+{
+public:
+	/// Record an island that has been built by b2World::Solve.
+	void Add(const b2Island& island)
+	{
+		b2IslandRange range;
+		range.bodyStart = m_bodies.size();
+		range.bodyCount = island.m_bodyCount;
+		range.contactStart = m_contacts.size();
+		range.contactCount = island.m_contactCount;
+		range.jointStart = m_joints.size();
+		range.jointCount = island.m_jointCount;
+		range.fellAsleep = false;
+		memset(&range.profile, 0, sizeof(b2Profile));
+
+		m_bodies.addArray(island.m_bodies, island.m_bodyCount);
+		m_contacts.addArray(island.m_contacts, island.m_contactCount);
+		m_joints.addArray(island.m_joints, island.m_jointCount);
+		m_islands.add(range);
+	}
+
+	/// Solve all the recorded islands, then clear them.
+	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep,
+			   b2ContactListener* listener, juce::ThreadPool& pool)
+	{
+		// Give each static body a slot, followed by a slot for each body in the island.
+		for (b2Body* b : m_bodies)
+		{
+			if (b->GetType() == b2_staticBody)
+			{
+				b->m_islandIndex = -1;
+			}
+		}
+
+		int32 staticBodyCount = 0;
+
+		for (b2Body* b : m_bodies)
+		{
+			if (b->GetType() == b2_staticBody && b->m_islandIndex < 0)
+			{
+				b->m_islandIndex = staticBodyCount++;
+			}
+		}
+
+		int32 maxBodyCount = 0;
+
+		for (const b2IslandRange& range : m_islands)
+		{
+			for (int32 i = 0; i < range.bodyCount; ++i)
+			{
+				b2Body* b = m_bodies.getUnchecked(range.bodyStart + i);
+				if (b->GetType() != b2_staticBody)
+				{
+					b->m_islandIndex = staticBodyCount + i;
+				}
+			}
+
+			maxBodyCount = b2Max(maxBodyCount, range.bodyCount);
+		}
+
+		if (listener != NULL)
+		{
+			m_impulses.resize(m_contacts.size());
+		}
+
+		// The calling thread solves islands too, and small islands aren't worth waking a
+		// thread for, so this only uses as many jobs as there's enough work to share.
+		const int32 minBodiesPerJob = 64;
+		int32 jobCount = juce::jmin(pool.getNumThreads(), m_islands.size() - 1, m_bodies.size() / minBodiesPerJob - 1);
+		jobCount = juce::jmax(0, jobCount);
+
+		while (m_lanes.size() <= jobCount)
+		{
+			m_lanes.add(new b2SolverLane());
+		}
+
+		for (int32 i = 0; i <= jobCount; ++i)
+		{
+			m_lanes.getUnchecked(i)->SetCapacity(staticBodyCount + maxBodyCount);
+		}
+
+		std::atomic<int32> nextIsland { 0 }, jobsRunning { jobCount };
+		juce::WaitableEvent jobsFinished;
+
+		auto solveIslands = [&](b2SolverLane& lane)
+		{
+			for (;;)
+			{
+				int32 index = nextIsland++;
+				if (index >= m_islands.size())
+				{
+					break;
+				}
+
+				SolveIsland(m_islands.getReference(index), lane, step, gravity, allowSleep, listener != NULL);
+			}
+		};
+
+		for (int32 i = 0; i < jobCount; ++i)
+		{
+			b2SolverLane* lane = m_lanes.getUnchecked(i + 1);
+
+			pool.addJob([&, lane]
+			{
+				solveIslands(*lane);
+
+				if (--jobsRunning == 0)
+				{
+					jobsFinished.signal();
+				}
+			});
+		}
+
+		solveIslands(*m_lanes.getUnchecked(0));
+
+		if (jobCount > 0)
+		{
+			jobsFinished.wait();
+		}
+
+		// Finish off the static bodies and report the impulses in the same order as
+		// b2World would if it solved each island as soon as it found it.
+		for (const b2IslandRange& range : m_islands)
+		{
+			profile->solveInit += range.profile.solveInit;
+			profile->solveVelocity += range.profile.solveVelocity;
+			profile->solvePosition += range.profile.solvePosition;
+
+			for (int32 i = 0; i < range.bodyCount; ++i)
+			{
+				b2Body* b = m_bodies.getUnchecked(range.bodyStart + i);
+				if (b->GetType() != b2_staticBody)
+				{
+					continue;
+				}
+
+				b->m_sweep.c0 = b->m_sweep.c;
+				b->m_sweep.a0 = b->m_sweep.a;
+				b->SynchronizeTransform();
+				b->SetAwake(range.fellAsleep == false);
+			}
+
+			if (listener != NULL)
+			{
+				for (int32 i = 0; i < range.contactCount; ++i)
+				{
+					listener->PostSolve(m_contacts.getUnchecked(range.contactStart + i),
+										&m_impulses.getReference(range.contactStart + i));
+				}
+			}
+		}
+
+		m_bodies.clearQuick();
+		m_contacts.clearQuick();
+		m_joints.clearQuick();
+		m_islands.clearQuick();
+	}
+
+private:
+	struct b2IslandRange
+	{
+		int32 bodyStart, bodyCount;
+		int32 contactStart, contactCount;
+		int32 jointStart, jointCount;
+		b2Profile profile;
+		bool fellAsleep;
+	};
+
+	// The memory used by one of the threads solving the islands.
+	struct b2SolverLane
+	{
+		void SetCapacity(int32 bodyCount)
+		{
+			if (bodyCount > m_capacity)
+			{
+				m_positions.malloc((size_t) bodyCount);
+				m_velocities.malloc((size_t) bodyCount);
+				m_capacity = bodyCount;
+			}
+		}
+
+		b2StackAllocator m_allocator;
+		juce::HeapBlock<b2Position> m_positions;
+		juce::HeapBlock<b2Velocity> m_velocities;
+		int32 m_capacity = 0;
+	};
+
+	void SolveIsland(b2IslandRange& range, b2SolverLane& lane, const b2TimeStep& step,
+					 const b2Vec2& gravity, bool allowSleep, bool storeImpulses)
+	{
+		b2Island island(m_bodies.getRawDataPointer() + range.bodyStart, range.bodyCount,
+						m_contacts.getRawDataPointer() + range.contactStart, range.contactCount,
+						m_joints.getRawDataPointer() + range.jointStart, range.jointCount,
+						lane.m_positions, lane.m_velocities,
+						storeImpulses ? m_impulses.getRawDataPointer() + range.contactStart : NULL,
+						&lane.m_allocator);
+
+		island.Solve(&range.profile, step, gravity, allowSleep);
+		range.fellAsleep = island.m_fellAsleep;
+	}
+
+	juce::Array<b2Body*> m_bodies;
+	juce::Array<b2Contact*> m_contacts;
+	juce::Array<b2Joint*> m_joints;
+	juce::Array<b2IslandRange> m_islands;
+	juce::Array<b2ContactImpulse> m_impulses;
+	juce::OwnedArray<b2SolverLane> m_lanes;
+};
+
 b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = NULL;
@@ -61,6 +279,9 @@ b2World::b2World(const b2Vec2& gravity)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+
+	m_threadPool = NULL;
+	m_parallelSolver = NULL;
 }
 
 b2World::~b2World()
@@ -82,6 +303,8 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	delete m_parallelSolver;
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -396,6 +619,13 @@ void b2World::Solve(const b2TimeStep& step)
 					&m_stackAllocator,
 					m_contactManager.m_contactListener);
 
+	// With a thread pool, the islands are all found first and then solved together.
+	bool solveInParallel = m_threadPool != NULL && m_threadPool->getNumThreads() > 0;
+	if (solveInParallel && m_parallelSolver == NULL)
+	{
+		m_parallelSolver = new b2ParallelIslandSolver();
+	}
+
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
@@ -527,11 +757,18 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		if (solveInParallel)
+		{
+			m_parallelSolver->Add(island);
+		}
+		else
+		{
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+		}
 
 		// Post solve cleanup.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
@@ -547,6 +784,12 @@ void b2World::Solve(const b2TimeStep& step)
 
 	m_stackAllocator.Free(stack);
 
+	if (solveInParallel)
+	{
+		m_parallelSolver->Solve(&m_profile, step, m_gravity, m_allowSleep,
+								m_contactManager.m_contactListener, *m_threadPool);
+	}
+
 	{
 		b2Timer timer;
 		// Synchronize fixtures, check for out of range bodies.
@@ -34,6 +34,7 @@ class b2Body;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
+class b2ParallelIslandSolver;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -157,6 +158,15 @@ public:
 	void SetSubStepping(bool flag) { m_subStepping = flag; }
 	bool GetSubStepping() const { return m_subStepping; }
 
+	/// Solve independent islands on the threads of a pool, with the calling thread
+	/// helping. The results are exactly the same as solving them on the calling thread,
+	/// whatever the number of threads, but b2ContactListener::PostSolve is called after
+	/// all the islands have been solved. The pool is owned by you and must remain in
+	/// scope, and you mustn't step the world on one of its threads. Pass NULL to solve
+	/// everything on the calling thread, which is the default.
+	void SetThreadPool(juce::ThreadPool* pool) { m_threadPool = pool; }
+	juce::ThreadPool* GetThreadPool() const { return m_threadPool; }
+
 	/// Get the number of broad-phase proxies.
 	juce::int32 GetProxyCount() const;
 
@@ -256,6 +266,9 @@ private:
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+
+	juce::ThreadPool* m_threadPool;
+	b2ParallelIslandSolver* m_parallelSolver;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -43,6 +43,61 @@ void Box2DRenderer::render (Graphics& g, b2World& world,
 
     world.SetDebugDraw (this);
     world.DrawDebugData();
+
+    if (batchingEnabled)
+        drawBatches();
+}
+
+void Box2DRenderer::setBatchingEnabled (bool shouldBatchShapes) noexcept
+{
+    batchingEnabled = shouldBatchShapes;
+}
+
+Box2DRenderer::Batch& Box2DRenderer::getBatch (const b2Color& c)
+{
+    auto colour = getColour (c);
+
+    for (int i = 0; i < numBatchesUsed; ++i)
+        if (batches.getUnchecked (i)->colour == colour)
+            return *batches.getUnchecked (i);
+
+    if (numBatchesUsed == batches.size())
+        batches.add (new Batch());
+
+    auto& batch = *batches.getUnchecked (numBatchesUsed++);
+    batch.colour = colour;
+    return batch;
+}
+
+void Box2DRenderer::drawBatches()
+{
+    // Shapes of the same kind all wind the same way, so they can share a path,
+    // but the kinds are kept apart so that overlapping shapes don't cancel out.
+    PathStrokeType stroke (getLineThickness());
+
+    for (int i = 0; i < numBatchesUsed; ++i)
+    {
+        auto& batch = *batches.getUnchecked (i);
+        graphics->setColour (batch.colour);
+
+        for (auto* p : { &batch.solidPolygons, &batch.solidCircles, &batch.segments })
+        {
+            if (! p->isEmpty())
+                graphics->fillPath (*p);
+
+            p->clear();
+        }
+
+        for (auto* p : { &batch.polygonOutlines, &batch.circleOutlines })
+        {
+            if (! p->isEmpty())
+                graphics->strokePath (*p, stroke);
+
+            p->clear();
+        }
+    }
+
+    numBatchesUsed = 0;
 }
 
 Colour Box2DRenderer::getColour (const b2Color& c) const
@@ -67,6 +122,12 @@ static void createPath (Path& p, const b2Vec2* vertices, int32 vertexCount)
 
 void Box2DRenderer::DrawPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        createPath (getBatch (color).polygonOutlines, vertices, vertexCount);
+        return;
+    }
+
     graphics->setColour (getColour (color));
 
     Path p;
@@ -76,6 +137,12 @@ void Box2DRenderer::DrawPolygon (const b2Vec2* vertices, int32 vertexCount, cons
 
 void Box2DRenderer::DrawSolidPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        createPath (getBatch (color).solidPolygons, vertices, vertexCount);
+        return;
+    }
+
     graphics->setColour (getColour (color));
 
     Path p;
@@ -85,6 +152,13 @@ void Box2DRenderer::DrawSolidPolygon (const b2Vec2* vertices, int32 vertexCount,
 
 void Box2DRenderer::DrawCircle (const b2Vec2& center, float32 radius, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        getBatch (color).circleOutlines.addEllipse (center.x - radius, center.y - radius,
+                                                    radius * 2.0f, radius * 2.0f);
+        return;
+    }
+
     graphics->setColour (getColour (color));
     graphics->drawEllipse (center.x - radius, center.y - radius,
                            radius * 2.0f, radius * 2.0f,
@@ -93,6 +167,13 @@ void Box2DRenderer::DrawCircle (const b2Vec2& center, float32 radius, const b2Co
 
 void Box2DRenderer::DrawSolidCircle (const b2Vec2& center, float32 radius, const b2Vec2& /*axis*/, const b2Color& colour)
 {
+    if (batchingEnabled)
+    {
+        getBatch (colour).solidCircles.addEllipse (center.x - radius, center.y - radius,
+                                                   radius * 2.0f, radius * 2.0f);
+        return;
+    }
+
     graphics->setColour (getColour (colour));
     graphics->fillEllipse (center.x - radius, center.y - radius,
                            radius * 2.0f, radius * 2.0f);
@@ -100,6 +181,12 @@ void Box2DRenderer::DrawSolidCircle (const b2Vec2& center, float32 radius, const
 
 void Box2DRenderer::DrawSegment (const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
 {
+    if (batchingEnabled)
+    {
+        getBatch (color).segments.addLineSegment ({ p1.x, p1.y, p2.x, p2.y }, getLineThickness());
+        return;
+    }
+
     graphics->setColour (getColour (color));
     graphics->drawLine (p1.x, p1.y, p2.x, p2.y, getLineThickness());
 }
@@ -32,6 +32,8 @@ namespace juce
     To use it, simply create an instance of this class in your paint() method,
     and call its render() method.
 
+    For worlds with a lot of bodies, see setBatchingEnabled().
+
     @tags{Box2D}
 */
 class Box2DRenderer   : public b2Draw
@@ -57,6 +59,23 @@ public:
                  float box2DWorldRight, float box2DWorldBottom,
                  const Rectangle<float>& targetArea);
 
+    /** Enables or disables batched drawing.
+
+        Normally each shape is drawn as soon as the world asks for it. When batching
+        is enabled, the shapes are collected into one path for each colour, and the
+        paths are drawn once the whole world has been rendered. This is much faster
+        when there are a lot of bodies, but shapes that overlap shapes of a different
+        colour may be drawn in a different order.
+
+        By default, batching is disabled.
+    */
+    void setBatchingEnabled (bool shouldBatchShapes) noexcept;
+
+    /** Returns true if batched drawing is enabled.
+        @see setBatchingEnabled
+    */
+    bool isBatchingEnabled() const noexcept         { return batchingEnabled; }
+
     // b2Draw methods:
     void DrawPolygon (const b2Vec2*, int32, const b2Color&) override;
     void DrawSolidPolygon (const b2Vec2*, int32, const b2Color&) override;
@@ -73,6 +92,20 @@ public:
 protected:
     Graphics* graphics;
 
+private:
+    struct Batch
+    {
+        Colour colour;
+        Path solidPolygons, solidCircles, polygonOutlines, circleOutlines, segments;
+    };
+
+    Batch& getBatch (const b2Color&);
+    void drawBatches();
+
+    OwnedArray<Batch> batches;
+    int numBatchesUsed = 0;
+    bool batchingEnabled = false;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DRenderer)
 };
 
@@ -275,4 +275,60 @@ template <> String HashMapTest::RandomKeys<String>::generateRandomKey (Random& r
 
 static HashMapTest hashMapTest;
 
+//==============================================================================
+struct HashMapBenchmarks : public UnitTest
+{
+    HashMapBenchmarks()
+        : UnitTest ("HashMap benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        run<int> ("int keys", 10000);
+        run<String> ("String keys", 10000);
+    }
+
+    template <typename KeyType>
+    void run (const String& testName, int numKeys)
+    {
+        HashMapTest::RandomKeys<KeyType> keyOracle (numKeys, 1234);
+        Array<KeyType> keys;
+
+        for (int i = 0; i < numKeys; ++i)
+            keys.add (keyOracle.next());
+
+        beginTest (testName);
+
+        HashMap<KeyType, int> map;
+        benchmark ("Insert " + String (numKeys), [&]
+        {
+            map.clear();
+
+            for (int i = 0; i < numKeys; ++i)
+                map.set (keys.getReference (i), i);
+        }, 20, 2);
+
+        int64 total = 0;
+        benchmark ("Look up " + String (numKeys), [&]
+        {
+            for (int i = 0; i < numKeys; ++i)
+                total += map[keys.getReference (i)];
+        }, 20, 2);
+
+        benchmark ("Insert and remove " + String (numKeys), [&]
+        {
+            for (int i = 0; i < numKeys; ++i)
+                map.set (keys.getReference (i), i);
+
+            for (int i = 0; i < numKeys; ++i)
+                map.remove (keys.getReference (i));
+        }, 20, 2);
+
+        expect (map.size() == 0);
+        expect (total != 0);
+    }
+};
+
+static HashMapBenchmarks hashMapBenchmarks;
+
 } // namespace juce
@@ -274,6 +274,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "text/juce_Base64.h"
 #include "misc/juce_Result.h"
 #include "misc/juce_Uuid.h"
+#include "misc/juce_XXHash64.h"
 #include "misc/juce_ConsoleApplication.h"
 #include "containers/juce_Variant.h"
 #include "containers/juce_NamedValueSet.h"
@@ -328,12 +329,14 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "network/juce_URL.h"
 #include "network/juce_WebInputStream.h"
 #include "streams/juce_URLInputSource.h"
+#include "streams/juce_ReadAheadInputStream.h"
 #include "time/juce_PerformanceCounter.h"
 #include "unit_tests/juce_UnitTest.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
+#include "zip/juce_ParallelGZIPCompressorOutputStream.h"
 #include "zip/juce_ZipFile.h"
 #include "containers/juce_PropertySet.h"
 #include "memory/juce_SharedResourcePointer.h"
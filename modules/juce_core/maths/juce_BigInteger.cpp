@@ -903,70 +903,228 @@ BigInteger BigInteger::findGreatestCommonDivisor (BigInteger n) const
     return m;
 }
 
-void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& modulus)
+//==============================================================================
+/*  Does modular arithmetic in Montgomery form for an odd modulus, working directly
+    on arrays of machine words rather than going through the generic BigInteger
+    operators. Where the compiler has a 128-bit integer type, it uses 64-bit limbs.
+*/
+struct MontgomeryModulus
 {
-    *this %= modulus;
-    auto exp = exponent;
-    exp %= modulus;
+   #if defined (__SIZEOF_INT128__)
+    using Limb = uint64;
+    __extension__ using DoubleLimb = unsigned __int128;
+   #else
+    using Limb = uint32;
+    using DoubleLimb = uint64;
+   #endif
+
+    static constexpr int bitsPerLimb = (int) sizeof (Limb) * 8;
 
-    if (modulus.getHighestBit() <= 32 || modulus % 2 == 0)
+    explicit MontgomeryModulus (const BigInteger& m)
+        : numLimbs ((size_t) (m.getHighestBit() / bitsPerLimb + 1)),
+          modulus (numLimbs), rSquared (numLimbs), one (numLimbs, true), temp (numLimbs + 2)
     {
-        auto a = *this;
-        auto n = exp.getHighestBit();
+        jassert (m[0] && m.getHighestBit() > 0); // only works for odd moduli greater than 1
 
-        for (int i = n; --i >= 0;)
+        toLimbs (m, modulus);
+
+        // Newton's iteration for the inverse of the lowest limb, modulo 2^bitsPerLimb.
+        // Each step doubles the number of correct bits, starting with 3.
+        Limb inverse = modulus[0];
+
+        for (int i = 0; i < 5; ++i)
+            inverse *= (Limb) 2 - modulus[0] * inverse;
+
+        negativeInverse = (Limb) (0 - inverse);
+
+        BigInteger r2;
+        r2.setBit (2 * bitsPerLimb * (int) numLimbs);
+        r2 %= m;
+        toLimbs (r2, rSquared);
+
+        one[0] = 1;
+    }
+
+    /** Returns (base ^ exponent) % modulus, using a sliding window over the exponent bits. */
+    BigInteger exponentiate (const BigInteger& base, const BigInteger& exponent)
+    {
+        auto highestBit = exponent.getHighestBit();
+        auto windowBits = highestBit > 671 ? 6 : highestBit > 239 ? 5 : highestBit > 79 ? 4 : highestBit > 23 ? 3 : 1;
+
+        // table holds the odd powers base^1, base^3 .. base^(2^windowBits - 1)
+        HeapBlock<Limb> table (numLimbs << (windowBits - 1)), result (numLimbs), squared (numLimbs);
+
+        toLimbs (base, result);
+        multiply (table, result, rSquared);
+
+        if (windowBits > 1)
+        {
+            multiply (squared, table, table);
+
+            for (size_t i = 1; i < ((size_t) 1 << (windowBits - 1)); ++i)
+                multiply (table + i * numLimbs, table + (i - 1) * numLimbs, squared);
+        }
+
+        multiply (result, rSquared, one);
+
+        for (int i = highestBit; i >= 0;)
         {
-            *this *= *this;
+            if (! exponent[i])
+            {
+                multiply (result, result, result);
+                --i;
+                continue;
+            }
 
-            if (exp[i])
-                *this *= a;
+            // find the longest window ending in a set bit
+            auto lowestBit = jmax (0, i - windowBits + 1);
 
-            if (compareAbsolute (modulus) >= 0)
-                *this %= modulus;
+            while (! exponent[lowestBit])
+                ++lowestBit;
+
+            auto windowValue = exponent.getBitRangeAsInt (lowestBit, i - lowestBit + 1);
+
+            for (int j = lowestBit; j <= i; ++j)
+                multiply (result, result, result);
+
+            multiply (result, result, table + (windowValue >> 1) * numLimbs);
+            i = lowestBit - 1;
         }
+
+        multiply (result, result, one);
+        return fromLimbs (result);
     }
-    else
-    {
-        auto Rfactor = modulus.getHighestBit() + 1;
-        BigInteger R (1);
-        R.shiftLeft (Rfactor, 0);
 
-        BigInteger R1, m1, g;
-        g.extendedEuclidean (modulus, R, m1, R1);
+    /** Calculates (a * b / R) % modulus. The result may point to the same array as a or b. */
+    void multiply (Limb* result, const Limb* a, const Limb* b) noexcept
+    {
+        auto* t = temp.get();
+        std::fill (t, t + numLimbs + 2, (Limb) 0);
 
-        if (! g.isOne())
+        for (size_t i = 0; i < numLimbs; ++i)
         {
-            BigInteger a (*this);
+            DoubleLimb carry = 0;
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
+            for (size_t j = 0; j < numLimbs; ++j)
             {
-                *this *= *this;
+                carry += (DoubleLimb) t[j] + (DoubleLimb) a[j] * b[i];
+                t[j] = (Limb) carry;
+                carry >>= bitsPerLimb;
+            }
+
+            carry += t[numLimbs];
+            t[numLimbs] = (Limb) carry;
+            t[numLimbs + 1] = (Limb) (carry >> bitsPerLimb);
 
-                if (exp[i])
-                    *this *= a;
+            // add a multiple of the modulus that makes the lowest limb zero, then shift down a limb
+            auto m = (Limb) (t[0] * negativeInverse);
+            carry = ((DoubleLimb) t[0] + (DoubleLimb) m * modulus[0]) >> bitsPerLimb;
 
-                if (compareAbsolute (modulus) >= 0)
-                    *this %= modulus;
+            for (size_t j = 1; j < numLimbs; ++j)
+            {
+                carry += (DoubleLimb) t[j] + (DoubleLimb) m * modulus[j];
+                t[j - 1] = (Limb) carry;
+                carry >>= bitsPerLimb;
             }
+
+            carry += t[numLimbs];
+            t[numLimbs - 1] = (Limb) carry;
+            t[numLimbs] = (Limb) (t[numLimbs + 1] + (Limb) (carry >> bitsPerLimb));
         }
-        else
+
+        if (t[numLimbs] != 0 || ! isLessThanModulus (t))
         {
-            auto am  = (*this * R) % modulus;
-            auto xm = am;
-            auto um = R % modulus;
+            Limb borrow = 0;
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
+            for (size_t j = 0; j < numLimbs; ++j)
             {
-                xm.montgomeryMultiplication (xm, modulus, m1, Rfactor);
-
-                if (exp[i])
-                    xm.montgomeryMultiplication (am, modulus, m1, Rfactor);
+                auto difference = (DoubleLimb) t[j] - modulus[j] - borrow;
+                t[j] = (Limb) difference;
+                borrow = (Limb) ((difference >> bitsPerLimb) & 1);
             }
+        }
+
+        std::copy (t, t + numLimbs, result);
+    }
+
+private:
+    const size_t numLimbs;
+    HeapBlock<Limb> modulus, rSquared, one, temp;
+    Limb negativeInverse;
+
+    bool isLessThanModulus (const Limb* value) const noexcept
+    {
+        for (auto i = numLimbs; i > 0;)
+        {
+            --i;
+
+            if (value[i] != modulus[i])
+                return value[i] < modulus[i];
+        }
+
+        return false;
+    }
 
-            xm.montgomeryMultiplication (1, modulus, m1, Rfactor);
-            swapWith (xm);
+    void toLimbs (const BigInteger& value, Limb* limbs) const noexcept
+    {
+        for (size_t i = 0; i < numLimbs; ++i)
+        {
+            Limb limb = 0;
+
+            for (int j = 0; j < bitsPerLimb; j += 32)
+                limb |= (Limb) value.getBitRangeAsInt ((int) i * bitsPerLimb + j, 32) << j;
+
+            limbs[i] = limb;
         }
     }
+
+    BigInteger fromLimbs (const Limb* limbs) const
+    {
+        BigInteger value;
+
+        for (auto i = numLimbs; i > 0;)
+        {
+            --i;
+
+            for (int j = bitsPerLimb; (j -= 32) >= 0;)
+                value.setBitRangeAsInt ((int) i * bitsPerLimb + j, 32, (uint32) (limbs[i] >> j));
+        }
+
+        return value;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (MontgomeryModulus)
+};
+
+void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& modulus)
+{
+    *this %= modulus;
+    auto exp = exponent;
+    exp %= modulus;
+
+    if (modulus.getHighestBit() > 0 && modulus[0] && ! modulus.isNegative())
+    {
+        if (isNegative())
+            *this += modulus;
+
+        MontgomeryModulus m (modulus);
+        *this = m.exponentiate (*this, exp);
+        return;
+    }
+
+    auto a = *this;
+    auto n = exp.getHighestBit();
+
+    for (int i = n; --i >= 0;)
+    {
+        *this *= *this;
+
+        if (exp[i])
+            *this *= a;
+
+        if (compareAbsolute (modulus) >= 0)
+            *this %= modulus;
+    }
 }
 
 void BigInteger::montgomeryMultiplication (const BigInteger& other, const BigInteger& modulus,
@@ -1361,6 +1519,56 @@ public:
                 expect (old2 == readLittleEndianBitsInBuffer (test, offset + num, 6));
             }
         }
+
+        {
+            beginTest ("Exponent modulo");
+
+            Random r = getRandom();
+
+            // plain square-and-multiply, to check the Montgomery version against
+            auto referenceExponentModulo = [] (BigInteger base, const BigInteger& exponent, const BigInteger& modulus)
+            {
+                BigInteger result (1);
+                base %= modulus;
+
+                for (int i = exponent.getHighestBit(); i >= 0; --i)
+                {
+                    result = (result * result) % modulus;
+
+                    if (exponent[i])
+                        result = (result * base) % modulus;
+                }
+
+                return result % modulus;
+            };
+
+            for (int j = 300; --j >= 0;)
+            {
+                BigInteger base, exponent, modulus;
+                r.fillBitsRandomly (base,     0, r.nextInt (600) + 1);
+                r.fillBitsRandomly (exponent, 0, r.nextInt (300) + 1);
+                r.fillBitsRandomly (modulus,  0, r.nextInt (400) + 2);
+
+                if (j % 3 != 0)
+                    modulus.setBit (0);
+
+                if (modulus < 2 || exponent.isZero() || exponent >= modulus)
+                    continue;
+
+                auto result = base;
+                result.exponentModulo (exponent, modulus);
+
+                expect (result == referenceExponentModulo (base, exponent, modulus));
+            }
+
+            BigInteger value (12345);
+            value.exponentModulo (0, 1000001);
+            expect (value.isOne());
+
+            value = -7;
+            value.exponentModulo (3, 1000001);
+            expectEquals (value.toInt64(), (int64) (1000001 - 343));
+        }
     }
 };
 
@@ -0,0 +1,339 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XXHash64Helpers
+{
+    static constexpr uint64 prime1 = 0x9e3779b185ebca87ULL;
+    static constexpr uint64 prime2 = 0xc2b2ae3d27d4eb4fULL;
+    static constexpr uint64 prime3 = 0x165667b19e3779f9ULL;
+    static constexpr uint64 prime4 = 0x85ebca77c2b2ae63ULL;
+    static constexpr uint64 prime5 = 0x27d4eb2f165667c5ULL;
+
+    static uint64 rotateLeft (uint64 x, int bits) noexcept    { return (x << bits) | (x >> (64 - bits)); }
+
+    static uint64 round (uint64 accumulator, uint64 input) noexcept
+    {
+        return rotateLeft (accumulator + input * prime2, 31) * prime1;
+    }
+
+    static uint64 mergeRound (uint64 hash, uint64 accumulator) noexcept
+    {
+        return (hash ^ round (0, accumulator)) * prime1 + prime4;
+    }
+}
+
+//==============================================================================
+XXHash64::XXHash64 (uint64 seed) noexcept
+{
+    reset (seed);
+}
+
+void XXHash64::reset (uint64 seed) noexcept
+{
+    using namespace XXHash64Helpers;
+
+    accumulators[0] = seed + prime1 + prime2;
+    accumulators[1] = seed + prime2;
+    accumulators[2] = seed;
+    accumulators[3] = seed - prime1;
+    seedValue = seed;
+    totalLength = 0;
+    numBytesInBuffer = 0;
+}
+
+void XXHash64::processStripes (const uint8* data, size_t numStripes) noexcept
+{
+    // Working on local copies lets the compiler keep the accumulators in registers, and
+    // as they're independent of each other, the CPU can overlap their multiplies.
+    auto a0 = accumulators[0], a1 = accumulators[1], a2 = accumulators[2], a3 = accumulators[3];
+
+    for (; numStripes > 0; --numStripes, data += sizeof (buffer))
+    {
+        a0 = XXHash64Helpers::round (a0, ByteOrder::swapIfBigEndian (readUnaligned<uint64> (data)));
+        a1 = XXHash64Helpers::round (a1, ByteOrder::swapIfBigEndian (readUnaligned<uint64> (data + 8)));
+        a2 = XXHash64Helpers::round (a2, ByteOrder::swapIfBigEndian (readUnaligned<uint64> (data + 16)));
+        a3 = XXHash64Helpers::round (a3, ByteOrder::swapIfBigEndian (readUnaligned<uint64> (data + 24)));
+    }
+
+    accumulators[0] = a0;
+    accumulators[1] = a1;
+    accumulators[2] = a2;
+    accumulators[3] = a3;
+}
+
+void XXHash64::update (const void* data, size_t numBytes) noexcept
+{
+    auto d = static_cast<const uint8*> (data);
+    totalLength += numBytes;
+
+    if (numBytesInBuffer > 0)
+    {
+        auto numToCopy = jmin (numBytes, sizeof (buffer) - numBytesInBuffer);
+        memcpy (buffer + numBytesInBuffer, d, numToCopy);
+        numBytesInBuffer += numToCopy;
+        d += numToCopy;
+        numBytes -= numToCopy;
+
+        if (numBytesInBuffer < sizeof (buffer))
+            return;
+
+        processStripes (buffer, 1);
+        numBytesInBuffer = 0;
+    }
+
+    auto numStripes = numBytes / sizeof (buffer);
+    processStripes (d, numStripes);
+    d += numStripes * sizeof (buffer);
+    numBytes -= numStripes * sizeof (buffer);
+
+    if (numBytes > 0)
+    {
+        memcpy (buffer, d, numBytes);
+        numBytesInBuffer = numBytes;
+    }
+}
+
+uint64 XXHash64::getHash() const noexcept
+{
+    using namespace XXHash64Helpers;
+
+    uint64 hash;
+
+    if (totalLength >= sizeof (buffer))
+    {
+        hash = rotateLeft (accumulators[0], 1) + rotateLeft (accumulators[1], 7)
+             + rotateLeft (accumulators[2], 12) + rotateLeft (accumulators[3], 18);
+
+        for (auto a : accumulators)
+            hash = mergeRound (hash, a);
+    }
+    else
+    {
+        hash = seedValue + prime5;
+    }
+
+    hash += totalLength;
+
+    auto d = buffer;
+    auto remaining = numBytesInBuffer;
+
+    for (; remaining >= 8; remaining -= 8, d += 8)
+        hash = rotateLeft (hash ^ round (0, ByteOrder::littleEndianInt64 (d)), 27) * prime1 + prime4;
+
+    if (remaining >= 4)
+    {
+        hash = rotateLeft (hash ^ ((uint64) ByteOrder::littleEndianInt (d) * prime1), 23) * prime2 + prime3;
+        remaining -= 4;
+        d += 4;
+    }
+
+    for (; remaining > 0; --remaining, ++d)
+        hash = rotateLeft (hash ^ (*d * prime5), 11) * prime1;
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//==============================================================================
+uint64 XXHash64::calculate (const void* data, size_t numBytes, uint64 seed) noexcept
+{
+    XXHash64 hasher (seed);
+    hasher.update (data, numBytes);
+    return hasher.getHash();
+}
+
+uint64 XXHash64::calculate (const MemoryBlock& data, uint64 seed) noexcept
+{
+    return calculate (data.getData(), data.getSize(), seed);
+}
+
+uint64 XXHash64::calculate (InputStream& input, int64 maxBytesToRead, uint64 seed)
+{
+    if (maxBytesToRead < 0)
+        maxBytesToRead = std::numeric_limits<int64>::max();
+
+    XXHash64 hasher (seed);
+    constexpr int bufferSize = 64 * 1024;
+    HeapBlock<uint8> tempBuffer (bufferSize);
+
+    while (maxBytesToRead > 0)
+    {
+        auto bytesRead = input.read (tempBuffer, (int) jmin (maxBytesToRead, (int64) bufferSize));
+
+        if (bytesRead <= 0)
+            break;
+
+        maxBytesToRead -= bytesRead;
+        hasher.update (tempBuffer, (size_t) bytesRead);
+    }
+
+    return hasher.getHash();
+}
+
+uint64 XXHash64::calculate (const File& file, uint64 seed)
+{
+    FileInputStream fin (file);
+
+    if (fin.openedOk())
+        return calculate (fin, -1, seed);
+
+    return 0;
+}
+
+uint64 XXHash64::calculateSampled (const File& file, int numChunks, int chunkSize, uint64 seed)
+{
+    jassert (numChunks > 0 && chunkSize > 0);
+    numChunks = jmax (1, numChunks);
+    chunkSize = jmax (1, chunkSize);
+
+    FileInputStream fin (file);
+
+    if (! fin.openedOk())
+        return 0;
+
+    auto totalSize = fin.getTotalLength();
+
+    if (totalSize <= (int64) numChunks * chunkSize)
+        return calculate (fin, -1, seed);
+
+    XXHash64 hasher (seed);
+    auto sizeLE = ByteOrder::swapIfBigEndian ((uint64) totalSize);
+    hasher.update (&sizeLE, sizeof (sizeLE));
+
+    HeapBlock<uint8> chunk ((size_t) chunkSize);
+    auto lastChunkStart = totalSize - chunkSize;
+
+    for (int i = 0; i < numChunks; ++i)
+    {
+        auto chunkStart = numChunks > 1 ? lastChunkStart * i / (numChunks - 1) : (int64) 0;
+
+        if (! fin.setPosition (chunkStart))
+            return 0;
+
+        auto bytesRead = fin.read (chunk, chunkSize);
+
+        if (bytesRead > 0)
+            hasher.update (chunk, (size_t) bytesRead);
+    }
+
+    return hasher.getHash();
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XXHash64Tests  : public UnitTest
+{
+public:
+    XXHash64Tests()
+        : UnitTest ("XXHash64", UnitTestCategories::maths)
+    {}
+
+    void runTest() override
+    {
+        MemoryBlock data (10000);
+
+        for (int i = 0; i < (int) data.getSize(); ++i)
+            data[i] = (char) ((i * 7 + 3) & 255);
+
+        beginTest ("Reference values");
+        {
+            const char* fox = "The quick brown fox jumps over the lazy dog";
+
+            expectEquals ((int64) XXHash64::calculate ("", 0),                (int64) 0xef46db3751d8e999ULL);
+            expectEquals ((int64) XXHash64::calculate (fox, strlen (fox)),    (int64) 0x0b242d361fda71bcULL);
+            expectEquals ((int64) XXHash64::calculate (fox, strlen (fox), 12345), (int64) 0xd1b38ddc85a6fba1ULL);
+
+            const std::pair<size_t, uint64> expected[] = { { 1,     0x1f25c8d0bc1f4bb6ULL }, { 3,    0x31d2363f52e564c9ULL },
+                                                           { 4,     0x9bb64b7d66ee9fdaULL }, { 8,    0xdab99d95c6f90092ULL },
+                                                           { 31,    0xa2aa5f33cc4a6119ULL }, { 32,   0x23c3c17ef790fd97ULL },
+                                                           { 33,    0x50a7cfc7ba588784ULL }, { 100,  0xa61f8d4c170fe531ULL },
+                                                           { 1000,  0x5f235fa033f1a3fbULL }, { 10000, 0xb195585f9792dbcaULL } };
+
+            for (auto& e : expected)
+                expectEquals ((int64) XXHash64::calculate (data.getData(), e.first), (int64) e.second);
+        }
+
+        beginTest ("Incremental updates");
+        {
+            auto r = getRandom();
+            auto expected = XXHash64::calculate (data);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                XXHash64 hasher;
+
+                for (size_t pos = 0; pos < data.getSize();)
+                {
+                    auto numBytes = jmin ((size_t) r.nextInt (100), data.getSize() - pos);
+                    hasher.update (addBytesToPointer (data.getData(), pos), numBytes);
+                    pos += numBytes;
+                }
+
+                expectEquals ((int64) hasher.getHash(), (int64) expected);
+            }
+
+            MemoryInputStream m (data, false);
+            expectEquals ((int64) XXHash64::calculate (m), (int64) expected);
+        }
+
+        beginTest ("Files");
+        {
+            TemporaryFile tempFile;
+            tempFile.getFile().replaceWithData (data.getData(), data.getSize());
+
+            expectEquals ((int64) XXHash64::calculate (tempFile.getFile()), (int64) XXHash64::calculate (data));
+            expectEquals ((int64) XXHash64::calculateSampled (tempFile.getFile(), 4, 4096), (int64) XXHash64::calculate (data));
+
+            auto sampled = XXHash64::calculateSampled (tempFile.getFile(), 4, 100);
+            expect (sampled != XXHash64::calculate (data));
+
+            data[5000] = (char) (data[5000] + 1);
+            tempFile.getFile().replaceWithData (data.getData(), data.getSize());
+            expectEquals ((int64) XXHash64::calculateSampled (tempFile.getFile(), 4, 100), (int64) sampled);
+
+            data[0] = (char) (data[0] + 1);
+            tempFile.getFile().replaceWithData (data.getData(), data.getSize());
+            expect (XXHash64::calculateSampled (tempFile.getFile(), 4, 100) != sampled);
+
+            auto firstChunkOnly = XXHash64::calculateSampled (tempFile.getFile(), 1, 100);
+            data[9000] = (char) (data[9000] + 1);
+            tempFile.getFile().replaceWithData (data.getData(), data.getSize());
+            expectEquals ((int64) XXHash64::calculateSampled (tempFile.getFile(), 1, 100), (int64) firstChunkOnly);
+        }
+    }
+};
+
+static XXHash64Tests xxHash64UnitTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast, non-cryptographic 64-bit hash function, using the XXH64 algorithm.
+
+    This is many times faster than MD5 or SHA256 and has very good distribution,
+    so it's a good choice for building keys for content-addressed caches. Don't
+    use it for anything security-related though, because it's easy to create
+    collisions deliberately.
+
+    You can use the static methods to hash a block of data, a stream or a file in
+    one go, or create an XXHash64 object and feed it data incrementally, e.g.
+    @code
+    XXHash64 hasher;
+    hasher.update (header, headerSize);
+    hasher.update (body.getData(), body.getSize());
+    auto key = hasher.getHash();
+    @endcode
+
+    The results are identical to those of the reference XXH64() implementation.
+
+    @tags{Core}
+*/
+class JUCE_API  XXHash64
+{
+public:
+    //==============================================================================
+    /** Creates a hasher with the given seed, ready for data to be added with update(). */
+    explicit XXHash64 (uint64 seed = 0) noexcept;
+
+    /** Clears any data that has been added, and starts again with a new seed. */
+    void reset (uint64 seed = 0) noexcept;
+
+    /** Adds a block of data to the hash. */
+    void update (const void* data, size_t numBytes) noexcept;
+
+    /** Returns the hash of all the data that has been added so far.
+        This doesn't modify the state, so you can carry on adding more data afterwards.
+    */
+    uint64 getHash() const noexcept;
+
+    //==============================================================================
+    /** Returns the hash of a block of data. */
+    static uint64 calculate (const void* data, size_t numBytes, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of a block of data. */
+    static uint64 calculate (const MemoryBlock& data, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of the contents of a stream.
+
+        This will read from the stream until the stream is exhausted, or until
+        maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+        stream will be read.
+    */
+    static uint64 calculate (InputStream& input, int64 maxBytesToRead = -1, uint64 seed = 0);
+
+    /** Returns the hash of the entire contents of a file.
+        If the file can't be opened, this returns 0.
+    */
+    static uint64 calculate (const File& file, uint64 seed = 0);
+
+    /** Returns a hash of the file's size and a set of evenly-spaced chunks of its content.
+
+        For huge files this is much quicker than calculate(), as it only reads
+        numChunks * chunkSize bytes, always including the start and end of the file.
+        Obviously, changes that fall between the chunks won't affect the result, so
+        only use this where that's an acceptable trade-off, e.g. for spotting that a
+        sample file has been replaced. Files that are no bigger than the total size of
+        the chunks are hashed in their entirety, producing the same result as calculate().
+        If numChunks is 1, only the start of the file is sampled.
+
+        If the file can't be opened, this returns 0.
+    */
+    static uint64 calculateSampled (const File& file, int numChunks = 16, int chunkSize = 4096, uint64 seed = 0);
+
+private:
+    //==============================================================================
+    uint64 accumulators[4];
+    uint8 buffer[32];
+    uint64 seedValue, totalLength;
+    size_t numBytesInBuffer;
+
+    void processStripes (const uint8*, size_t) noexcept;
+
+    JUCE_LEAK_DETECTOR (XXHash64)
+};
+
+} // namespace juce
@@ -187,6 +187,7 @@ void CPUInformation::initialise() noexcept
         hasSSE42 = ((cpuFeatures & ANDROID_CPU_X86_FEATURE_SSE4_2) != 0);
         hasAVX   = ((cpuFeatures & ANDROID_CPU_X86_FEATURE_AVX)    != 0);
         hasAVX2  = ((cpuFeatures & ANDROID_CPU_X86_FEATURE_AVX2)   != 0);
+        hasSHA   = ((cpuFeatures & ANDROID_CPU_X86_FEATURE_SHA_NI) != 0);
 
         // Google does not distinguish between MMX, SSE, SSE2, SSE3 and SSSE3. So
         // I assume (and quick Google searches seem to confirm this) that there are
@@ -197,11 +198,13 @@ void CPUInformation::initialise() noexcept
     else if (cpuFamily == ANDROID_CPU_FAMILY_ARM)
     {
         hasNeon = ((cpuFeatures & ANDROID_CPU_ARM_FEATURE_NEON) != 0);
+        hasSHA  = ((cpuFeatures & ANDROID_CPU_ARM_FEATURE_SHA2) != 0);
     }
     else if (cpuFamily == ANDROID_CPU_FAMILY_ARM64)
     {
         // all arm 64-bit cpus have neon
         hasNeon = true;
+        hasSHA  = ((cpuFeatures & ANDROID_CPU_ARM64_FEATURE_SHA2) != 0);
     }
 }
 
@@ -171,6 +171,14 @@ void CPUInformation::initialise() noexcept
     hasAVX512VL        = flags.contains ("avx512vl");
     hasAVX512VPOPCNTDQ = flags.contains ("avx512_vpopcntdq");
 
+   #if JUCE_ARM
+    auto features = getCpuInfo ("Features");
+    hasNeon            = features.contains ("neon") || features.contains ("asimd");
+    hasSHA             = features.contains ("sha2");
+   #else
+    hasSHA             = flags.contains ("sha_ni");
+   #endif
+
     numLogicalCPUs  = getCpuInfo ("processor").getIntValue() + 1;
 
     // Assume CPUs in all sockets have the same number of cores
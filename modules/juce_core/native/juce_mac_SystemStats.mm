@@ -99,8 +99,13 @@ void CPUInformation::initialise() noexcept
     hasAVX512CD        = (b & (1u << 28)) != 0;
     hasAVX512BW        = (b & (1u << 30)) != 0;
     hasAVX512VL        = (b & (1u << 31)) != 0;
+    hasSHA             = (b & (1u << 29)) != 0;
     hasAVX512VBMI      = (c & (1u <<  1)) != 0;
     hasAVX512VPOPCNTDQ = (c & (1u << 14)) != 0;
+   #elif JUCE_ARM && JUCE_64BIT
+    // all 64-bit Apple CPUs have NEON and the ARMv8 SHA-256 instructions
+    hasNeon = true;
+    hasSHA  = true;
    #endif
 
     numLogicalCPUs = (int) [[NSProcessInfo processInfo] activeProcessorCount];
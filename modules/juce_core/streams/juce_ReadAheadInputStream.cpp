@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+ReadAheadInputStream::ReadAheadInputStream (InputStream* sourceStream, bool takeOwnership,
+                                            TimeSliceThread& backgroundThread, int bufferSize)
+   : source (sourceStream, takeOwnership),
+     thread (backgroundThread),
+     buffer ((size_t) jmax (4096, bufferSize)),
+     fifo (jmax (4096, bufferSize)),
+     position (sourceStream->getPosition()),
+     totalLength (sourceStream->getTotalLength())
+{
+    thread.addTimeSliceClient (this);
+}
+
+ReadAheadInputStream::~ReadAheadInputStream()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+//==============================================================================
+int ReadAheadInputStream::useTimeSlice()
+{
+    if (sourceExhausted)
+        return 500;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (jmin (fifo.getFreeSpace(), 65536), start1, size1, start2, size2);
+
+    if (size1 <= 0)
+        return 20; // full - read() will wake us up when there's some space
+
+    auto numRead = source->read (buffer + start1, size1);
+
+    if (numRead > 0)
+        fifo.finishedWrite (numRead);
+    else
+        sourceExhausted = true;
+
+    dataArrived.signal();
+    return 0;
+}
+
+//==============================================================================
+int64 ReadAheadInputStream::getTotalLength()
+{
+    return totalLength;
+}
+
+int64 ReadAheadInputStream::getPosition()
+{
+    return position;
+}
+
+bool ReadAheadInputStream::isExhausted()
+{
+    return sourceExhausted && fifo.getNumReady() == 0;
+}
+
+bool ReadAheadInputStream::setPosition (int64 newPosition)
+{
+    newPosition = jmax ((int64) 0, newPosition);
+
+    if (newPosition == position)
+        return true;
+
+    if (newPosition > position && newPosition - position <= fifo.getNumReady())
+    {
+        fifo.finishedRead ((int) (newPosition - position));
+        position = newPosition;
+        thread.moveToFrontOfQueue (this);
+        return true;
+    }
+
+    thread.removeTimeSliceClient (this);
+
+    fifo.reset();
+    sourceExhausted = false;
+    auto ok = source->setPosition (newPosition);
+    position = source->getPosition();
+
+    thread.addTimeSliceClient (this);
+    return ok;
+}
+
+int ReadAheadInputStream::read (void* destBuffer, int maxBytesToRead)
+{
+    jassert (destBuffer != nullptr && maxBytesToRead >= 0);
+
+    auto* dest = static_cast<char*> (destBuffer);
+    int numDone = 0;
+
+    while (numDone == 0 && maxBytesToRead > 0)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (maxBytesToRead, start1, size1, start2, size2);
+
+        if (size1 + size2 > 0)
+        {
+            memcpy (dest, buffer + start1, (size_t) size1);
+            memcpy (dest + size1, buffer + start2, (size_t) size2);
+            numDone = size1 + size2;
+            fifo.finishedRead (numDone);
+            thread.moveToFrontOfQueue (this);
+            break;
+        }
+
+        // the flag is only set after the last data has been pushed, so check the fifo again
+        if (sourceExhausted && fifo.getNumReady() == 0)
+            break;
+
+        dataArrived.wait (100);
+    }
+
+    position += numDone;
+    return numDone;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ReadAheadInputStreamTests   : public UnitTest
+{
+    ReadAheadInputStreamTests()
+        : UnitTest ("ReadAheadInputStream", UnitTestCategories::streams)
+    {}
+
+    void runTest() override
+    {
+        auto rng = getRandom();
+
+        MemoryBlock data (300000);
+
+        for (size_t i = 0; i < data.getSize(); ++i)
+            data[i] = (char) rng.nextInt (16);
+
+        MemoryOutputStream compressed;
+
+        {
+            GZIPCompressorOutputStream zipper (compressed);
+            zipper << data;
+        }
+
+        TimeSliceThread thread ("ReadAheadInputStream test");
+        thread.startThread();
+
+        beginTest ("Read");
+        {
+            MemoryInputStream mi (data, false);
+            ReadAheadInputStream stream (&mi, false, thread, 5000);
+
+            expectEquals (stream.getTotalLength(), (int64) data.getSize());
+
+            MemoryBlock result;
+
+            while (! stream.isExhausted())
+            {
+                char temp[3000];
+                auto num = stream.read (temp, rng.nextInt (3000) + 1);
+                expect (num >= 0);
+                result.append (temp, (size_t) num);
+                expectEquals (stream.getPosition(), (int64) result.getSize());
+            }
+
+            expect (result == data);
+            expectEquals (stream.read (&result, 1), 0);
+        }
+
+        beginTest ("Decompressing ahead");
+        {
+            ReadAheadInputStream stream (new GZIPDecompressorInputStream (new MemoryInputStream (compressed.getMemoryBlock(), true), true),
+                                         true, thread, 65536);
+
+            MemoryOutputStream result;
+            result << stream;
+            expect (result.getMemoryBlock() == data);
+        }
+
+        beginTest ("Seek");
+        {
+            MemoryInputStream mi (data, false);
+            ReadAheadInputStream stream (&mi, false, thread, 8192);
+
+            for (int i = 0; i < 50; ++i)
+            {
+                auto pos = (int64) rng.nextInt ((int) data.getSize() - 200);
+
+                expect (stream.setPosition (pos));
+                expectEquals (stream.getPosition(), pos);
+
+                char temp[100];
+                auto num = stream.read (temp, sizeof (temp));
+                expect (num > 0);
+                expect (memcmp (temp, static_cast<const char*> (data.getData()) + pos, (size_t) num) == 0);
+
+                expect (stream.setPosition (pos + num + 10));
+                expectEquals ((char) stream.readByte(), data[(size_t) (pos + num + 10)]);
+            }
+        }
+
+        thread.stopThread (1000);
+    }
+};
+
+static ReadAheadInputStreamTests readAheadInputStreamTests;
+
+#endif
+
+} // namespace juce
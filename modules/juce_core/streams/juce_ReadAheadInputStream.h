@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/** Wraps another input stream, and reads ahead from it on a background thread.
+
+    This is useful when the source stream does a lot of work for each byte it
+    produces - e.g. a GZIPDecompressorInputStream - and the caller also has work
+    to do with the data. The source is read in large chunks by a TimeSliceThread,
+    which fills a FIFO while the caller is busy, so decompressing the next part of
+    the data overlaps with processing the part that was already read.
+
+    All access to the source stream happens on the background thread (apart from
+    setPosition(), which briefly stops the background reading while it seeks the
+    source), so the source doesn't need to be thread-safe, but you mustn't use it
+    directly while it's wrapped by one of these.
+
+    The TimeSliceThread is supplied by the caller so that several streams can share
+    a thread, and it must be started by the caller too.
+
+    @see BufferedInputStream, GZIPDecompressorInputStream, TimeSliceThread
+
+    @tags{Core}
+*/
+class JUCE_API  ReadAheadInputStream  : public InputStream,
+                                        private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a ReadAheadInputStream from an input source.
+
+        @param sourceStream                 the source stream to read from
+        @param deleteSourceWhenDestroyed    whether the sourceStream that is passed in should be
+                                            deleted by this object when it is itself deleted.
+        @param backgroundThread             the thread which will read from the source. This
+                                            must not be deleted while the stream is in use.
+        @param bufferSize                   the number of bytes that may be read ahead of the
+                                            current position
+    */
+    ReadAheadInputStream (InputStream* sourceStream,
+                          bool deleteSourceWhenDestroyed,
+                          TimeSliceThread& backgroundThread,
+                          int bufferSize = 1024 * 1024);
+
+    /** Destructor.
+
+        This may also delete the source stream, if that option was chosen when the
+        stream was created.
+    */
+    ~ReadAheadInputStream() override;
+
+    //==============================================================================
+    int64 getTotalLength() override;
+    int64 getPosition() override;
+    bool setPosition (int64 newPosition) override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+    bool isExhausted() override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<InputStream> source;
+    TimeSliceThread& thread;
+    HeapBlock<char> buffer;
+    AbstractFifo fifo;
+    WaitableEvent dataArrived;
+    std::atomic<bool> sourceExhausted { false };
+    int64 position, totalLength;
+
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReadAheadInputStream)
+};
+
+} // namespace juce
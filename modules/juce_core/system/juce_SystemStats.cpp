@@ -97,7 +97,7 @@ struct CPUInformation
          hasAVX512DQ = false, hasAVX512ER   = false, hasAVX512IFMA = false,
          hasAVX512PF = false, hasAVX512VBMI = false, hasAVX512VL   = false,
          hasAVX512VPOPCNTDQ = false,
-         hasNeon = false;
+         hasNeon = false, hasSHA = false;
 };
 
 static const CPUInformation& getCPUInformation() noexcept
@@ -131,6 +131,7 @@ bool SystemStats::hasAVX512VBMI() noexcept      { return getCPUInformation().has
 bool SystemStats::hasAVX512VL() noexcept        { return getCPUInformation().hasAVX512VL; }
 bool SystemStats::hasAVX512VPOPCNTDQ() noexcept { return getCPUInformation().hasAVX512VPOPCNTDQ; }
 bool SystemStats::hasNeon() noexcept            { return getCPUInformation().hasNeon; }
+bool SystemStats::hasSHA() noexcept             { return getCPUInformation().hasSHA; }
 
 
 //==============================================================================
@@ -193,6 +193,7 @@ public:
     static bool hasAVX512VL() noexcept;        /**< Returns true if Intel AVX-512 Vector Length instructions are available. */
     static bool hasAVX512VPOPCNTDQ() noexcept; /**< Returns true if Intel AVX-512 Vector Population Count Double and Quad-word instructions are available. */
     static bool hasNeon() noexcept;            /**< Returns true if ARM NEON instructions are available. */
+    static bool hasSHA() noexcept;             /**< Returns true if Intel SHA extensions or ARMv8 SHA-256 instructions are available. */
 
     //==============================================================================
     /** Finds out how much RAM is in the machine.
@@ -113,6 +113,37 @@ Random UnitTest::getRandom() const
     return runner->randomForTest;
 }
 
+void UnitTest::benchmark (const String& sectionName, const std::function<void()>& section,
+                          int numIterations, int numWarmupIterations)
+{
+    // This method's only valid while the test is being run!
+    jassert (runner != nullptr);
+    jassert (numIterations > 0);
+
+    if (! runner->benchmarkingEnabled)
+    {
+        section();
+        return;
+    }
+
+    for (int i = 0; i < numWarmupIterations; ++i)
+        section();
+
+    std::vector<double> timesMs;
+    timesMs.reserve ((size_t) jmax (1, numIterations));
+
+    for (int i = 0; i < jmax (1, numIterations); ++i)
+    {
+        auto start = Time::getHighResolutionTicks();
+        section();
+        auto end = Time::getHighResolutionTicks();
+
+        timesMs.push_back (Time::highResolutionTicksToSeconds (end - start) * 1000.0);
+    }
+
+    runner->addBenchmark (sectionName, timesMs);
+}
+
 //==============================================================================
 UnitTestRunner::UnitTestRunner() {}
 UnitTestRunner::~UnitTestRunner() {}
@@ -127,6 +158,58 @@ void UnitTestRunner::setPassesAreLogged (bool shouldDisplayPasses) noexcept
     logPasses = shouldDisplayPasses;
 }
 
+void UnitTestRunner::setBenchmarkingEnabled (bool shouldTimeBenchmarks) noexcept
+{
+    benchmarkingEnabled = shouldTimeBenchmarks;
+}
+
+static String getBenchmarkKey (const String& testName, const String& subCategory, const String& sectionName)
+{
+    return testName + " / " + subCategory + " / " + sectionName;
+}
+
+void UnitTestRunner::setBenchmarkBaseline (const var& baseline, double maximumSlowdown)
+{
+    baselineMedians.clear();
+    maximumBenchmarkSlowdown = maximumSlowdown;
+
+    if (auto* list = baseline["benchmarks"].getArray())
+    {
+        for (auto& b : *list)
+            baselineMedians[getBenchmarkKey (b["test"], b["subcategory"], b["section"])] = b["medianMs"];
+
+        benchmarkingEnabled = true;
+    }
+}
+
+var UnitTestRunner::getBenchmarkResultsAsJSON() const
+{
+    Array<var> list;
+
+    for (auto* r : results)
+    {
+        for (auto& b : r->benchmarks)
+        {
+            auto* obj = new DynamicObject();
+            obj->setProperty ("test",                r->unitTestName);
+            obj->setProperty ("subcategory",         r->subcategoryName);
+            obj->setProperty ("section",             b.sectionName);
+            obj->setProperty ("iterations",          b.numIterations);
+            obj->setProperty ("minimumMs",           b.minimumMs);
+            obj->setProperty ("medianMs",            b.medianMs);
+            obj->setProperty ("meanMs",              b.meanMs);
+            obj->setProperty ("percentile90Ms",      b.percentile90Ms);
+            obj->setProperty ("maximumMs",           b.maximumMs);
+            obj->setProperty ("standardDeviationMs", b.standardDeviationMs);
+            list.add (var (obj));
+        }
+    }
+
+    auto* root = new DynamicObject();
+    root->setProperty ("benchmarks", list);
+    return var (root);
+}
+
 int UnitTestRunner::getNumResults() const noexcept
 {
     return results.size();
@@ -278,4 +361,72 @@ void UnitTestRunner::addFail (const String& failureMessage)
     if (assertOnFailure) { jassertfalse; }
 }
 
+void UnitTestRunner::addBenchmark (const String& sectionName, std::vector<double>& timesMs)
+{
+    jassert (! timesMs.empty());
+    std::sort (timesMs.begin(), timesMs.end());
+
+    TestResult::BenchmarkResult b;
+    b.sectionName = sectionName;
+    b.numIterations = (int) timesMs.size();
+
+    StatisticsAccumulator<double> stats;
+
+    for (auto t : timesMs)
+        stats.addValue (t);
+
+    auto percentile = [&timesMs] (double p) { return timesMs[(size_t) roundToInt (p * (double) (timesMs.size() - 1))]; };
+
+    b.minimumMs = timesMs.front();
+    b.medianMs = percentile (0.5);
+    b.meanMs = stats.getAverage();
+    b.percentile90Ms = percentile (0.9);
+    b.maximumMs = timesMs.back();
+    b.standardDeviationMs = stats.getStandardDeviation();
+
+    bool isRegression = false;
+    String key;
+
+    {
+        const ScopedLock sl (results.getLock());
+
+        auto* r = results.getLast();
+        jassert (r != nullptr); // You need to call UnitTest::beginTest() before running a benchmark!
+
+        r->benchmarks.add (b);
+        key = getBenchmarkKey (r->unitTestName, r->subcategoryName, sectionName);
+    }
+
+    auto formatMs = [] (double ms) { return String (ms, 4) + " ms"; };
+
+    String message ("Benchmark ");
+    message << sectionName << ": median " << formatMs (b.medianMs)
+            << ", min " << formatMs (b.minimumMs)
+            << ", mean " << formatMs (b.meanMs)
+            << ", p90 " << formatMs (b.percentile90Ms)
+            << ", max " << formatMs (b.maximumMs)
+            << ", sd " << formatMs (b.standardDeviationMs)
+            << " (" << b.numIterations << " iterations)";
+
+    auto baseline = baselineMedians.find (key);
+
+    if (baseline != baselineMedians.end() && baseline->second > 0.0)
+    {
+        auto change = b.medianMs / baseline->second - 1.0;
+        message << ", " << (change >= 0 ? "+" : "") << String (change * 100.0, 1) << "% against baseline";
+        isRegression = change > maximumBenchmarkSlowdown;
+    }
+
+    logMessage (message);
+
+    if (baseline == baselineMedians.end())
+        return;
+
+    if (isRegression)
+        addFail ("Benchmark " + sectionName + " regressed: median " + formatMs (b.medianMs)
+                   + ", baseline " + formatMs (baseline->second));
+    else
+        addPass();
+}
+
 } // namespace juce
@@ -280,6 +280,35 @@ public:
     */
     Random getRandom() const;
 
+    //==============================================================================
+    /** Runs a section of code repeatedly and records how long it takes.
+
+        This should be called from your runTest() method, after beginTest(). When the
+        runner has benchmarking enabled (see UnitTestRunner::setBenchmarkingEnabled()),
+        the section is run numWarmupIterations times without being timed, then
+        numIterations times with each run timed separately. A summary is logged and
+        added to the current TestResult.
+
+        When benchmarking is disabled, the section is run only once, so that the code
+        is still exercised by a normal test run without slowing it down.
+
+        If the runner has been given a baseline, a median time that exceeds the
+        baseline's median by more than the runner's tolerance is logged as a failure.
+
+        @code
+        beginTest ("Sorting");
+
+        benchmark ("Sort 10000 ints", [&]
+        {
+            std::sort (data.begin(), data.end());
+        });
+        @endcode
+
+        @see UnitTestRunner::setBenchmarkingEnabled, UnitTestRunner::setBenchmarkBaseline
+    */
+    void benchmark (const String& sectionName, const std::function<void()>& section,
+                    int numIterations = 100, int numWarmupIterations = 10);
+
 private:
     //==============================================================================
     template <class ValueType>
@@ -367,6 +396,33 @@ public:
     */
     void setPassesAreLogged (bool shouldDisplayPasses) noexcept;
 
+    //==============================================================================
+    /** Enables timing of the sections that tests pass to UnitTest::benchmark().
+        This is false by default, in which case each section is only run once.
+    */
+    void setBenchmarkingEnabled (bool shouldTimeBenchmarks) noexcept;
+
+    /** Returns true if benchmarking has been enabled. */
+    bool isBenchmarkingEnabled() const noexcept             { return benchmarkingEnabled; }
+
+    /** Gives the runner a set of previous results to compare benchmarks against.
+
+        The baseline should be an object in the format returned by
+        getBenchmarkResultsAsJSON(). Any benchmark whose median time is more than
+        maximumSlowdown (as a proportion, so 0.1 means 10%) above the median of the
+        matching baseline entry will be logged as a test failure. Benchmarks that
+        don't appear in the baseline are measured but not compared.
+
+        Setting a baseline also enables benchmarking. Pass an empty var to remove it.
+    */
+    void setBenchmarkBaseline (const var& baseline, double maximumSlowdown = 0.1);
+
+    /** Returns the benchmarks from the most recent run as a JSON-compatible object,
+        suitable for writing to a file with JSON::toString() and using as a baseline
+        in a later run.
+    */
+    var getBenchmarkResultsAsJSON() const;
+
     //==============================================================================
     /** Contains the results of a test.
 
@@ -401,6 +457,20 @@ public:
         Time startTime = Time::getCurrentTime();
         /** The time at which this test ended. */
         Time endTime;
+
+        /** A summary of one section measured by UnitTest::benchmark(). All times are in milliseconds. */
+        struct BenchmarkResult
+        {
+            /** The name that was passed to UnitTest::benchmark(). */
+            String sectionName;
+            /** The number of timed iterations. */
+            int numIterations = 0;
+
+            double minimumMs = 0, medianMs = 0, meanMs = 0, percentile90Ms = 0, maximumMs = 0, standardDeviationMs = 0;
+        };
+
+        /** The benchmarks that were measured during this test. */
+        Array<BenchmarkResult> benchmarks;
     };
 
     /** Returns the number of TestResult objects that have been performed.
@@ -437,14 +507,17 @@ private:
     UnitTest* currentTest = nullptr;
     String currentSubCategory;
     OwnedArray<TestResult, CriticalSection> results;
-    bool assertOnFailure = true, logPasses = false;
+    bool assertOnFailure = true, logPasses = false, benchmarkingEnabled = false;
     Random randomForTest;
+    std::map<String, double> baselineMedians;
+    double maximumBenchmarkSlowdown = 0.1;
 
     void beginNewTest (UnitTest* test, const String& subCategory);
     void endTest();
 
     void addPass();
     void addFail (const String& failureMessage);
+    void addBenchmark (const String& sectionName, std::vector<double>& timesMs);
 
     JUCE_DECLARE_NON_COPYABLE (UnitTestRunner)
 };
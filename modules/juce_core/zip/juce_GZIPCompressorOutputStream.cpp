@@ -71,7 +71,7 @@ private:
     zlibNamespace::z_stream stream;
     const int compLevel;
     bool isFirstDeflate = true, streamIsValid = false, finished = false;
-    zlibNamespace::Bytef buffer[32768];
+    zlibNamespace::Bytef buffer[65536];
 
     bool doNextBlock (const uint8*& data, size_t& dataSize, OutputStream& out, const int flushMode)
     {
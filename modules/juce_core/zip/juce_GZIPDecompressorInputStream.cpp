@@ -169,7 +169,7 @@ public:
 
     bool finished = true, needsDictionary = false, error = true, streamIsValid = false;
 
-    enum { gzipDecompBufferSize = 32768 };
+    enum { gzipDecompBufferSize = 65536 };
 
 private:
     zlibNamespace::z_stream stream;
@@ -0,0 +1,412 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ParallelGZIPCompressorOutputStream::ParallelCompressorHelper
+{
+public:
+    ParallelCompressorHelper (int compressionLevel, int windowBitsToUse, int numThreads, int blockSizeToUse)
+        : compLevel ((compressionLevel < 0 || compressionLevel > 9) ? 6 : compressionLevel),
+          format (windowBitsToUse < 0 ? rawFormat : (windowBitsToUse > 15 ? gzipFormat : zlibFormat)),
+          windowBits (windowBitsToUse == 0 ? 15 : jlimit (9, 15, std::abs (windowBitsToUse) & 15)),
+          blockSize ((size_t) jmax (1 << windowBits, blockSizeToUse)),
+          maxBlocksInFlight (2 * (numThreads > 0 ? numThreads : SystemStats::getNumCpus())),
+          pool (numThreads > 0 ? numThreads : SystemStats::getNumCpus())
+    {
+        startNewBlock (nullptr);
+    }
+
+    ~ParallelCompressorHelper()
+    {
+        // make sure no jobs are still referring to our blocks
+        for (auto* b : pendingBlocks)
+            b->done.wait();
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on a gzip stream, the stream is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        while (dataSize > 0 && ! failed)
+        {
+            auto& input = currentBlock->input;
+            auto numToCopy = jmin (dataSize, blockSize - currentBlock->inputSize);
+
+            if (input.getSize() < blockSize)
+                input.setSize (blockSize);
+
+            memcpy (addBytesToPointer (input.getData(), currentBlock->inputSize), data, numToCopy);
+            currentBlock->inputSize += numToCopy;
+            data += numToCopy;
+            dataSize -= numToCopy;
+
+            if (currentBlock->inputSize == blockSize)
+                submitCurrentBlock (out, false);
+        }
+
+        return ! failed;
+    }
+
+    void finish (OutputStream& out)
+    {
+        if (finished)
+            return;
+
+        submitCurrentBlock (out, true);
+        writeCompletedBlocks (out, 0);
+        finished = true;
+
+        if (failed)
+            return;
+
+        if (format == zlibFormat)
+        {
+            failed = ! out.writeIntBigEndian ((int) checksum);
+        }
+        else if (format == gzipFormat)
+        {
+            failed = ! (out.writeInt ((int) checksum)
+                         && out.writeInt ((int) (totalInputSize & 0xffffffff)));
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Block
+    {
+        MemoryBlock input, dictionary, output;
+        size_t inputSize = 0, outputSize = 0;
+        uint32 checksum = 0;
+        bool isLast = false, succeeded = false;
+        WaitableEvent done { true };
+
+        void compress (int level, int windowBits, bool useCRC)
+        {
+            using namespace zlibNamespace;
+
+            z_stream stream;
+            zerostruct (stream);
+
+            if (deflateInit2 (&stream, level, Z_DEFLATED, -windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK)
+            {
+                succeeded = dictionary.getSize() == 0
+                              || deflateSetDictionary (&stream, static_cast<Bytef*> (dictionary.getData()),
+                                                       (uInt) dictionary.getSize()) == Z_OK;
+
+                output.setSize (inputSize + inputSize / 8 + 256);
+                stream.next_in  = static_cast<Bytef*> (input.getData());
+                stream.avail_in = (uInt) inputSize;
+
+                while (succeeded)
+                {
+                    if (outputSize == output.getSize())
+                        output.setSize (output.getSize() * 2);
+
+                    stream.next_out  = static_cast<Bytef*> (output.getData()) + outputSize;
+                    stream.avail_out = (uInt) (output.getSize() - outputSize);
+
+                    auto result = deflate (&stream, isLast ? Z_FINISH : Z_SYNC_FLUSH);
+                    outputSize = output.getSize() - stream.avail_out;
+
+                    if (result == Z_STREAM_END)
+                        break;
+
+                    if (result != Z_OK && result != Z_BUF_ERROR)
+                        succeeded = false;
+                    else if (! isLast && stream.avail_in == 0 && stream.avail_out > 0)
+                        break;
+                }
+
+                deflateEnd (&stream);
+            }
+
+            auto* data = static_cast<const Bytef*> (input.getData());
+            checksum = useCRC ? (uint32) crc32   (0, data, (uInt) inputSize)
+                              : (uint32) adler32 (1, data, (uInt) inputSize);
+
+            input.reset();
+            dictionary.reset();
+            done.signal();
+        }
+    };
+
+    enum Format { zlibFormat, gzipFormat, rawFormat };
+
+    const int compLevel;
+    const Format format;
+    const int windowBits;
+    const size_t blockSize;
+    const int maxBlocksInFlight;
+    std::unique_ptr<Block> currentBlock;
+    OwnedArray<Block> pendingBlocks;
+    ThreadPool pool;
+    uint32 checksum = 0;
+    uint64 totalInputSize = 0;
+    bool headerWritten = false, finished = false, failed = false;
+
+    void startNewBlock (const Block* previous)
+    {
+        currentBlock.reset (new Block());
+
+        // Priming each block with the end of the previous one means the workers don't
+        // lose the back-references that a single-threaded deflate would have found
+        if (previous != nullptr && previous->inputSize > 0)
+        {
+            auto dictSize = jmin (previous->inputSize, (size_t) 1 << windowBits);
+            currentBlock->dictionary.append (addBytesToPointer (previous->input.getData(), previous->inputSize - dictSize),
+                                             dictSize);
+        }
+    }
+
+    void submitCurrentBlock (OutputStream& out, bool isLast)
+    {
+        auto* block = pendingBlocks.add (currentBlock.release());
+        block->isLast = isLast;
+
+        if (! isLast)
+            startNewBlock (block);
+
+        auto level = compLevel, bits = windowBits;
+        auto useCRC = (format == gzipFormat);
+
+        pool.addJob ([block, level, bits, useCRC] { block->compress (level, bits, useCRC); });
+
+        writeCompletedBlocks (out, maxBlocksInFlight);
+    }
+
+    void writeCompletedBlocks (OutputStream& out, int maxBlocksLeftPending)
+    {
+        while (! pendingBlocks.isEmpty())
+        {
+            auto* block = pendingBlocks.getFirst();
+
+            if (pendingBlocks.size() > maxBlocksLeftPending)
+                block->done.wait();
+            else if (! block->done.wait (0))
+                break;
+
+            if (! failed)
+                failed = ! (block->succeeded
+                             && writeHeaderIfNeeded (out)
+                             && out.write (block->output.getData(), block->outputSize));
+
+            combineChecksum (block->checksum, block->inputSize);
+            pendingBlocks.remove (0);
+        }
+    }
+
+    void combineChecksum (uint32 blockChecksum, size_t blockLength)
+    {
+        using namespace zlibNamespace;
+
+        if (totalInputSize == 0)
+            checksum = blockChecksum;
+        else if (blockLength > 0)
+            checksum = format == gzipFormat ? (uint32) crc32_combine   (checksum, blockChecksum, (z_off_t) blockLength)
+                                            : (uint32) adler32_combine (checksum, blockChecksum, (z_off_t) blockLength);
+
+        totalInputSize += blockLength;
+    }
+
+    bool writeHeaderIfNeeded (OutputStream& out)
+    {
+        if (headerWritten)
+            return true;
+
+        headerWritten = true;
+
+        if (format == zlibFormat)
+        {
+            auto levelFlags = compLevel < 2 ? 0 : (compLevel < 6 ? 1 : (compLevel == 6 ? 2 : 3));
+            auto header = (((windowBits - 8) << 4) | 8) << 8 | (levelFlags << 6);
+            header += 31 - (header % 31);
+
+            return out.writeShortBigEndian ((short) header);
+        }
+
+        if (format == gzipFormat)
+        {
+            const uint8 header[] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0,
+                                     (uint8) (compLevel == 9 ? 2 : (compLevel == 1 ? 4 : 0)),
+                                     0xff };
+
+            return out.write (header, sizeof (header));
+        }
+
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelCompressorHelper)
+};
+
+//==============================================================================
+ParallelGZIPCompressorOutputStream::ParallelGZIPCompressorOutputStream (OutputStream& s, int compressionLevel,
+                                                                        int windowBits, int numThreads, int blockSize)
+   : ParallelGZIPCompressorOutputStream (&s, compressionLevel, false, windowBits, numThreads, blockSize)
+{
+}
+
+ParallelGZIPCompressorOutputStream::ParallelGZIPCompressorOutputStream (OutputStream* out, int compressionLevel, bool deleteDestStream,
+                                                                        int windowBits, int numThreads, int blockSize)
+   : destStream (out, deleteDestStream),
+     helper (new ParallelCompressorHelper (compressionLevel, windowBits, numThreads, blockSize))
+{
+    jassert (out != nullptr);
+}
+
+ParallelGZIPCompressorOutputStream::~ParallelGZIPCompressorOutputStream()
+{
+    flush();
+}
+
+void ParallelGZIPCompressorOutputStream::flush()
+{
+    helper->finish (*destStream);
+    destStream->flush();
+}
+
+bool ParallelGZIPCompressorOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    return helper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
+}
+
+int64 ParallelGZIPCompressorOutputStream::getPosition()
+{
+    return destStream->getPosition();
+}
+
+bool ParallelGZIPCompressorOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ParallelGZIPTests  : public UnitTest
+{
+    ParallelGZIPTests()
+        : UnitTest ("Parallel GZIP", UnitTestCategories::compression)
+    {}
+
+    static MemoryBlock createTestData (Random& rng, int size)
+    {
+        MemoryBlock data ((size_t) size);
+        auto* d = static_cast<char*> (data.getData());
+
+        // a mixture of noise and repeated phrases, so that there's something to compress
+        for (int i = 0; i < size;)
+        {
+            if (i > 1000 && rng.nextBool())
+            {
+                auto len = jmin (size - i, rng.nextInt (300) + 3);
+                auto distance = len + 1 + rng.nextInt (jmin (1000, i - len));
+                memmove (d + i, d + i - distance, (size_t) len);
+                i += len;
+            }
+            else
+            {
+                d[i++] = (char) rng.nextInt (40);
+            }
+        }
+
+        return data;
+    }
+
+    void checkRoundTrip (const MemoryBlock& original, int level, int windowBits,
+                         GZIPDecompressorInputStream::Format format, int numThreads, int blockSize)
+    {
+        MemoryOutputStream compressed;
+
+        {
+            ParallelGZIPCompressorOutputStream zipper (compressed, level, windowBits, numThreads, blockSize);
+            auto* d = static_cast<const char*> (original.getData());
+
+            for (size_t pos = 0; pos < original.getSize();)
+            {
+                auto num = jmin (original.getSize() - pos, (size_t) getRandom().nextInt (100000) + 1);
+                expect (zipper.write (d + pos, num));
+                pos += num;
+            }
+        }
+
+        MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+        GZIPDecompressorInputStream unzipper (&compressedInput, false, format);
+
+        MemoryOutputStream uncompressed;
+        uncompressed << unzipper;
+
+        expect (uncompressed.getMemoryBlock() == original);
+    }
+
+    void runTest() override
+    {
+        auto rng = getRandom();
+
+        beginTest ("Round trip");
+        {
+            for (auto size : { 0, 1, 100, 65536, 300000, 1000000 })
+            {
+                auto data = createTestData (rng, size);
+
+                checkRoundTrip (data, -1, 0,                                              GZIPDecompressorInputStream::zlibFormat,    4, 65536);
+                checkRoundTrip (data, 1,  GZIPCompressorOutputStream::windowBitsGZIP,     GZIPDecompressorInputStream::gzipFormat,    3, 32768);
+                checkRoundTrip (data, 9,  GZIPCompressorOutputStream::windowBitsRaw,      GZIPDecompressorInputStream::deflateFormat, 2, 100000);
+                checkRoundTrip (data, 0,  0,                                              GZIPDecompressorInputStream::zlibFormat,    0, 65536);
+                checkRoundTrip (data, 6,  12,                                             GZIPDecompressorInputStream::zlibFormat,    2, 4096);
+            }
+        }
+
+        beginTest ("Matches serial compression ratio");
+        {
+            auto data = createTestData (rng, 2000000);
+            MemoryOutputStream serial, parallel;
+
+            {
+                GZIPCompressorOutputStream zipper (serial);
+                zipper << data;
+            }
+
+            {
+                ParallelGZIPCompressorOutputStream zipper (parallel, -1, 0, 4, 256 * 1024);
+                zipper << data;
+            }
+
+            expect (parallel.getDataSize() < serial.getDataSize() + serial.getDataSize() / 50);
+        }
+    }
+};
+
+static ParallelGZIPTests parallelGZIPTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A compression stream that spreads the work of deflating its data across
+    several threads.
+
+    The incoming data is divided into blocks which are compressed independently
+    on a private ThreadPool, each one being primed with the tail of the block
+    before it as a preset dictionary, so the compression ratio stays very close
+    to that of a single-threaded GZIPCompressorOutputStream. The compressed blocks
+    are written to the destination stream in order, with a single header and
+    trailer, so the result is an ordinary zlib, gzip or raw deflate stream which
+    any decompressor (including GZIPDecompressorInputStream) can read.
+
+    This is worthwhile when compressing large amounts of data - for small
+    payloads, the plain GZIPCompressorOutputStream will be just as fast and
+    uses less memory.
+
+    As with GZIPCompressorOutputStream, calling flush() closes the stream, and
+    no more data can be written to it afterwards.
+
+    @see GZIPCompressorOutputStream, GZIPDecompressorInputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ParallelGZIPCompressorOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written
+        @param compressionLevel                 how much to compress the data, between 0 and 9, where
+                                                0 is non-compressed storage, 1 is the fastest/lowest compression,
+                                                and 9 is the slowest/highest compression. Any value outside this range
+                                                indicates that a default compression level should be used.
+        @param windowBits                       selects the output format in the same way as for
+                                                GZIPCompressorOutputStream: 0 produces a zlib stream, and
+                                                GZIPCompressorOutputStream::windowBitsGZIP or
+                                                GZIPCompressorOutputStream::windowBitsRaw select gzip or raw
+                                                deflate data
+        @param numThreads                       the number of worker threads to use, or 0 to use one per CPU
+        @param blockSize                        the number of uncompressed bytes that each worker compresses
+                                                at a time
+    */
+    ParallelGZIPCompressorOutputStream (OutputStream& destStream,
+                                        int compressionLevel = -1,
+                                        int windowBits = 0,
+                                        int numThreads = 0,
+                                        int blockSize = defaultBlockSize);
+
+    /** Creates a compression stream.
+        @param destStream                       the stream into which the compressed data will be written.
+                                                Ownership of this object depends on the value of deleteDestStreamWhenDestroyed
+        @param compressionLevel                 how much to compress the data, between 0 and 9 (see above)
+        @param deleteDestStreamWhenDestroyed    whether or not this object will delete the destStream
+                                                object when it is destroyed
+        @param windowBits                       selects the output format (see above)
+        @param numThreads                       the number of worker threads to use, or 0 to use one per CPU
+        @param blockSize                        the number of uncompressed bytes that each worker compresses
+                                                at a time
+    */
+    ParallelGZIPCompressorOutputStream (OutputStream* destStream,
+                                        int compressionLevel = -1,
+                                        bool deleteDestStreamWhenDestroyed = false,
+                                        int windowBits = 0,
+                                        int numThreads = 0,
+                                        int blockSize = defaultBlockSize);
+
+    /** Destructor. */
+    ~ParallelGZIPCompressorOutputStream() override;
+
+    //==============================================================================
+    /** Waits for all outstanding blocks to be compressed, then writes them and closes the stream.
+        Note that unlike most streams, when you call flush() on this type of stream, it is
+        closed - this means that no more data can be written to it, and any subsequent
+        attempts to call write() will cause an assertion.
+    */
+    void flush() override;
+
+    /** Returns the position of the destination stream.
+        Because blocks are compressed in the background, this only reflects the data
+        that has been written out so far.
+    */
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+    /** The block size that is used if none is specified in the constructor. */
+    enum { defaultBlockSize = 1024 * 1024 };
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+
+    class ParallelCompressorHelper;
+    std::unique_ptr<ParallelCompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelGZIPCompressorOutputStream)
+};
+
+} // namespace juce
@@ -50,7 +50,10 @@ struct ZipFile::ZipEntryHolder
         auto fileType = (entry.externalFileAttributes >> 28) & 0xf;
         entry.isSymbolicLink = (fileType == 0xA);
 
-        entry.filename = String::fromUTF8 (buffer + 46, fileNameLen);
+        // Names written by older tools may be in a legacy code page rather than UTF-8, so
+        // decode them leniently instead of going through String::fromUTF8()'s validity check
+        auto* name = buffer + 46;
+        entry.filename = String (CharPointer_UTF8 (name), CharPointer_UTF8 (name + jmax (0, fileNameLen)));
     }
 
     static Time parseFileTime (uint32 time, uint32 date) noexcept
@@ -243,6 +246,22 @@ ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file))
     init();
 }
 
+ZipFile::ZipFile (const File& file, bool useMemoryMapping)
+{
+    if (useMemoryMapping)
+    {
+        mappedFile.reset (new MemoryMappedFile (file, MemoryMappedFile::readOnly));
+
+        if (mappedFile->getData() == nullptr)
+            mappedFile.reset();
+    }
+
+    if (mappedFile == nullptr)
+        inputSource.reset (new FileInputSource (file));
+
+    init();
+}
+
 ZipFile::ZipFile (InputSource* source)  : inputSource (source)
 {
     init();
@@ -268,29 +287,120 @@ ZipFile::OpenStreamCounter::~OpenStreamCounter()
 //==============================================================================
 int ZipFile::getNumEntries() const noexcept
 {
-    return entries.size();
+    return entryOffsets.size();
+}
+
+ZipFile::ZipEntryHolder* ZipFile::getEntryHolder (const int index) const
+{
+    if (! isPositiveAndBelow (index, entryOffsets.size()))
+        return nullptr;
+
+    const ScopedLock sl (entryLock);
+    auto& zei = entries[(size_t) index];
+
+    if (zei == nullptr)
+    {
+        auto* buffer = centralDirectory + entryOffsets.getUnchecked (index);
+        zei.reset (new ZipEntryHolder (buffer, readUnalignedLittleEndianShort (buffer + 28u)));
+    }
+
+    return zei.get();
 }
 
 const ZipFile::ZipEntry* ZipFile::getEntry (const int index) const noexcept
 {
-    if (auto* zei = entries[index])
+    if (auto* zei = getEntryHolder (index))
         return &(zei->entry);
 
     return nullptr;
 }
 
+static uint32 getFilenameHash (const char* name, size_t length) noexcept
+{
+    return (uint32) XXHash64::calculate (name, length);
+}
+
+static uint32 getFilenameHash (const String& name) noexcept
+{
+    return getFilenameHash (name.toRawUTF8(), name.getNumBytesAsUTF8());
+}
+
+// Only plain ASCII names are certain to be unchanged by String::fromUTF8(). Others, e.g.
+// CP437 names written by older tools, have to be compared using their decoded filename.
+static bool isPlainAsciiFilename (const char* name, size_t length) noexcept
+{
+    for (size_t i = 0; i < length; ++i)
+        if (name[i] == 0 || (static_cast<uint8> (name[i]) & 0x80) != 0)
+            return false;
+
+    return true;
+}
+
+void ZipFile::buildFilenameHashTable()
+{
+    auto numEntries = entryOffsets.size();
+    filenameHashTable.clearQuick();
+    filenameHashTable.insertMultiple (0, -1, nextPowerOfTwo (jmax (16, numEntries * 2)));
+    auto mask = (uint32) filenameHashTable.size() - 1;
+
+    for (int i = 0; i < numEntries; ++i)
+    {
+        auto* buffer = centralDirectory + entryOffsets.getUnchecked (i);
+        auto* name = buffer + 46;
+        size_t nameLength = readUnalignedLittleEndianShort (buffer + 28u);
+
+        auto slot = (isPlainAsciiFilename (name, nameLength) ? getFilenameHash (name, nameLength)
+                                                             : getFilenameHash (getEntryHolder (i)->entry.filename)) & mask;
+
+        while (filenameHashTable.getUnchecked ((int) slot) >= 0)
+            slot = (slot + 1) & mask;
+
+        filenameHashTable.set ((int) slot, i);
+    }
+}
+
 int ZipFile::getIndexOfFileName (const String& fileName, bool ignoreCase) const noexcept
 {
-    for (int i = 0; i < entries.size(); ++i)
+    if (ignoreCase)
     {
-        auto& entryFilename = entries.getUnchecked (i)->entry.filename;
+        for (int i = 0; i < getNumEntries(); ++i)
+            if (getEntryHolder (i)->entry.filename.equalsIgnoreCase (fileName))
+                return i;
 
-        if (ignoreCase ? entryFilename.equalsIgnoreCase (fileName)
-                       : entryFilename == fileName)
-            return i;
+        return -1;
     }
 
-    return -1;
+    const ScopedLock sl (entryLock);
+
+    if (filenameHashTable.isEmpty())
+        return -1;
+
+    auto* name = fileName.toRawUTF8();
+    auto nameLength = fileName.getNumBytesAsUTF8();
+    auto mask = (uint32) filenameHashTable.size() - 1;
+
+    // Entries with the same name were inserted in order, so the first match is the lowest index
+    for (auto slot = getFilenameHash (name, nameLength) & mask;; slot = (slot + 1) & mask)
+    {
+        auto index = filenameHashTable.getUnchecked ((int) slot);
+
+        if (index < 0)
+            return -1;
+
+        auto* buffer = centralDirectory + entryOffsets.getUnchecked (index);
+        auto* entryName = buffer + 46;
+        size_t entryNameLength = readUnalignedLittleEndianShort (buffer + 28u);
+
+        if (isPlainAsciiFilename (entryName, entryNameLength))
+        {
+            if (entryNameLength == nameLength && memcmp (entryName, name, nameLength) == 0)
+                return index;
+        }
+        else if (getEntryHolder (index)->entry.filename == fileName)
+        {
+            return index;
+        }
+    }
 }
 
 const ZipFile::ZipEntry* ZipFile::getEntry (const String& fileName, bool ignoreCase) const noexcept
@@ -302,9 +412,21 @@ InputStream* ZipFile::createStreamForEntry (const int index)
 {
     InputStream* stream = nullptr;
 
-    if (auto* zei = entries[index])
+    if (auto* zei = getEntryHolder (index))
     {
-        stream = new ZipInputStream (*this, *zei);
+        if (mappedFile != nullptr)
+        {
+            auto* data = getMappedEntryData (*zei);
+
+            if (data == nullptr)
+                return nullptr;
+
+            stream = new MemoryInputStream (data, (size_t) zei->compressedSize, false);
+        }
+        else
+        {
+            stream = new ZipInputStream (*this, *zei);
+        }
 
         if (zei->isCompressed)
         {
@@ -322,17 +444,70 @@ InputStream* ZipFile::createStreamForEntry (const int index)
 
 InputStream* ZipFile::createStreamForEntry (const ZipEntry& entry)
 {
-    for (int i = 0; i < entries.size(); ++i)
-        if (&entries.getUnchecked (i)->entry == &entry)
-            return createStreamForEntry (i);
+    const ScopedLock sl (entryLock);
+
+    for (size_t i = 0; i < entries.size(); ++i)
+        if (entries[i] != nullptr && &entries[i]->entry == &entry)
+            return createStreamForEntry ((int) i);
+
+    return nullptr;
+}
+
+const char* ZipFile::getMappedEntryData (const ZipEntryHolder& zei) const
+{
+    auto* fileStart = static_cast<const char*> (mappedFile->getData());
+    auto fileSize = mappedFile->getSize();
+    auto headerPos = (size_t) zei.streamOffset;
+
+    if (headerPos + 30 > fileSize || readUnalignedLittleEndianInt (fileStart + headerPos) != 0x04034b50)
+        return nullptr;
+
+    auto dataPos = headerPos + 30 + readUnalignedLittleEndianShort (fileStart + headerPos + 26)
+                                  + readUnalignedLittleEndianShort (fileStart + headerPos + 28);
+
+    if (dataPos + (size_t) zei.compressedSize > fileSize)
+        return nullptr;
+
+    return fileStart + dataPos;
+}
+
+const void* ZipFile::getMappedDataForEntry (int index) const
+{
+    if (mappedFile != nullptr)
+        if (auto* zei = getEntryHolder (index))
+            if (! zei->isCompressed)
+                return getMappedEntryData (*zei);
 
     return nullptr;
 }
 
 void ZipFile::sortEntriesByFilename()
 {
-    std::sort (entries.begin(), entries.end(),
-               [] (const ZipEntryHolder* e1, const ZipEntryHolder* e2) { return e1->entry.filename < e2->entry.filename; });
+    const ScopedLock sl (entryLock);
+
+    Array<int> order;
+
+    for (int i = 0; i < getNumEntries(); ++i)
+    {
+        getEntryHolder (i);
+        order.add (i);
+    }
+
+    std::sort (order.begin(), order.end(),
+               [this] (int i1, int i2) { return entries[(size_t) i1]->entry.filename < entries[(size_t) i2]->entry.filename; });
+
+    decltype (entries) sortedEntries;
+    Array<uint32> sortedOffsets;
+
+    for (auto i : order)
+    {
+        sortedEntries.push_back (std::move (entries[(size_t) i]));
+        sortedOffsets.add (entryOffsets.getUnchecked (i));
+    }
+
+    entries.swap (sortedEntries);
+    entryOffsets.swapWith (sortedOffsets);
+    buildFilenameHashTable();
 }
 
 //==============================================================================
@@ -341,7 +516,12 @@ void ZipFile::init()
     std::unique_ptr<InputStream> toDelete;
     InputStream* in = inputStream;
 
-    if (inputSource != nullptr)
+    if (mappedFile != nullptr)
+    {
+        in = new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false);
+        toDelete.reset (in);
+    }
+    else if (inputSource != nullptr)
     {
         in = inputSource->createInputStream();
         toDelete.reset (in);
@@ -356,10 +536,21 @@ void ZipFile::init()
         {
             auto size = (size_t) (in->getTotalLength() - centralDirectoryPos);
 
-            in->setPosition (centralDirectoryPos);
-            MemoryBlock headerData;
+            // When the file is mapped, the directory can be used where it is - otherwise
+            // it's kept in memory, and the entries are decoded from it when needed
+            if (mappedFile != nullptr)
+            {
+                centralDirectory = static_cast<const char*> (mappedFile->getData()) + centralDirectoryPos;
+            }
+            else
+            {
+                in->setPosition (centralDirectoryPos);
 
-            if (in->readIntoMemoryBlock (headerData, (ssize_t) size) == size)
+                if (in->readIntoMemoryBlock (centralDirectoryData, (ssize_t) size) == size)
+                    centralDirectory = static_cast<const char*> (centralDirectoryData.getData());
+            }
+
+            if (centralDirectory != nullptr)
             {
                 size_t pos = 0;
 
@@ -368,18 +559,21 @@ void ZipFile::init()
                     if (pos + 46 > size)
                         break;
 
-                    auto* buffer = static_cast<const char*> (headerData.getData()) + pos;
+                    auto* buffer = centralDirectory + pos;
                     auto fileNameLen = readUnalignedLittleEndianShort (buffer + 28u);
 
                     if (pos + 46 + fileNameLen > size)
                         break;
 
-                    entries.add (new ZipEntryHolder (buffer, fileNameLen));
+                    entryOffsets.add ((uint32) pos);
 
                     pos += 46u + fileNameLen
                             + readUnalignedLittleEndianShort (buffer + 30u)
                             + readUnalignedLittleEndianShort (buffer + 32u);
                 }
+
+                entries.resize ((size_t) entryOffsets.size());
+                buildFilenameHashTable();
             }
         }
     }
@@ -388,7 +582,7 @@ void ZipFile::init()
 Result ZipFile::uncompressTo (const File& targetDirectory,
                               const bool shouldOverwriteFiles)
 {
-    for (int i = 0; i < entries.size(); ++i)
+    for (int i = 0; i < getNumEntries(); ++i)
     {
         auto result = uncompressEntry (i, targetDirectory, shouldOverwriteFiles);
 
@@ -401,7 +595,8 @@ Result ZipFile::uncompressTo (const File& targetDirectory,
 
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool shouldOverwriteFiles)
 {
-    auto* zei = entries.getUnchecked (index);
+    auto* zei = getEntryHolder (index);
+    jassert (zei != nullptr);
 
    #if JUCE_WINDOWS
     auto entryPath = zei->entry.filename;
@@ -681,6 +876,88 @@ struct ZIPTests   : public UnitTest
             std::unique_ptr<InputStream> input (zip.createStreamForEntry (*entry));
             expectEquals (input->readEntireStreamAsString(), entryName);
         }
+
+        beginTest ("Memory-mapped");
+        {
+            ZipFile::Builder bigBuilder;
+            auto numEntries = 2000;
+
+            for (int i = 0; i < numEntries; ++i)
+            {
+                auto content = "content of entry " + String (i);
+                bigBuilder.addEntry (new MemoryInputStream (content.toRawUTF8(), content.getNumBytesAsUTF8(), true),
+                                     (i & 1) != 0 ? 6 : 0, "dir/" + String (numEntries - i), Time::getCurrentTime());
+            }
+
+            TemporaryFile tempFile (".zip");
+
+            {
+                FileOutputStream out (tempFile.getFile());
+                expect (bigBuilder.writeToStream (out, nullptr));
+            }
+
+            for (auto useMapping : { false, true })
+            {
+                ZipFile bigZip (tempFile.getFile(), useMapping);
+                expectEquals (bigZip.getNumEntries(), numEntries);
+
+                for (int i = 0; i < numEntries; i += 37)
+                {
+                    auto index = bigZip.getIndexOfFileName ("dir/" + String (numEntries - i));
+                    expectEquals (index, i);
+                    expectEquals (bigZip.getIndexOfFileName ("DIR/" + String (numEntries - i), true), i);
+
+                    auto expected = "content of entry " + String (i);
+                    std::unique_ptr<InputStream> input (bigZip.createStreamForEntry (index));
+                    expectEquals (input->readEntireStreamAsString(), expected);
+
+                    auto* mapped = static_cast<const char*> (bigZip.getMappedDataForEntry (index));
+                    expect ((mapped != nullptr) == (useMapping && (i & 1) == 0));
+
+                    if (mapped != nullptr)
+                        expectEquals (String::fromUTF8 (mapped, (int) bigZip.getEntry (index)->uncompressedSize), expected);
+                }
+
+                expectEquals (bigZip.getIndexOfFileName ("dir/0"), -1);
+                expectEquals (bigZip.getIndexOfFileName ("dir/" + String (numEntries + 1)), -1);
+
+                bigZip.sortEntriesByFilename();
+                auto index = bigZip.getIndexOfFileName ("dir/1000");
+                expectEquals (bigZip.getEntry (index)->filename, String ("dir/1000"));
+                expectEquals (bigZip.getEntry (index - 1)->filename, String ("dir/100"));
+            }
+        }
+
+        beginTest ("Names that aren't UTF-8");
+        {
+            ZipFile::Builder legacyBuilder;
+
+            for (auto* entryName : { "plain.txt", "caf#.txt", "na#ve.txt" })
+                legacyBuilder.addEntry (new MemoryInputStream (entryName, strlen (entryName), true),
+                                        0, entryName, Time::getCurrentTime());
+
+            MemoryBlock legacyData;
+            MemoryOutputStream legacyOut (legacyData, false);
+            legacyBuilder.writeToStream (legacyOut, nullptr);
+            legacyOut.flush();
+
+            // Replace the placeholders with CP437 characters, as an older zip tool would write them
+            auto* bytes = static_cast<char*> (legacyData.getData());
+
+            for (size_t i = 0; i + 7 < legacyData.getSize(); ++i)
+                if (bytes[i] == '#' && (memcmp (bytes + i + 1, ".txt", 4) == 0 || memcmp (bytes + i + 1, "ve.txt", 6) == 0))
+                    bytes[i] = (char) 0x82;
+
+            MemoryInputStream legacyInput (legacyData, false);
+            ZipFile legacyZip (legacyInput);
+            expectEquals (legacyZip.getNumEntries(), 3);
+
+            for (int i = 0; i < legacyZip.getNumEntries(); ++i)
+                expectEquals (legacyZip.getIndexOfFileName (legacyZip.getEntry (i)->filename), i);
+
+            expectEquals (legacyZip.getIndexOfFileName ("plain.txt"), 0);
+            expectEquals (legacyZip.getIndexOfFileName ("caf.txt"), -1);
+        }
     }
 };
 
@@ -30,6 +30,10 @@ namespace juce
     This can enumerate the items in a ZIP file and can create suitable stream objects
     to read each one.
 
+    Only the central directory is read when the file is opened - the details of each
+    entry are decoded the first time they're needed, and the first lookup by name builds
+    a hash table, so large archives with many entries can be opened and searched quickly.
+
     @tags{Core}
 */
 class JUCE_API  ZipFile
@@ -38,6 +42,17 @@ public:
     /** Creates a ZipFile to read a specific file. */
     explicit ZipFile (const File& file);
 
+    /** Creates a ZipFile to read a specific file, optionally memory-mapping it.
+
+        If useMemoryMapping is true, the whole file is mapped into the address space,
+        and the streams returned by createStreamForEntry() will read straight from the
+        mapped memory, without opening the file again or locking. It also makes
+        getMappedDataForEntry() available for entries that are stored uncompressed.
+
+        If the file can't be mapped, this falls back to the normal behaviour.
+    */
+    ZipFile (const File& file, bool useMemoryMapping);
+
     //==============================================================================
     /** Creates a ZipFile for a given stream.
 
@@ -104,6 +119,9 @@ public:
         This uses a case-sensitive comparison to look for a filename in the
         list of entries. It might return -1 if no match is found.
 
+        Case-sensitive lookups use a hash table which is built when the file is opened,
+        but if ignoreCase is true, this has to search through all the entries.
+
         @see ZipFile::ZipEntry
     */
     int getIndexOfFileName (const String& fileName, bool ignoreCase = false) const noexcept;
@@ -151,6 +169,17 @@ public:
     */
     InputStream* createStreamForEntry (const ZipEntry& entry);
 
+    /** Returns a pointer to the contents of an entry, without copying or decompressing it.
+
+        This is only possible if the ZipFile was created with memory-mapping enabled, and
+        the entry is stored in the archive without compression - otherwise it'll return
+        nullptr, and you'll need to use createStreamForEntry() instead.
+
+        If successful, the pointer refers to getEntry (index)->uncompressedSize bytes of
+        data, and it remains valid until the ZipFile is deleted.
+    */
+    const void* getMappedDataForEntry (int index) const;
+
     //==============================================================================
     /** Uncompresses all of the files in the zip file.
 
@@ -240,11 +269,17 @@ private:
     struct ZipInputStream;
     struct ZipEntryHolder;
 
-    OwnedArray<ZipEntryHolder> entries;
+    mutable std::vector<std::unique_ptr<ZipEntryHolder>> entries;
+    Array<uint32> entryOffsets;
+    MemoryBlock centralDirectoryData;
+    const char* centralDirectory = nullptr;
+    Array<int> filenameHashTable;
     CriticalSection lock;
+    mutable CriticalSection entryLock;
     InputStream* inputStream = nullptr;
     std::unique_ptr<InputStream> streamToDelete;
     std::unique_ptr<InputSource> inputSource;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
@@ -259,6 +294,9 @@ private:
    #endif
 
     void init();
+    ZipEntryHolder* getEntryHolder (int index) const;
+    const char* getMappedEntryData (const ZipEntryHolder&) const;
+    void buildFilenameHashTable();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipFile)
 };
@@ -34,8 +34,22 @@ RSAKey::RSAKey (const String& s)
 {
     if (s.containsChar (','))
     {
-        part1.parseString (s.upToFirstOccurrenceOf (",", false, false), 16);
-        part2.parseString (s.fromFirstOccurrenceOf (",", false, false), 16);
+        auto parts = StringArray::fromTokens (s, ",", {});
+
+        part1.parseString (parts[0], 16);
+        part2.parseString (parts[1], 16);
+
+        if (parts.size() == 4)
+        {
+            BigInteger p, q;
+            p.parseString (parts[2], 16);
+            q.parseString (parts[3], 16);
+
+            if (p * q == part2)
+                setPrimeFactors (p, q);
+            else
+                jassertfalse; // the prime factors don't match the modulus!
+        }
     }
     else
     {
@@ -63,9 +77,44 @@ bool RSAKey::isValid() const noexcept
     return operator!= (RSAKey());
 }
 
-String RSAKey::toString() const
+String RSAKey::toString (bool includePrimeFactors) const
 {
-    return part1.toString (16) + "," + part2.toString (16);
+    auto s = part1.toString (16) + "," + part2.toString (16);
+
+    if (includePrimeFactors && ! prime1.isZero())
+        s << "," << prime1.toString (16) << "," << prime2.toString (16);
+
+    return s;
+}
+
+void RSAKey::setPrimeFactors (const BigInteger& p, const BigInteger& q)
+{
+    // CRT parameters, as in PKCS #1: d mod (p - 1), d mod (q - 1) and (1 / q) mod p
+    prime1 = p;
+    prime2 = q;
+    exponent1 = part1 % (p - 1);
+    exponent2 = part1 % (q - 1);
+
+    // p is prime, so q^(p - 2) is the inverse of q. This is much quicker than
+    // BigInteger::inverseModulo(), whose GCD search can crawl when p and q are similar.
+    coefficient = q;
+    coefficient.exponentModulo (p - 2, p);
+}
+
+void RSAKey::applyUsingCRT (BigInteger& value) const
+{
+    auto m1 = value;
+    m1.exponentModulo (exponent1, prime1);
+
+    auto m2 = value;
+    m2.exponentModulo (exponent2, prime2);
+
+    auto h = ((m1 - m2) * coefficient) % prime1;
+
+    if (h.isNegative())
+        h += prime1;
+
+    value = m2 + h * prime2;
 }
 
 bool RSAKey::applyToValue (BigInteger& value) const
@@ -86,7 +135,10 @@ bool RSAKey::applyToValue (BigInteger& value) const
         BigInteger remainder;
         value.divideBy (part2, remainder);
 
-        remainder.exponentModulo (part1, part2);
+        if (prime1.isZero())
+            remainder.exponentModulo (part1, part2);
+        else
+            applyUsingCRT (remainder);
 
         result += remainder;
     }
@@ -131,11 +183,74 @@ void RSAKey::createKeyPair (RSAKey& publicKey, RSAKey& privateKey,
     BigInteger d (e);
     d.inverseModulo (m);
 
+    publicKey = RSAKey();
     publicKey.part1 = e;
     publicKey.part2 = n;
 
     privateKey.part1 = d;
     privateKey.part2 = n;
+    privateKey.setPrimeFactors (++p, ++q);
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RSAKeyTests  : public UnitTest
+{
+public:
+    RSAKeyTests()
+        : UnitTest ("RSAKey", UnitTestCategories::cryptography)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Key pairs");
+
+        auto r = getRandom();
+
+        for (auto numBits : { 64, 256, 512 })
+        {
+            RSAKey publicKey, privateKey;
+            RSAKey::createKeyPair (publicKey, privateKey, numBits);
+
+            // A key without its prime factors has to use the plain exponentiation
+            RSAKey privateKeyWithoutPrimes (privateKey.toString());
+            RSAKey privateKeyWithPrimes (privateKey.toString (true));
+
+            expect (privateKeyWithoutPrimes == privateKey);
+            expect (privateKeyWithPrimes == privateKey);
+            expectEquals (privateKeyWithPrimes.toString (true), privateKey.toString (true));
+            expectEquals (publicKey.toString (true), publicKey.toString());
+
+            for (int i = 0; i < 10; ++i)
+            {
+                BigInteger message;
+                r.fillBitsRandomly (message, 0, numBits * 3);
+                message.setBit (0);
+
+                auto encrypted = message;
+                expect (publicKey.applyToValue (encrypted));
+
+                auto decrypted = encrypted, decryptedWithoutCRT = encrypted;
+                expect (privateKey.applyToValue (decrypted));
+                expect (privateKeyWithoutPrimes.applyToValue (decryptedWithoutCRT));
+
+                expect (decrypted == message);
+                expect (decryptedWithoutCRT == message);
+
+                auto signature = message;
+                privateKeyWithPrimes.applyToValue (signature);
+                publicKey.applyToValue (signature);
+                expect (signature == message);
+            }
+        }
+    }
+};
+
+static RSAKeyTests rsaKeyUnitTests;
+
+#endif
+
 } // namespace juce
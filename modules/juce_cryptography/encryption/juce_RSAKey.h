@@ -104,6 +104,8 @@ public:
     /** Loads a key from an encoded string representation.
 
         This reloads a key from a string created by the toString() method.
+        If the string includes the key's prime factors, applyToValue() can use
+        the much faster CRT method.
     */
     explicit RSAKey (const String& stringRepresentation);
 
@@ -116,8 +118,13 @@ public:
     //==============================================================================
     /** Turns the key into a string representation.
         This can be reloaded using the constructor that takes a string.
+
+        If includePrimeFactors is true and this is a private key that knows the prime
+        factors of its modulus (i.e. one made by createKeyPair()), then these will
+        also be written, so that the reloaded key can use the faster CRT method. Note
+        that versions of JUCE that don't support this won't be able to load such a string.
     */
-    String toString() const;
+    String toString (bool includePrimeFactors = false) const;
 
     /** Returns true if the object is a valid key, or false if it was created by
         the default constructor.
@@ -137,6 +144,9 @@ public:
         and then try to decode it with a key that doesn't match, this method will still
         happily do its job and return true, but the result won't be what you were expecting.
         It's your responsibility to check that the result is what you wanted.
+
+        If this is a private key whose prime factors are known, the value is calculated
+        using the Chinese Remainder Theorem, which is around three times faster.
     */
     bool applyToValue (BigInteger& value) const;
 
@@ -167,6 +177,10 @@ protected:
 
 private:
     //==============================================================================
+    BigInteger prime1, prime2, exponent1, exponent2, coefficient;
+
+    void setPrimeFactors (const BigInteger& p, const BigInteger& q);
+    void applyUsingCRT (BigInteger& value) const;
     static BigInteger findBestCommonDivisor (const BigInteger& p, const BigInteger& q);
 
     JUCE_LEAK_DETECTOR (RSAKey)
@@ -26,51 +26,166 @@
 namespace juce
 {
 
-struct SHA256Processor
+static const uint32_t sha256Constants[] =
 {
-    // expects 64 bytes of data
-    void processFullBlock (const void* data) noexcept
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256InitialState[] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                               0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+struct SHA256Functions
+{
+    static uint32_t rotate (uint32_t x, uint32_t y) noexcept            { return (x >> y) | (x << (32 - y)); }
+    static uint32_t ch  (uint32_t x, uint32_t y, uint32_t z) noexcept   { return z ^ ((y ^ z) & x); }
+    static uint32_t maj (uint32_t x, uint32_t y, uint32_t z) noexcept   { return y ^ ((y ^ z) & (x ^ y)); }
+
+    static uint32_t s0 (uint32_t x) noexcept     { return rotate (x, 7)  ^ rotate (x, 18) ^ (x >> 3); }
+    static uint32_t s1 (uint32_t x) noexcept     { return rotate (x, 17) ^ rotate (x, 19) ^ (x >> 10); }
+    static uint32_t S0 (uint32_t x) noexcept     { return rotate (x, 2)  ^ rotate (x, 13) ^ rotate (x, 22); }
+    static uint32_t S1 (uint32_t x) noexcept     { return rotate (x, 6)  ^ rotate (x, 11) ^ rotate (x, 25); }
+
+    static uint32_t readBigEndian (const uint8_t* d) noexcept
     {
-        const uint32_t constants[] =
-        {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-        };
+        return (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
+    }
+};
 
-        uint32_t block[16], s[8];
-        memcpy (s, state, sizeof (s));
+//==============================================================================
+#if JUCE_USE_SHA_INTRINSICS
+ #if JUCE_INTEL
+  #if JUCE_MSVC
+   #define JUCE_SHA_TARGET
+  #else
+   #define JUCE_SHA_TARGET __attribute__ ((target ("sha,sse4.1")))
+  #endif
+
+// Uses the Intel SHA extensions to process a run of 64-byte blocks
+JUCE_SHA_TARGET static void processSHA256BlocksWithIntrinsics (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+{
+    const auto byteSwapMask = _mm_set_epi64x (0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
 
-        auto d = static_cast<const uint8_t*> (data);
+    // The rounds instructions need the state rearranged as ABEF and CDGH
+    auto cdab = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state)), 0xb1);
+    auto efgh = _mm_shuffle_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (state + 4)), 0x1b);
+    auto abef = _mm_alignr_epi8 (cdab, efgh, 8);
+    auto cdgh = _mm_blend_epi16 (efgh, cdab, 0xf0);
 
-        for (auto& b : block)
+    for (; numBlocks > 0; --numBlocks, data += 64)
+    {
+        const auto abefSaved = abef, cdghSaved = cdgh;
+        __m128i w[4];
+
+        for (int i = 0; i < 16; ++i)
         {
-            b = (uint32_t (d[0]) << 24) | (uint32_t (d[1]) << 16) | (uint32_t (d[2]) << 8) | d[3];
-            d += 4;
+            if (i < 4)
+            {
+                w[i] = _mm_shuffle_epi8 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (data + 16 * i)), byteSwapMask);
+            }
+            else
+            {
+                auto& oldest = w[i & 3];
+                const auto& newest = w[(i + 3) & 3];
+
+                oldest = _mm_sha256msg2_epu32 (_mm_add_epi32 (_mm_sha256msg1_epu32 (oldest, w[(i + 1) & 3]),
+                                                              _mm_alignr_epi8 (newest, w[(i + 2) & 3], 4)),
+                                               newest);
+            }
+
+            auto k = _mm_add_epi32 (w[i & 3], _mm_loadu_si128 (reinterpret_cast<const __m128i*> (sha256Constants + 4 * i)));
+            cdgh = _mm_sha256rnds2_epu32 (cdgh, abef, k);
+            abef = _mm_sha256rnds2_epu32 (abef, cdgh, _mm_shuffle_epi32 (k, 0x0e));
         }
 
-        auto convolve = [&] (uint32_t i, uint32_t j)
+        abef = _mm_add_epi32 (abef, abefSaved);
+        cdgh = _mm_add_epi32 (cdgh, cdghSaved);
+    }
+
+    auto feba = _mm_shuffle_epi32 (abef, 0x1b);
+    auto dchg = _mm_shuffle_epi32 (cdgh, 0xb1);
+
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (state),     _mm_blend_epi16 (feba, dchg, 0xf0));
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (state + 4), _mm_alignr_epi8 (dchg, feba, 8));
+}
+
+static bool canUseSHA256Intrinsics() noexcept   { return SystemStats::hasSHA() && SystemStats::hasSSE41(); }
+
+  #undef JUCE_SHA_TARGET
+ #else
+
+// Uses the ARMv8 cryptography extensions to process a run of 64-byte blocks
+static void processSHA256BlocksWithIntrinsics (uint32_t* state, const uint8_t* data, size_t numBlocks) noexcept
+{
+    auto abcd = vld1q_u32 (state);
+    auto efgh = vld1q_u32 (state + 4);
+
+    for (; numBlocks > 0; --numBlocks, data += 64)
+    {
+        const auto abcdSaved = abcd, efghSaved = efgh;
+        uint32x4_t w[4];
+
+        for (int i = 0; i < 16; ++i)
         {
-            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j]
-                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
-                                           : block[i]);
-            s[(3 - i) & 7] += s[(7 - i) & 7];
-            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
-        };
+            if (i < 4)
+                w[i] = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16 * i)));
+            else
+                w[i & 3] = vsha256su1q_u32 (vsha256su0q_u32 (w[i & 3], w[(i + 1) & 3]), w[(i + 2) & 3], w[(i + 3) & 3]);
+
+            auto k = vaddq_u32 (w[i & 3], vld1q_u32 (sha256Constants + 4 * i));
+            auto previousABCD = abcd;
+            abcd = vsha256hq_u32  (abcd, efgh, k);
+            efgh = vsha256h2q_u32 (efgh, previousABCD, k);
+        }
 
-        for (uint32_t j = 0; j < 64; j += 16)
-            for (uint32_t i = 0; i < 16; ++i)
-                convolve (i, j);
+        abcd = vaddq_u32 (abcd, abcdSaved);
+        efgh = vaddq_u32 (efgh, efghSaved);
+    }
 
-        for (int i = 0; i < 8; ++i)
-            state[i] += s[i];
+    vst1q_u32 (state, abcd);
+    vst1q_u32 (state + 4, efgh);
+}
+
+static bool canUseSHA256Intrinsics() noexcept   { return SystemStats::hasSHA(); }
+
+ #endif
+#else
+static void processSHA256BlocksWithIntrinsics (uint32_t*, const uint8_t*, size_t) noexcept  { jassertfalse; }
+static bool canUseSHA256Intrinsics() noexcept   { return false; }
+#endif
+
+//==============================================================================
+struct SHA256Processor  : private SHA256Functions
+{
+    SHA256Processor (bool allowHardwareAcceleration = true) noexcept
+        : useIntrinsics (allowHardwareAcceleration && canUseSHA256Intrinsics())
+    {
+    }
 
-        length += 64;
+    // expects 64 bytes of data
+    void processFullBlock (const void* data) noexcept
+    {
+        processFullBlocks (data, 1);
+    }
+
+    // expects numBlocks * 64 bytes of data
+    void processFullBlocks (const void* data, size_t numBlocks) noexcept
+    {
+        auto d = static_cast<const uint8_t*> (data);
+
+        if (useIntrinsics)
+            processSHA256BlocksWithIntrinsics (state, d, numBlocks);
+        else
+            for (size_t i = 0; i < numBlocks; ++i)
+                processBlockPortably (d + 64 * i);
+
+        length += 64 * (uint64_t) numBlocks;
     }
 
     void processFinalBlock (const void* data, uint32_t numBytes) noexcept
@@ -93,10 +208,7 @@ struct SHA256Processor
 
         jassert (numBytes == 64 || numBytes == 128);
 
-        processFullBlock (finalBlocks);
-
-        if (numBytes > 64)
-            processFullBlock (finalBlocks + 64);
+        processFullBlocks (finalBlocks, numBytes / 64);
     }
 
     void copyResult (uint8_t* result) const noexcept
@@ -110,42 +222,205 @@ struct SHA256Processor
         }
     }
 
+    void processData (const void* data, size_t numBytes, uint8_t* result) noexcept
+    {
+        auto numFullBlocks = numBytes / 64;
+        processFullBlocks (data, numFullBlocks);
+        processFinalBlock (static_cast<const uint8_t*> (data) + numFullBlocks * 64, (uint32_t) (numBytes % 64));
+        copyResult (result);
+    }
+
     void processStream (InputStream& input, int64_t numBytesToRead, uint8_t* result)
     {
         if (numBytesToRead < 0)
             numBytesToRead = std::numeric_limits<int64_t>::max();
 
+        // Reading in large chunks keeps the per-call stream overhead out of the way
+        // of the block function, which matters a lot for file streams.
+        constexpr int bufferSize = 64 * 1024;
+        HeapBlock<uint8_t> buffer (bufferSize);
+
         for (;;)
         {
-            uint8_t buffer[64];
-            auto bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64_t) sizeof (buffer)));
+            auto bytesWanted = (int) jmin (numBytesToRead, (int64_t) bufferSize);
+            int bytesRead = 0;
 
-            if (bytesRead < (int) sizeof (buffer))
+            while (bytesRead < bytesWanted)
             {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
-                break;
+                auto numRead = input.read (buffer + bytesRead, bytesWanted - bytesRead);
+
+                if (numRead <= 0)
+                    break;
+
+                bytesRead += numRead;
             }
 
-            numBytesToRead -= (int64_t) sizeof (buffer);
-            processFullBlock (buffer);
+            numBytesToRead -= bytesRead;
+
+            auto numFullBlocks = (size_t) bytesRead / 64;
+            processFullBlocks (buffer, numFullBlocks);
+
+            if (bytesRead < bufferSize)
+            {
+                processFinalBlock (buffer + numFullBlocks * 64, (uint32_t) bytesRead % 64);
+                break;
+            }
         }
 
         copyResult (result);
     }
 
 private:
-    uint32_t state[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-                          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    uint32_t state[8] = { sha256InitialState[0], sha256InitialState[1], sha256InitialState[2], sha256InitialState[3],
+                          sha256InitialState[4], sha256InitialState[5], sha256InitialState[6], sha256InitialState[7] };
     uint64_t length = 0;
+    const bool useIntrinsics;
 
-    static uint32_t rotate (uint32_t x, uint32_t y) noexcept            { return (x >> y) | (x << (32 - y)); }
-    static uint32_t ch  (uint32_t x, uint32_t y, uint32_t z) noexcept   { return z ^ ((y ^ z) & x); }
-    static uint32_t maj (uint32_t x, uint32_t y, uint32_t z) noexcept   { return y ^ ((y ^ z) & (x ^ y)); }
+    void processBlockPortably (const uint8_t* d) noexcept
+    {
+        uint32_t block[16], s[8];
+        memcpy (s, state, sizeof (s));
 
-    static uint32_t s0 (uint32_t x) noexcept     { return rotate (x, 7)  ^ rotate (x, 18) ^ (x >> 3); }
-    static uint32_t s1 (uint32_t x) noexcept     { return rotate (x, 17) ^ rotate (x, 19) ^ (x >> 10); }
-    static uint32_t S0 (uint32_t x) noexcept     { return rotate (x, 2)  ^ rotate (x, 13) ^ rotate (x, 22); }
-    static uint32_t S1 (uint32_t x) noexcept     { return rotate (x, 6)  ^ rotate (x, 11) ^ rotate (x, 25); }
+        for (auto& b : block)
+        {
+            b = readBigEndian (d);
+            d += 4;
+        }
+
+        auto convolve = [&] (uint32_t i, uint32_t j)
+        {
+            s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + sha256Constants[i + j]
+                                 + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15]))
+                                           : block[i]);
+            s[(3 - i) & 7] += s[(7 - i) & 7];
+            s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7]);
+        };
+
+        for (uint32_t j = 0; j < 64; j += 16)
+            for (uint32_t i = 0; i < 16; ++i)
+                convolve (i, j);
+
+        for (int i = 0; i < 8; ++i)
+            state[i] += s[i];
+    }
+};
+
+//==============================================================================
+/*  Hashes several independent messages at once, with each message occupying one
+    lane of a set of arrays. The inner loops all run across the lanes, so that the
+    compiler can map each of them onto a single SIMD instruction.
+*/
+template <size_t numLanes>
+struct SHA256MultiLaneProcessor  : private SHA256Functions
+{
+    SHA256MultiLaneProcessor() noexcept
+    {
+        for (size_t i = 0; i < 8; ++i)
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                state[i][lane] = sha256InitialState[i];
+    }
+
+    // Each of the block pointers must point to 64 bytes of data
+    void processBlocks (const uint8_t* const* blocks) noexcept
+    {
+        uint32_t w[64][numLanes], s[8][numLanes];
+
+        for (size_t i = 0; i < 16; ++i)
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                w[i][lane] = readBigEndian (blocks[lane] + 4 * i);
+
+        for (size_t i = 16; i < 64; ++i)
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                w[i][lane] = s1 (w[i - 2][lane]) + w[i - 7][lane] + s0 (w[i - 15][lane]) + w[i - 16][lane];
+
+        memcpy (s, state, sizeof (s));
+
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            auto& a = s[(0 - i) & 7];  auto& b = s[(1 - i) & 7];  auto& c = s[(2 - i) & 7];  auto& d = s[(3 - i) & 7];
+            auto& e = s[(4 - i) & 7];  auto& f = s[(5 - i) & 7];  auto& g = s[(6 - i) & 7];  auto& h = s[(7 - i) & 7];
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                h[lane] += S1 (e[lane]) + ch (e[lane], f[lane], g[lane]) + sha256Constants[i] + w[i][lane];
+                d[lane] += h[lane];
+                h[lane] += S0 (a[lane]) + maj (a[lane], b[lane], c[lane]);
+            }
+        }
+
+        for (size_t i = 0; i < 8; ++i)
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                state[i][lane] += s[i][lane];
+    }
+
+    void copyResult (size_t lane, uint8_t* result) const noexcept
+    {
+        for (auto& s : state)
+        {
+            *result++ = (uint8_t) (s[lane] >> 24);
+            *result++ = (uint8_t) (s[lane] >> 16);
+            *result++ = (uint8_t) (s[lane] >> 8);
+            *result++ = (uint8_t) s[lane];
+        }
+    }
+
+    /*  Hashes up to numLanes messages. Any lanes that aren't needed are fed a dummy
+        block, and any messages that finish early keep running but their results
+        are captured as soon as their last block is done.
+    */
+    static void processMessages (const void* const* messages, const size_t* sizes, size_t numMessages, uint8_t* const* results) noexcept
+    {
+        jassert (numMessages <= numLanes);
+
+        SHA256MultiLaneProcessor processor;
+        uint8_t finalBlocks[numLanes][128] = {};
+        size_t numDataBlocks[numLanes] = {}, numTotalBlocks[numLanes] = {};
+        size_t mostBlocks = 0;
+
+        for (size_t lane = 0; lane < numMessages; ++lane)
+        {
+            auto size = sizes[lane];
+            auto numBytesInFinalBlocks = size % 64;
+            numDataBlocks[lane] = size / 64;
+
+            if (numBytesInFinalBlocks > 0)
+                memcpy (finalBlocks[lane], static_cast<const uint8_t*> (messages[lane]) + size - numBytesInFinalBlocks, numBytesInFinalBlocks);
+
+            finalBlocks[lane][numBytesInFinalBlocks++] = 128;
+
+            auto numPaddedBytes = numBytesInFinalBlocks <= 56 ? (size_t) 64 : (size_t) 128;
+            auto lengthInBits = (uint64_t) size * 8;
+
+            for (int i = 0; i < 8; ++i)
+                finalBlocks[lane][numPaddedBytes - 1 - (size_t) i] = (uint8_t) (lengthInBits >> (i * 8));
+
+            numTotalBlocks[lane] = numDataBlocks[lane] + numPaddedBytes / 64;
+            mostBlocks = jmax (mostBlocks, numTotalBlocks[lane]);
+        }
+
+        const uint8_t* blocks[numLanes];
+
+        for (size_t blockIndex = 0; blockIndex < mostBlocks; ++blockIndex)
+        {
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                if (blockIndex < numDataBlocks[lane])
+                    blocks[lane] = static_cast<const uint8_t*> (messages[lane]) + 64 * blockIndex;
+                else if (blockIndex < numTotalBlocks[lane])
+                    blocks[lane] = finalBlocks[lane] + 64 * (blockIndex - numDataBlocks[lane]);
+                else
+                    blocks[lane] = finalBlocks[0];
+            }
+
+            processor.processBlocks (blocks);
+
+            for (size_t lane = 0; lane < numMessages; ++lane)
+                if (blockIndex + 1 == numTotalBlocks[lane])
+                    processor.copyResult (lane, results[lane]);
+        }
+    }
+
+    uint32_t state[8][numLanes];
 };
 
 //==============================================================================
@@ -193,9 +468,52 @@ SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
 
 void SHA256::process (const void* data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     SHA256Processor processor;
-    processor.processStream (m, -1, result);
+    processor.processData (data, numBytes, result);
+}
+
+void SHA256::createHashes (const void* const* dataBlocks, const size_t* blockSizes, size_t numBlocks, SHA256* results)
+{
+    jassert (numBlocks == 0 || (dataBlocks != nullptr && blockSizes != nullptr && results != nullptr));
+
+    if (isHardwareAccelerated())
+    {
+        for (size_t i = 0; i < numBlocks; ++i)
+            results[i].process (dataBlocks[i], blockSizes[i]);
+
+        return;
+    }
+
+    // Sorting by size means that the messages sharing a set of lanes will mostly
+    // need the same number of blocks, so very few lanes end up idling.
+    std::vector<size_t> order (numBlocks);
+    std::iota (order.begin(), order.end(), (size_t) 0);
+    std::sort (order.begin(), order.end(), [blockSizes] (size_t a, size_t b) { return blockSizes[a] < blockSizes[b]; });
+
+    constexpr size_t numLanes = 8;
+
+    for (size_t start = 0; start < numBlocks; start += numLanes)
+    {
+        auto numInGroup = jmin (numLanes, numBlocks - start);
+        const void* groupData[numLanes];
+        size_t groupSizes[numLanes];
+        uint8_t* groupResults[numLanes];
+
+        for (size_t i = 0; i < numInGroup; ++i)
+        {
+            auto index = order[start + i];
+            groupData[i] = dataBlocks[index];
+            groupSizes[i] = blockSizes[index];
+            groupResults[i] = results[index].result;
+        }
+
+        SHA256MultiLaneProcessor<numLanes>::processMessages (groupData, groupSizes, numInGroup, groupResults);
+    }
+}
+
+bool SHA256::isHardwareAccelerated() noexcept
+{
+    return canUseSHA256Intrinsics();
 }
 
 MemoryBlock SHA256::getRawData() const
@@ -242,6 +560,14 @@ public:
         }
     }
 
+    static String hashPortably (const void* data, size_t numBytes)
+    {
+        uint8_t result[32];
+        SHA256Processor processor (false);
+        processor.processData (data, numBytes, result);
+        return String::toHexString (result, sizeof (result), 0);
+    }
+
     void runTest() override
     {
         beginTest ("SHA256");
@@ -249,6 +575,47 @@ public:
         test ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
         test ("The quick brown fox jumps over the lazy dog",  "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
         test ("The quick brown fox jumps over the lazy dog.", "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+
+        auto r = getRandom();
+        MemoryBlock data (70000);
+
+        for (size_t i = 0; i < data.getSize(); ++i)
+            data[i] = (char) r.nextInt (256);
+
+        beginTest ("Accelerated and portable implementations agree");
+        {
+            for (auto size : { 0, 1, 55, 56, 63, 64, 65, 119, 128, 1000, 65535, 65536, 70000 })
+            {
+                SHA256 hash (data.getData(), (size_t) size);
+                expectEquals (hash.toHexString(), hashPortably (data.getData(), (size_t) size));
+
+                MemoryInputStream m (data.getData(), (size_t) size, false);
+                expect (SHA256 (m) == hash);
+            }
+        }
+
+        beginTest ("Multiple hashes");
+        {
+            constexpr int numItems = 37;
+            const void* items[numItems];
+            size_t sizes[numItems];
+            SHA256 results[numItems];
+
+            for (int i = 0; i < numItems; ++i)
+            {
+                sizes[i] = (size_t) r.nextInt (300);
+                items[i] = addBytesToPointer (data.getData(), r.nextInt (1000));
+            }
+
+            SHA256::createHashes (items, sizes, (size_t) numItems, results);
+
+            for (int i = 0; i < numItems; ++i)
+                expectEquals (results[i].toHexString(), hashPortably (items[i], sizes[i]));
+
+            SHA256 empty;
+            SHA256::createHashes (nullptr, nullptr, 0, &empty);
+            expect (empty == SHA256());
+        }
     }
 };
 
@@ -92,6 +92,27 @@ public:
     /** Returns the checksum as a 64-digit hex string. */
     String toHexString() const;
 
+    //==============================================================================
+    /** Calculates the hashes of a set of independent blocks of data in one go.
+
+        If you've got lots of small items to hash, this is considerably faster than
+        creating an SHA256 for each of them, as the blocks are hashed in parallel
+        across the lanes of the CPU's vector registers (or with the dedicated SHA
+        instructions if the CPU has them).
+
+        @param dataBlocks   an array of numBlocks pointers to the data to hash
+        @param blockSizes   an array of numBlocks sizes, in bytes
+        @param numBlocks    the number of blocks to hash
+        @param results      an array of numBlocks objects that will be filled with the hashes
+    */
+    static void createHashes (const void* const* dataBlocks, const size_t* blockSizes,
+                              size_t numBlocks, SHA256* results);
+
+    /** Returns true if the hash is calculated using the CPU's SHA instructions
+        (i.e. the Intel SHA extensions or the ARMv8 cryptography extensions).
+    */
+    static bool isHardwareAccelerated() noexcept;
+
     //==============================================================================
     bool operator== (const SHA256&) const noexcept;
     bool operator!= (const SHA256&) const noexcept;
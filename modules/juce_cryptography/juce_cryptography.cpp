@@ -34,6 +34,24 @@
 
 #include "juce_cryptography.h"
 
+#ifndef JUCE_USE_SHA_INTRINSICS
+ #if JUCE_INTEL && (JUCE_MSVC || JUCE_GCC || JUCE_CLANG)
+  #define JUCE_USE_SHA_INTRINSICS 1
+ #elif JUCE_ARM && (defined (__ARM_FEATURE_CRYPTO) || defined (__ARM_FEATURE_SHA2))
+  #define JUCE_USE_SHA_INTRINSICS 1
+ #else
+  #define JUCE_USE_SHA_INTRINSICS 0
+ #endif
+#endif
+
+#if JUCE_USE_SHA_INTRINSICS
+ #if JUCE_INTEL
+  #include <immintrin.h>
+ #else
+  #include <arm_neon.h>
+ #endif
+#endif
+
 #include "encryption/juce_BlowFish.cpp"
 #include "encryption/juce_Primes.cpp"
 #include "encryption/juce_RSAKey.cpp"
@@ -468,6 +468,12 @@ public:
     template <typename OtherSampleType, typename SmoothingType>
     const AudioBlock& replaceWithProductOf (AudioBlock<OtherSampleType> src, SmoothedValue<SampleType, SmoothingType>& value) const noexcept   { replaceWithProductOfInternal (src, value); return *this; }
 
+    /** Multiplies each value in src by a smoothed value and adds the result to this block. */
+    template <typename OtherSampleType, typename SmoothingType>
+    AudioBlock&       addProductOf (AudioBlock<OtherSampleType> src, SmoothedValue<SampleType, SmoothingType>& value)       noexcept   { addProductOfInternal (src, value); return *this; }
+    template <typename OtherSampleType, typename SmoothingType>
+    const AudioBlock& addProductOf (AudioBlock<OtherSampleType> src, SmoothedValue<SampleType, SmoothingType>& value) const noexcept   { addProductOfInternal (src, value); return *this; }
+
     //==============================================================================
     /** Multiplies each value in src by a fixed value and adds the result to this block. */
     template <typename OtherSampleType>
@@ -765,13 +771,16 @@ private:
         }
         else
         {
-            for (size_t i = 0; i < numSamples; ++i)
+            processWithSmoothedValue (value, numSamples, [this] (const SampleType* gains, size_t start, size_t num)
             {
-                const auto scaler = value.getNextValue();
-
                 for (size_t ch = 0; ch < numChannels; ++ch)
-                    getDataPointer (ch)[i] *= scaler;
-            }
+                {
+                    auto* dst = getDataPointer (ch) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        dst[i] *= gains[i];
+                }
+            });
         }
     }
 
@@ -788,13 +797,59 @@ private:
         {
             auto n = jmin (numSamples, src.numSamples) * sizeFactor;
 
-            for (size_t i = 0; i < n; ++i)
+            processWithSmoothedValue (value, n, [this, &src] (const SampleType* gains, size_t start, size_t num)
             {
-                const auto scaler = value.getNextValue();
+                for (size_t ch = 0; ch < numChannels; ++ch)
+                {
+                    auto* dst = getDataPointer (ch) + start;
+                    auto* srcData = src.getChannelPointer (ch) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        dst[i] = gains[i] * srcData[i];
+                }
+            });
+        }
+    }
+
+    template <typename OtherSampleType, typename SmoothingType>
+    void addProductOfInternal (AudioBlock<OtherSampleType> src, SmoothedValue<SampleType, SmoothingType>& value) const noexcept
+    {
+        jassert (numChannels == src.numChannels);
+
+        if (! value.isSmoothing())
+        {
+            addProductOfInternal (src, value.getTargetValue());
+        }
+        else
+        {
+            auto n = jmin (numSamples, src.numSamples) * sizeFactor;
 
+            processWithSmoothedValue (value, n, [this, &src] (const SampleType* gains, size_t start, size_t num)
+            {
                 for (size_t ch = 0; ch < numChannels; ++ch)
-                    getDataPointer (ch)[i] = scaler * src.getChannelPointer (ch)[i];
-            }
+                {
+                    auto* dst = getDataPointer (ch) + start;
+                    auto* srcData = src.getChannelPointer (ch) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        dst[i] += gains[i] * srcData[i];
+                }
+            });
+        }
+    }
+
+    // Renders the smoothed value's ramp in chunks, and passes each one to the callback
+    template <typename SmoothingType, typename Callback>
+    static void processWithSmoothedValue (SmoothedValue<SampleType, SmoothingType>& value, size_t num, Callback&& callback) noexcept
+    {
+        SampleType gains[256];
+
+        for (size_t start = 0; start < num;)
+        {
+            auto numThisTime = jmin (num - start, (size_t) numElementsInArray (gains));
+            value.getNextValues (gains, (int) numThisTime);
+            callback (gains, start, numThisTime);
+            start += numThisTime;
         }
     }
 
@@ -426,6 +426,16 @@ private:
         expect (block.getSample (1, 2) > (SampleType) 0.0);
         expectEquals (block.getSample (0, 5), (SampleType) 0.0);
         expectEquals (block.getSample (1, 5), (SampleType) 0.0);
+
+        sv.setCurrentAndTargetValue (0.0f);
+        sv.setTargetValue (1.0f);
+        block.fill ((SampleType) 1.0);
+        otherBlock.fill ((SampleType) 2.0);
+        block.addProductOf (otherBlock, sv);
+        expect (block.getSample (0, 2) > (SampleType) 1.0);
+        expect (block.getSample (1, 2) < (SampleType) 3.0);
+        expectEquals (block.getSample (0, 5), (SampleType) 3.0);
+        expectEquals (block.getSample (1, 5), (SampleType) 3.0);
     }
 
     template <typename T = SampleType>
@@ -180,7 +180,14 @@ struct ConvolutionEngine
         updateSegmentsIfNecessary (numInputSegments, buffersInputSegments);
         updateSegmentsIfNecessary (numSegments,      buffersImpulseSegments);
 
-        auto FFTTempObject = std::make_unique<FFT> (roundToInt (std::log2 (fftSize)));
+        loadImpulseResponse (samples, numSamples);
+        reset();
+    }
+
+    // Replaces the impulse response without allocating or clearing the input history.
+    // The new response mustn't be longer than the one the engine was created with.
+    void loadImpulseResponse (const float* samples, size_t numSamples) noexcept
+    {
         size_t currentPtr = 0;
 
         for (auto& buf : buffersImpulseSegments)
@@ -192,17 +199,16 @@ struct ConvolutionEngine
             if (&buf == &buffersImpulseSegments.front())
                 impulseResponse[0] = 1.0f;
 
-            FloatVectorOperations::copy (impulseResponse,
-                                         samples + currentPtr,
-                                         static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+            if (currentPtr < numSamples)
+                FloatVectorOperations::copy (impulseResponse,
+                                             samples + currentPtr,
+                                             static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
+            fftObject->performRealOnlyForwardTransform (impulseResponse);
             prepareForConvolution (impulseResponse);
 
             currentPtr += (fftSize - blockSize);
         }
-
-        reset();
     }
 
     void reset()
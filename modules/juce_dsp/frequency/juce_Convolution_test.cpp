@@ -571,6 +571,60 @@ public:
 
 ConvolutionTest convolutionUnitTest;
 
+//==============================================================================
+class ConvolutionBenchmarks  : public UnitTest
+{
+public:
+    ConvolutionBenchmarks()
+        : UnitTest ("Convolution benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        const ProcessSpec spec { 44100.0, 512, 2 };
+
+        AudioBuffer<float> ir (2, 44100);
+        AudioBuffer<float> buffer (2, 44100);
+        auto random = getRandom();
+
+        for (auto* b : { &ir, &buffer })
+            for (auto channel = 0; channel != b->getNumChannels(); ++channel)
+                for (auto sample = 0; sample != b->getNumSamples(); ++sample)
+                    b->setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+        const auto processOneSecond = [&] (Convolution& convolution)
+        {
+            for (auto start = 0; start < buffer.getNumSamples(); start += (int) spec.maximumBlockSize)
+            {
+                auto numSamples = jmin ((int) spec.maximumBlockSize, buffer.getNumSamples() - start);
+                auto block = AudioBlock<float> (buffer).getSubBlock ((size_t) start, (size_t) numSamples);
+                convolution.process (ProcessContextReplacing<float> (block));
+            }
+        };
+
+        const auto makeConvolution = [&] (std::unique_ptr<Convolution> convolution)
+        {
+            convolution->loadImpulseResponse (AudioBuffer<float> (ir), spec.sampleRate,
+                                              Convolution::Stereo::yes, Convolution::Trim::no,
+                                              Convolution::Normalise::yes);
+            convolution->prepare (spec);
+            processOneSecond (*convolution); // makes sure the IR has been loaded
+            return convolution;
+        };
+
+        beginTest ("One second of stereo audio through a one second IR");
+        {
+            auto uniform = makeConvolution (std::make_unique<Convolution>());
+            benchmark ("Uniform", [&] { processOneSecond (*uniform); }, 10, 2);
+
+            auto nonUniform = makeConvolution (std::make_unique<Convolution> (Convolution::NonUniform { 256 }));
+            benchmark ("Non-uniform, 256 sample head", [&] { processOneSecond (*nonUniform); }, 10, 2);
+        }
+    }
+};
+
+ConvolutionBenchmarks convolutionBenchmarks;
+
 }
 }
 }
@@ -210,5 +210,62 @@ struct FFTUnitTest  : public UnitTest
 
 static FFTUnitTest fftUnitTest;
 
+//==============================================================================
+struct FFTBenchmarks  : public UnitTest
+{
+    FFTBenchmarks()
+        : UnitTest ("FFT benchmarks", UnitTestCategories::benchmarks)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        for (auto order : { 8, 10, 12 })
+        {
+            const auto n = (size_t) 1 << order;
+            FFT fft (order);
+
+            HeapBlock<Complex<float>> input (n), output (n);
+            HeapBlock<float> realInput (2 * n), realData (2 * n);
+
+            FFTUnitTest::fillRandom (random, input.getData(), n);
+            FFTUnitTest::fillRandom (random, realInput.getData(), n);
+
+            // Each timed iteration runs enough transforms to be well above the timer's resolution
+            const auto numTransforms = (int) (65536 / n);
+
+            const auto timeRealTransforms = [&] (auto&& transform)
+            {
+                for (int i = 0; i < numTransforms; ++i)
+                {
+                    std::copy (realInput.getData(), realInput.getData() + n, realData.getData());
+                    transform (realData.getData());
+                }
+            };
+
+            beginTest ("Order " + String (order));
+
+            benchmark ("Complex forward", [&]
+            {
+                for (int i = 0; i < numTransforms; ++i)
+                    fft.perform (input.getData(), output.getData(), false);
+            });
+
+            benchmark ("Real forward", [&]
+            {
+                timeRealTransforms ([&] (float* data) { fft.performRealOnlyForwardTransform (data); });
+            });
+
+            benchmark ("Frequency only", [&]
+            {
+                timeRealTransforms ([&] (float* data) { fft.performFrequencyOnlyForwardTransform (data); });
+            });
+        }
+    }
+};
+
+static FFTBenchmarks fftBenchmarks;
+
 } // namespace dsp
 } // namespace juce
@@ -57,13 +57,13 @@
  #include <ipps.h>
 #endif
 
-#include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
 #include "processors/juce_FirstOrderTPTFilter.cpp"
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
 #include "processors/juce_BallisticsFilter.cpp"
 #include "processors/juce_LinkwitzRileyFilter.cpp"
+#include "processors/juce_MultibandCrossover.cpp"
 #include "processors/juce_DelayLine.cpp"
 #include "processors/juce_DryWetMixer.cpp"
 #include "processors/juce_StateVariableTPTFilter.cpp"
@@ -72,9 +72,12 @@
 #include "maths/juce_LookupTable.cpp"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
+#include "processors/juce_FIRFilter.cpp"
+#include "processors/juce_FIRMultirate.cpp"
 #include "frequency/juce_Windowing.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
+#include "widgets/juce_FilterBanks.cpp"
 #include "widgets/juce_Compressor.cpp"
 #include "widgets/juce_NoiseGate.cpp"
 #include "widgets/juce_Limiter.cpp"
@@ -108,5 +111,9 @@
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_FIRMultirate_test.cpp"
+ #include "processors/juce_MultibandCrossover_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "widgets/juce_Compressor_test.cpp"
+ #include "widgets/juce_FilterBanks_test.cpp"
 #endif
@@ -250,6 +250,7 @@ namespace juce
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_FIRFilter.h"
+#include "processors/juce_FIRMultirate.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
 #include "processors/juce_Panner.h"
@@ -257,6 +258,7 @@ namespace juce
 #include "processors/juce_Oversampling.h"
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
+#include "processors/juce_MultibandCrossover.h"
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
 #include "frequency/juce_FFT.h"
@@ -269,6 +271,8 @@ namespace juce
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
 #include "widgets/juce_LadderFilter.h"
+#include "widgets/juce_FilterBanks.h"
+#include "widgets/juce_DynamicsHelpers.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
 #include "widgets/juce_Limiter.h"
@@ -108,6 +108,41 @@ SampleType BallisticsFilter<SampleType>::processSample (int channel, SampleType
     return result;
 }
 
+template <typename SampleType>
+void BallisticsFilter<SampleType>::processSamples (int channel, const SampleType* input,
+                                                  SampleType* output, size_t numSamples) noexcept
+{
+    jassert (isPositiveAndBelow (channel, yold.size()));
+
+    auto y = yold[(size_t) channel];
+
+    if (levelType == LevelCalculationType::RMS)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto x = input[i] * input[i];
+            y = x + (x > y ? cteAT : cteRL) * (y - x);
+            output[i] = y;
+        }
+
+        yold[(size_t) channel] = y;
+
+        for (size_t i = 0; i < numSamples; ++i)
+            output[i] = std::sqrt (output[i]);
+    }
+    else
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto x = std::abs (input[i]);
+            y = x + (x > y ? cteAT : cteRL) * (y - x);
+            output[i] = y;
+        }
+
+        yold[(size_t) channel] = y;
+    }
+}
+
 template <typename SampleType>
 void BallisticsFilter<SampleType>::snapToZero() noexcept
 {
@@ -113,13 +113,8 @@ public:
         }
 
         for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
-        }
+            processSamples ((int) channel, inputBlock.getChannelPointer (channel),
+                            outputBlock.getChannelPointer (channel), numSamples);
 
        #if JUCE_SNAP_TO_ZERO
         snapToZero();
@@ -129,6 +124,11 @@ public:
     /** Processes one sample at a time on a given channel. */
     SampleType processSample (int channel, SampleType inputValue);
 
+    /** Processes a block of samples on a given channel. The input and output
+        pointers may refer to the same data.
+    */
+    void processSamples (int channel, const SampleType* input, SampleType* output, size_t numSamples) noexcept;
+
     /** Ensure that the state variables are rounded to zero if the state
         variables are denormals. This is only needed if you are doing
         sample by sample processing.
@@ -28,6 +28,66 @@ namespace juce
 namespace dsp
 {
 
+//==============================================================================
+struct FIR::FFTConvolver::Impl
+{
+    // The partition size trades the cost of the FFTs done on every call against
+    // the number of partitions that have to be multiplied for each block.
+    static constexpr size_t partitionSize = 256;
+
+    explicit Impl (size_t maxNumCoefficients)
+        : loadedCoefficients (maxNumCoefficients, true),
+          maxSize (maxNumCoefficients),
+          engine (loadedCoefficients.get(), maxNumCoefficients, partitionSize)
+    {}
+
+    HeapBlock<float> loadedCoefficients;
+    size_t maxSize, numLoaded = 0;
+    ConvolutionEngine engine;
+};
+
+FIR::FFTConvolver::FFTConvolver (size_t maxNumCoefficients)
+    : impl (std::make_unique<Impl> (maxNumCoefficients))
+{
+}
+
+FIR::FFTConvolver::~FFTConvolver() = default;
+
+size_t FIR::FFTConvolver::getMaximumNumCoefficients() const noexcept
+{
+    return impl->maxSize;
+}
+
+bool FIR::FFTConvolver::setCoefficients (const float* coefficients, size_t numCoefficients) noexcept
+{
+    if (numCoefficients > impl->maxSize)
+        return false;
+
+    // The copy lets changes be detected even when the caller edits its coefficients in place
+    auto* loaded = impl->loadedCoefficients.get();
+
+    if (numCoefficients != impl->numLoaded
+         || memcmp (loaded, coefficients, numCoefficients * sizeof (float)) != 0)
+    {
+        memcpy (loaded, coefficients, numCoefficients * sizeof (float));
+        impl->numLoaded = numCoefficients;
+        impl->engine.loadImpulseResponse (loaded, numCoefficients);
+    }
+
+    return true;
+}
+
+void FIR::FFTConvolver::reset() noexcept
+{
+    impl->engine.reset();
+}
+
+void FIR::FFTConvolver::process (const float* input, float* output, size_t numSamples) noexcept
+{
+    impl->engine.processSamples (input, output, numSamples);
+}
+
+//==============================================================================
 template <typename NumericType>
 double FIR::Coefficients<NumericType>::Coefficients::getMagnitudeForFrequency (double frequency, double theSampleRate) const noexcept
 {
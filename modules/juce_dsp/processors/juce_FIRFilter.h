@@ -36,15 +36,48 @@ namespace FIR
     template <typename NumericType>
     struct Coefficients;
 
+   #ifndef DOXYGEN
+    /** Internal class used by Filter to convolve long sets of float coefficients
+        in the frequency domain, using uniformly partitioned FFT convolution with
+        zero latency.
+
+        All of the memory is allocated by the constructor, so new coefficients can be
+        loaded on the audio thread, as long as there aren't more than the maximum.
+    */
+    class FFTConvolver
+    {
+    public:
+        explicit FFTConvolver (size_t maxNumCoefficients);
+        ~FFTConvolver();
+
+        size_t getMaximumNumCoefficients() const noexcept;
+
+        /** Loads a set of coefficients, keeping the input history. This does nothing if they
+            match the ones already loaded, and returns false if there are too many of them.
+        */
+        bool setCoefficients (const float* coefficients, size_t numCoefficients) noexcept;
+
+        void reset() noexcept;
+        void process (const float* input, float* output, size_t numSamples) noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+
+        JUCE_DECLARE_NON_COPYABLE (FFTConvolver)
+    };
+   #endif
+
     //==============================================================================
     /**
         A processing class that can perform FIR filtering on an audio signal, in the
         time domain.
 
         Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        samples. When processing blocks of float samples, longer filters can be
+        convolved in the frequency domain instead, with no added latency - see
+        setFFTThreshold(). For impulse responses that need to be resampled, or
+        loaded from files, use the class Convolution instead.
 
         @see FIRFilter::Coefficients, Convolution, FFT
 
@@ -83,6 +116,7 @@ namespace FIR
             jassert (spec.numChannels == 1);
             ignoreUnused (spec);
             reset();
+            createConvolver();
         }
 
         /** Resets the filter's processing pipeline, ready to start a new stream of data.
@@ -92,6 +126,9 @@ namespace FIR
         */
         void reset()
         {
+            if (convolver != nullptr)
+                convolver->reset();
+
             if (coefficients != nullptr)
             {
                 auto newSize = coefficients->getFilterOrder() + 1;
@@ -109,6 +146,28 @@ namespace FIR
             }
         }
 
+        /** Makes process() use FFT convolution for sets of at least this many coefficients,
+            which is much faster for long filters. A threshold of 256 is a good starting
+            point. The default is 0, which always uses direct convolution.
+
+            This only applies to filters that process float samples. The memory needed is
+            allocated here and in prepare(), for the number of coefficients in use at that
+            time. Coefficients that are replaced or edited with the same or a smaller size
+            are then reloaded by process() without allocating, but a longer set will be
+            processed with direct convolution until prepare() is called again. Note that
+            processSample() always uses direct convolution, so it shouldn't be mixed with
+            calls to process().
+        */
+        void setFFTThreshold (size_t newThreshold)
+        {
+            fftThreshold = newThreshold;
+            reset();
+            createConvolver();
+        }
+
+        /** Returns true if process() is currently using FFT convolution. */
+        bool isUsingFFT() const noexcept    { return convolver != nullptr && useConvolver; }
+
         //==============================================================================
         /** The coefficients of the FIR filter. It's up to the caller to ensure that
             these coefficients are modified in a thread-safe way.
@@ -126,6 +185,7 @@ namespace FIR
             static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
                            "The sample-type of the FIR filter must match the sample-type supplied to this process callback");
             check();
+            updateConvolver();
 
             auto&& inputBlock  = context.getInputBlock();
             auto&& outputBlock = context.getOutputBlock();
@@ -149,6 +209,13 @@ namespace FIR
                     fifo[p] = dst[i] = src[i];
                     p = (p == 0 ? size - 1 : p - 1);
                 }
+
+                if (useConvolver)
+                    convolver->reset();
+            }
+            else if (useConvolver)
+            {
+                processWithConvolver (*convolver, src, dst, numSamples);
             }
             else
             {
@@ -162,6 +229,9 @@ namespace FIR
 
         /** Processes a single sample, without any locking.
             Use this if you need processing of a single value.
+
+            This always uses direct convolution, so it shouldn't be mixed with calls to
+            process() on a filter that uses FFT convolution.
         */
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
@@ -175,6 +245,10 @@ namespace FIR
         SampleType* fifo = nullptr;
         size_t pos = 0, size = 0;
 
+        std::unique_ptr<FFTConvolver> convolver;
+        size_t fftThreshold = 0;
+        bool useConvolver = false;
+
         //==============================================================================
         void check()
         {
@@ -184,6 +258,47 @@ namespace FIR
                 reset();
         }
 
+        // FFT convolution is only available for float samples
+        void createConvolver()
+        {
+            convolver.reset();
+            useConvolver = false;
+
+            if (std::is_same<SampleType, float>::value && fftThreshold > 0
+                 && coefficients != nullptr && size >= fftThreshold)
+            {
+                convolver = std::make_unique<FFTConvolver> (size);
+                updateConvolver();
+            }
+        }
+
+        // Picks up any new or edited coefficients, without allocating
+        void updateConvolver() noexcept
+        {
+            if (convolver != nullptr)
+                useConvolver = size >= fftThreshold
+                                && loadConvolverCoefficients (*convolver, coefficients->getRawCoefficients(), size);
+        }
+
+        static bool loadConvolverCoefficients (FFTConvolver& c, const float* fir, size_t numCoefficients) noexcept
+        {
+            return c.setCoefficients (fir, numCoefficients);
+        }
+
+        template <typename OtherNumericType>
+        static bool loadConvolverCoefficients (FFTConvolver&, const OtherNumericType*, size_t) noexcept    { return false; }
+
+        static void processWithConvolver (FFTConvolver& c, const float* src, float* dst, size_t numSamples) noexcept
+        {
+            c.process (src, dst, numSamples);
+        }
+
+        template <typename OtherSampleType>
+        static void processWithConvolver (FFTConvolver&, const OtherSampleType*, OtherSampleType*, size_t) noexcept
+        {
+            jassertfalse;
+        }
+
         static SampleType JUCE_VECTOR_CALLTYPE processSingleSample (SampleType sample, SampleType* buf,
                                                                     const NumericType* fir, size_t m, size_t& p) noexcept
         {
@@ -213,6 +213,118 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        beginTest ("Long filters use FFT convolution");
+        {
+            Random random (8392829);
+
+            for (auto size : { 256, 1000, 4097 })
+            {
+                constexpr size_t n = 5000;
+
+                HeapBlock<float> input (n), output (n), ref (n), fir ((size_t) size);
+                fillRandom (random, input.get(), n);
+                fillRandom (random, fir.get(), (size_t) size);
+
+                FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir.get(), (size_t) size));
+                filter.prepare ({ 0.0, n, 1 });
+                expect (! filter.isUsingFFT());
+
+                filter.setFFTThreshold (256);
+                expect (filter.isUsingFFT());
+
+                reference<float, float> (fir.get(), (size_t) size, input.get(), ref.get(), n);
+
+                // blocks that don't line up with the FFT partitions
+                for (size_t start = 0, blockSize = 1; start < n; start += blockSize, blockSize = blockSize * 3 + 1)
+                {
+                    auto* src = input.get() + start;
+                    auto* dst = output.get() + start;
+                    const auto len = jmin (blockSize, n - start);
+
+                    AudioBlock<const float> inBlock (&src, 1, len);
+                    AudioBlock<float> outBlock (&dst, 1, len);
+                    filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+                }
+
+                // the error grows with the number of coefficients being summed
+                for (size_t i = 0; i < n; ++i)
+                    expectWithinAbsoluteError (output[i], ref[i], 1.0e-3f);
+
+                filter.setFFTThreshold (0);
+                expect (! filter.isUsingFFT());
+            }
+        }
+
+        beginTest ("FFT convolution picks up swapped and edited coefficients");
+        {
+            Random random (1234567);
+
+            constexpr size_t n = 9000, numCoefficients = 1000, swapPos = 3000, editPos = 6000;
+
+            // The convolver keeps its input history, but the output needs up to two
+            // partitions of 256 samples to move over to the new coefficients
+            constexpr size_t settleTime = 512;
+
+            HeapBlock<float> input (n), output (n), ref (n);
+            fillRandom (random, input.get(), n);
+
+            auto makeCoefficients = [&random] (size_t size) -> FIR::Coefficients<float>::Ptr
+            {
+                FIR::Coefficients<float>::Ptr result = new FIR::Coefficients<float> (size);
+                fillRandom (random, result->getRawCoefficients(), size);
+                return result;
+            };
+
+            auto first = makeCoefficients (numCoefficients);
+            FIR::Filter<float> filter (first);
+            filter.setFFTThreshold (256);
+            filter.prepare ({ 0.0, 300, 1 });
+
+            auto processRange = [&] (size_t start, size_t end)
+            {
+                for (auto pos = start; pos < end; pos += 300)
+                {
+                    auto* src = input.get() + pos;
+                    auto* dst = output.get() + pos;
+
+                    AudioBlock<const float> inBlock (&src, 1, jmin ((size_t) 300, end - pos));
+                    AudioBlock<float> outBlock (&dst, 1, jmin ((size_t) 300, end - pos));
+                    filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+                }
+            };
+
+            auto expectMatches = [&] (const FIR::Coefficients<float>& c, size_t start, size_t end)
+            {
+                reference<float, float> (c.getRawCoefficients(), numCoefficients, input.get(), ref.get(), n);
+
+                for (auto i = start; i < end; ++i)
+                    expectWithinAbsoluteError (output[i], ref[i], 1.0e-3f);
+            };
+
+            processRange (0, swapPos);
+            expectMatches (*first, 0, swapPos);
+
+            auto second = makeCoefficients (numCoefficients);
+            filter.coefficients = second;
+            processRange (swapPos, editPos);
+            expect (filter.isUsingFFT());
+            expectMatches (*second, swapPos + settleTime, editPos);
+
+            fillRandom (random, second->getRawCoefficients(), numCoefficients);
+            processRange (editPos, n);
+            expect (filter.isUsingFFT());
+            expectMatches (*second, editPos + settleTime, n);
+
+            // Coefficients that don't fit in the convolver fall back to direct convolution
+            filter.coefficients = makeCoefficients (2 * numCoefficients);
+            processRange (0, 300);
+            expect (! filter.isUsingFFT());
+
+            filter.coefficients = first;
+            processRange (0, 300);
+            expect (filter.isUsingFFT());
+        }
     }
 };
 
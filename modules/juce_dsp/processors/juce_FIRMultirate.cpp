@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace FIRMultirateHelpers
+{
+    // Uses independent partial sums, so that the compiler is free to vectorise
+    // the loop without reassociating a single floating point accumulator.
+    template <typename SampleType>
+    static SampleType dotProduct (const SampleType* a, const SampleType* b, size_t num) noexcept
+    {
+        SampleType sums[4] = {};
+        size_t i = 0;
+
+        for (; i + 4 <= num; i += 4)
+            for (size_t j = 0; j < 4; ++j)
+                sums[j] += a[i + j] * b[i + j];
+
+        for (; i < num; ++i)
+            sums[0] += a[i] * b[i];
+
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+FIR::Decimator<SampleType>::Decimator (typename Coefficients<SampleType>::Ptr coefficientsToUse, size_t decimationFactor)
+    : factor (decimationFactor)
+{
+    jassert (coefficientsToUse != nullptr && coefficientsToUse->coefficients.size() > 0);
+    jassert (factor > 0);
+
+    const auto& coefs = coefficientsToUse->coefficients;
+    reversedCoefficients.assign (coefs.begin(), coefs.end());
+    std::reverse (reversedCoefficients.begin(), reversedCoefficients.end());
+}
+
+template <typename SampleType>
+void FIR::Decimator<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    maximumChunkSize = jmax ((size_t) 1, (size_t) spec.maximumBlockSize);
+    history.setSize ((int) spec.numChannels, (int) (reversedCoefficients.size() - 1 + maximumChunkSize));
+
+    reset();
+}
+
+template <typename SampleType>
+void FIR::Decimator<SampleType>::reset() noexcept
+{
+    history.clear();
+    nextOutputPosition = 0;
+}
+
+template <typename SampleType>
+size_t FIR::Decimator<SampleType>::getNumOutputSamples (size_t numInputSamples) const noexcept
+{
+    return numInputSamples > nextOutputPosition ? (numInputSamples - nextOutputPosition + factor - 1) / factor
+                                                : 0;
+}
+
+template <typename SampleType>
+size_t FIR::Decimator<SampleType>::process (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept
+{
+    const auto numChannels = input.getNumChannels();
+    const auto numInputSamples = input.getNumSamples();
+
+    jassert (output.getNumChannels() == numChannels);
+    jassert (numChannels <= (size_t) history.getNumChannels());
+    jassert (maximumChunkSize > 0); // you need to call prepare() first!
+
+    const auto numCoefficients = reversedCoefficients.size();
+    const auto historySize = numCoefficients - 1;
+    const auto* coefs = reversedCoefficients.data();
+    size_t numWritten = 0;
+
+    for (size_t start = 0; start < numInputSamples; start += maximumChunkSize)
+    {
+        const auto num = jmin (maximumChunkSize, numInputSamples - start);
+        const auto numOutputs = getNumOutputSamples (num);
+
+        jassert (numWritten + numOutputs <= output.getNumSamples());
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* buffer = history.getWritePointer ((int) channel);
+            auto* out = output.getChannelPointer (channel) + numWritten;
+
+            FloatVectorOperations::copy (buffer + historySize, input.getChannelPointer (channel) + start, (int) num);
+
+            // the window for each output ends at the input sample with the same position
+            for (size_t i = 0, position = nextOutputPosition; i < numOutputs; ++i, position += factor)
+                out[i] = FIRMultirateHelpers::dotProduct (coefs, buffer + position, numCoefficients);
+
+            std::memmove (buffer, buffer + num, historySize * sizeof (SampleType));
+        }
+
+        nextOutputPosition = nextOutputPosition + numOutputs * factor - num;
+        numWritten += numOutputs;
+    }
+
+    return numWritten;
+}
+
+//==============================================================================
+template <typename SampleType>
+FIR::Interpolator<SampleType>::Interpolator (typename Coefficients<SampleType>::Ptr coefficientsToUse, size_t interpolationFactor)
+    : factor (interpolationFactor)
+{
+    jassert (coefficientsToUse != nullptr && coefficientsToUse->coefficients.size() > 0);
+    jassert (factor > 0);
+
+    const auto& coefs = coefficientsToUse->coefficients;
+    const auto numCoefficients = (size_t) coefs.size();
+
+    branchLength = (numCoefficients + factor - 1) / factor;
+    branches.resize (factor * branchLength, SampleType());
+
+    // branch p holds coefficients p, p + factor, p + 2 * factor... in reverse order
+    for (size_t phase = 0; phase < factor; ++phase)
+    {
+        for (size_t i = 0; i < branchLength; ++i)
+        {
+            const auto index = (branchLength - 1 - i) * factor + phase;
+
+            if (index < numCoefficients)
+                branches[phase * branchLength + i] = coefs.getUnchecked ((int) index) * static_cast<SampleType> (factor);
+        }
+    }
+}
+
+template <typename SampleType>
+void FIR::Interpolator<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    maximumChunkSize = jmax ((size_t) 1, (size_t) spec.maximumBlockSize);
+    history.setSize ((int) spec.numChannels, (int) (branchLength - 1 + maximumChunkSize));
+
+    reset();
+}
+
+template <typename SampleType>
+void FIR::Interpolator<SampleType>::reset() noexcept
+{
+    history.clear();
+}
+
+template <typename SampleType>
+void FIR::Interpolator<SampleType>::process (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept
+{
+    const auto numChannels = input.getNumChannels();
+    const auto numInputSamples = input.getNumSamples();
+
+    jassert (output.getNumChannels() == numChannels);
+    jassert (output.getNumSamples() == numInputSamples * factor);
+    jassert (numChannels <= (size_t) history.getNumChannels());
+    jassert (maximumChunkSize > 0); // you need to call prepare() first!
+
+    const auto historySize = branchLength - 1;
+
+    for (size_t start = 0; start < numInputSamples; start += maximumChunkSize)
+    {
+        const auto num = jmin (maximumChunkSize, numInputSamples - start);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* buffer = history.getWritePointer ((int) channel);
+            auto* out = output.getChannelPointer (channel) + start * factor;
+
+            FloatVectorOperations::copy (buffer + historySize, input.getChannelPointer (channel) + start, (int) num);
+
+            for (size_t i = 0; i < num; ++i)
+                for (size_t phase = 0; phase < factor; ++phase)
+                    *out++ = FIRMultirateHelpers::dotProduct (branches.data() + phase * branchLength, buffer + i, branchLength);
+
+            std::memmove (buffer, buffer + num, historySize * sizeof (SampleType));
+        }
+    }
+}
+
+//==============================================================================
+template class FIR::Decimator<float>;
+template class FIR::Decimator<double>;
+template class FIR::Interpolator<float>;
+template class FIR::Interpolator<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace FIR
+{
+    //==============================================================================
+    /**
+        Filters and downsamples an audio signal by an integer factor.
+
+        Only every factor-th output sample of the filter is calculated, so this costs
+        1 / factor of the work of an FIR::Filter followed by discarding samples. The
+        coefficients should describe a lowpass filter with its cutoff below the new
+        Nyquist frequency, for example one designed with FilterDesign.
+
+        The input can be processed in blocks of any size, and the output positions
+        carry over between blocks.
+
+        @see Interpolator, Filter, Oversampling
+
+        @tags{DSP}
+    */
+    template <typename SampleType>
+    class Decimator
+    {
+    public:
+        //==============================================================================
+        /** Creates a decimator that reduces the sample rate by the given factor. */
+        Decimator (typename Coefficients<SampleType>::Ptr coefficientsToUse, size_t factor);
+
+        //==============================================================================
+        /** Prepares the decimator. The spec should describe the input signal. */
+        void prepare (const ProcessSpec& spec);
+
+        /** Clears the filter state, and restarts the output positions. */
+        void reset() noexcept;
+
+        /** Returns the decimation factor. */
+        size_t getFactor() const noexcept      { return factor; }
+
+        /** Returns the number of output samples that the next call to process() will
+            produce for a given number of input samples.
+        */
+        size_t getNumOutputSamples (size_t numInputSamples) const noexcept;
+
+        //==============================================================================
+        /** Filters and decimates a block of samples.
+
+            The output block must have the same number of channels as the input, and
+            enough space for getNumOutputSamples (input.getNumSamples()) samples.
+
+            @returns the number of samples written to the output block
+        */
+        size_t process (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept;
+
+    private:
+        //==============================================================================
+        std::vector<SampleType> reversedCoefficients;
+        AudioBuffer<SampleType> history;
+        size_t factor, maximumChunkSize = 0, nextOutputPosition = 0;
+
+        JUCE_LEAK_DETECTOR (Decimator)
+    };
+
+    //==============================================================================
+    /**
+        Upsamples an audio signal by an integer factor, and filters out the resulting
+        images.
+
+        The filter is split into factor polyphase branches, each of which computes
+        one of the output samples for every input sample, so none of the work is spent
+        on the zeros that a naive implementation would insert. The output is scaled by
+        the factor, so that the passband gain matches that of the coefficients.
+
+        @see Decimator, Filter, Oversampling
+
+        @tags{DSP}
+    */
+    template <typename SampleType>
+    class Interpolator
+    {
+    public:
+        //==============================================================================
+        /** Creates an interpolator that increases the sample rate by the given factor. */
+        Interpolator (typename Coefficients<SampleType>::Ptr coefficientsToUse, size_t factor);
+
+        //==============================================================================
+        /** Prepares the interpolator. The spec should describe the input signal. */
+        void prepare (const ProcessSpec& spec);
+
+        /** Clears the filter state. */
+        void reset() noexcept;
+
+        /** Returns the interpolation factor. */
+        size_t getFactor() const noexcept      { return factor; }
+
+        //==============================================================================
+        /** Upsamples and filters a block of samples.
+
+            The output block must have the same number of channels as the input, and
+            factor times as many samples.
+        */
+        void process (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept;
+
+    private:
+        //==============================================================================
+        std::vector<SampleType> branches;
+        AudioBuffer<SampleType> history;
+        size_t factor, branchLength = 0, maximumChunkSize = 0;
+
+        JUCE_LEAK_DETECTOR (Interpolator)
+    };
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class FIRMultirateTest : public UnitTest
+{
+public:
+    FIRMultirateTest()
+        : UnitTest ("FIR Multirate", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Decimator matches a filter followed by downsampling");
+        {
+            for (auto factor : { 1, 2, 3, 4 })
+            {
+                auto coefficients = createCoefficients (31);
+                const auto input = createSignal();
+                const auto filtered = filter (coefficients, input);
+
+                FIR::Decimator<double> decimator (coefficients, (size_t) factor);
+                decimator.prepare ({ 44100.0, 50, 2 });
+
+                AudioBuffer<double> output (2, numSamples);
+                size_t numOutputs = 0;
+
+                for (int start = 0, blockSize = 7; start < numSamples; start += blockSize, blockSize = blockSize * 2 + 3)
+                {
+                    const auto len = (size_t) jmin (blockSize, numSamples - start);
+                    AudioBlock<const double> inBlock (input.getArrayOfReadPointers(), 2, (size_t) start, len);
+                    AudioBlock<double> outBlock (output.getArrayOfWritePointers(), 2, numOutputs,
+                                                 decimator.getNumOutputSamples (len));
+
+                    numOutputs += decimator.process (inBlock, outBlock);
+                }
+
+                expectEquals ((int) numOutputs, (numSamples + factor - 1) / factor);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < (int) numOutputs; ++i)
+                        expectWithinAbsoluteError (output.getSample (channel, i),
+                                                   filtered.getSample (channel, i * factor), 1.0e-12);
+            }
+        }
+
+        beginTest ("Interpolator matches zero-stuffing followed by a filter");
+        {
+            for (auto factor : { 1, 2, 3, 4 })
+            {
+                auto coefficients = createCoefficients (29);
+                const auto input = createSignal();
+
+                AudioBuffer<double> stuffed (2, numSamples * factor);
+                stuffed.clear();
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < numSamples; ++i)
+                        stuffed.setSample (channel, i * factor, input.getSample (channel, i) * factor);
+
+                const auto expected = filter (coefficients, stuffed);
+
+                FIR::Interpolator<double> interpolator (coefficients, (size_t) factor);
+                interpolator.prepare ({ 44100.0, 50, 2 });
+
+                AudioBuffer<double> output (2, numSamples * factor);
+
+                for (int start = 0, blockSize = 7; start < numSamples; start += blockSize, blockSize = blockSize * 2 + 3)
+                {
+                    const auto len = (size_t) jmin (blockSize, numSamples - start);
+                    AudioBlock<const double> inBlock (input.getArrayOfReadPointers(), 2, (size_t) start, len);
+                    AudioBlock<double> outBlock (output.getArrayOfWritePointers(), 2, (size_t) (start * factor), len * (size_t) factor);
+
+                    interpolator.process (inBlock, outBlock);
+                }
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < numSamples * factor; ++i)
+                        expectWithinAbsoluteError (output.getSample (channel, i), expected.getSample (channel, i), 1.0e-12);
+            }
+        }
+    }
+
+private:
+    static constexpr int numSamples = 500;
+
+    static FIR::Coefficients<double>::Ptr createCoefficients (int size)
+    {
+        Random random (0x5eed);
+        FIR::Coefficients<double>::Ptr coefficients = new FIR::Coefficients<double> ((size_t) size);
+
+        for (auto& c : coefficients->coefficients)
+            c = random.nextDouble() - 0.5;
+
+        return coefficients;
+    }
+
+    static AudioBuffer<double> createSignal()
+    {
+        Random random (0xface);
+        AudioBuffer<double> buffer (2, numSamples);
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, random.nextDouble() * 2.0 - 1.0);
+
+        return buffer;
+    }
+
+    static AudioBuffer<double> filter (FIR::Coefficients<double>::Ptr coefficients, const AudioBuffer<double>& input)
+    {
+        AudioBuffer<double> output (input);
+
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+        {
+            FIR::Filter<double> fir (coefficients);
+            fir.prepare ({ 44100.0, (uint32) output.getNumSamples(), 1 });
+
+            auto* data = output.getWritePointer (channel);
+            AudioBlock<double> block (&data, 1, (size_t) output.getNumSamples());
+            fir.process (ProcessContextReplacing<double> (block));
+        }
+
+        return output;
+    }
+};
+
+static FIRMultirateTest firMultirateUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+MultibandCrossover<SampleType>::MultibandCrossover() = default;
+
+//==============================================================================
+template <typename SampleType>
+void MultibandCrossover<SampleType>::setMode (Mode newMode)
+{
+    if (mode == newMode)
+        return;
+
+    mode = newMode;
+
+    if (isPrepared)
+        prepare (spec);
+}
+
+template <typename SampleType>
+void MultibandCrossover<SampleType>::setNumBands (int newNumBands)
+{
+    jassert (newNumBands >= 2);
+
+    const auto numCrossovers = (size_t) jmax (1, newNumBands - 1);
+    const auto highestFrequency = static_cast<SampleType> (spec.sampleRate * 0.45);
+
+    while (crossoverFrequencies.size() < numCrossovers)
+        crossoverFrequencies.push_back (jmin (crossoverFrequencies.back() * static_cast<SampleType> (2), highestFrequency));
+
+    crossoverFrequencies.resize (numCrossovers);
+
+    if (isPrepared)
+        prepare (spec);
+}
+
+template <typename SampleType>
+void MultibandCrossover<SampleType>::setCrossoverFrequency (int crossoverIndex, SampleType newFrequencyHz)
+{
+    jassert (isPositiveAndBelow (crossoverIndex, (int) crossoverFrequencies.size()));
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (spec.sampleRate * 0.5)));
+
+    const auto crossover = (size_t) crossoverIndex;
+    crossoverFrequencies[crossover] = newFrequencyHz;
+
+    if (! isPrepared)
+        return;
+
+    if (mode == Mode::minimumPhase)
+    {
+        splitters[crossover].setCutoffFrequency (newFrequencyHz);
+
+        for (size_t band = 0; band < crossover; ++band)
+            compensation[getCompensationIndex (band, crossover)].setCutoffFrequency (newFrequencyHz);
+    }
+    else
+    {
+        designLinearPhaseFilters();
+    }
+}
+
+template <typename SampleType>
+void MultibandCrossover<SampleType>::setLinearPhaseFilterOrder (int newOrder)
+{
+    jassert (newOrder > 0 && newOrder % 2 == 0);
+
+    linearPhaseOrder = newOrder;
+
+    if (isPrepared && mode == Mode::linearPhase)
+        prepare (spec);
+}
+
+template <typename SampleType>
+SampleType MultibandCrossover<SampleType>::getCrossoverFrequency (int crossoverIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (crossoverIndex, (int) crossoverFrequencies.size()));
+    return crossoverFrequencies[(size_t) crossoverIndex];
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandCrossover<SampleType>::prepare (const ProcessSpec& newSpec)
+{
+    jassert (newSpec.sampleRate > 0);
+    jassert (newSpec.numChannels > 0);
+
+    spec = newSpec;
+    isPrepared = true;
+
+    const auto numCrossovers = crossoverFrequencies.size();
+
+    splitters.clear();
+    compensation.clear();
+    bandFilters.clear();
+
+    if (mode == Mode::minimumPhase)
+    {
+        splitters.resize (numCrossovers);
+        compensation.resize (numCrossovers * (numCrossovers - 1) / 2);
+
+        for (size_t crossover = 0; crossover < numCrossovers; ++crossover)
+        {
+            splitters[crossover].prepare (spec);
+            splitters[crossover].setCutoffFrequency (crossoverFrequencies[crossover]);
+
+            for (size_t band = 0; band < crossover; ++band)
+            {
+                auto& allpass = compensation[getCompensationIndex (band, crossover)];
+                allpass.setType (LinkwitzRileyFilterType::allpass);
+                allpass.prepare (spec);
+                allpass.setCutoffFrequency (crossoverFrequencies[crossover]);
+            }
+        }
+    }
+    else
+    {
+        designLinearPhaseFilters();
+
+        delayLine = DelayLine<SampleType, DelayLineInterpolationTypes::None> (getLatencyInSamples() + 1);
+        delayLine.prepare (spec);
+        delayLine.setDelay (static_cast<SampleType> (getLatencyInSamples()));
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void MultibandCrossover<SampleType>::reset()
+{
+    for (auto* filters : { &splitters, &compensation })
+        for (auto& filter : *filters)
+            filter.reset();
+
+    for (auto& filter : bandFilters)
+        filter.reset();
+
+    if (mode == Mode::linearPhase && isPrepared)
+        delayLine.reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandCrossover<SampleType>::designLinearPhaseFilters()
+{
+    const auto order = (size_t) linearPhaseOrder;
+    const auto monoSpec = ProcessSpec { spec.sampleRate, spec.maximumBlockSize, 1 };
+
+    bandFilters.clear();
+    bandFilters.reserve (crossoverFrequencies.size() * spec.numChannels);
+
+    typename FIR::Coefficients<SampleType>::Ptr previousLowpass;
+
+    // Each band is the difference between two lowpass filters, so all of the bands
+    // apart from the highest one telescope to the last lowpass. The highest band is
+    // the delayed input minus the others, which makes the sum exactly a delay.
+    for (auto frequency : crossoverFrequencies)
+    {
+        auto lowpass = FilterDesign<SampleType>::designFIRLowpassWindowMethod (frequency, spec.sampleRate, order,
+                                                                               WindowingFunction<SampleType>::blackmanHarris);
+
+        auto* lowpassCoefficients = lowpass->getRawCoefficients();
+        SampleType dcGain = 0;
+
+        for (size_t i = 0; i <= order; ++i)
+            dcGain += lowpassCoefficients[i];
+
+        FloatVectorOperations::multiply (lowpassCoefficients, static_cast<SampleType> (1) / dcGain, (int) order + 1);
+
+        typename FIR::Coefficients<SampleType>::Ptr band = new FIR::Coefficients<SampleType> (lowpassCoefficients, order + 1);
+
+        if (previousLowpass != nullptr)
+            FloatVectorOperations::subtract (band->getRawCoefficients(), previousLowpass->getRawCoefficients(), (int) order + 1);
+
+        for (uint32 channel = 0; channel < spec.numChannels; ++channel)
+        {
+            bandFilters.emplace_back (band);
+            bandFilters.back().prepare (monoSpec);
+            bandFilters.back().setFFTThreshold (256);
+        }
+
+        previousLowpass = lowpass;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultibandCrossover<SampleType>::process (const AudioBlock<const SampleType>& input,
+                                              const AudioBlock<SampleType>* bands) noexcept
+{
+    const auto numCrossovers = crossoverFrequencies.size();
+    const auto numChannels = input.getNumChannels();
+    const auto numSamples = input.getNumSamples();
+
+    jassert (isPrepared);
+    jassert (numChannels <= spec.numChannels);
+
+    for (size_t band = 0; band <= numCrossovers; ++band)
+    {
+        jassert (bands[band].getNumChannels() == numChannels);
+        jassert (bands[band].getNumSamples() == numSamples);
+    }
+
+    auto highestBand = bands[numCrossovers];
+    highestBand.copyFrom (input);
+
+    if (mode == Mode::minimumPhase)
+    {
+        // The highest band carries the remainder of the signal, which is split again
+        // by each crossover in turn.
+        for (size_t crossover = 0; crossover < numCrossovers; ++crossover)
+        {
+            auto& splitter = splitters[crossover];
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* remainder = highestBand.getChannelPointer (channel);
+                auto* low = bands[crossover].getChannelPointer (channel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    splitter.processSample ((int) channel, remainder[i], low[i], remainder[i]);
+            }
+
+           #if JUCE_SNAP_TO_ZERO
+            splitter.snapToZero();
+           #endif
+
+            for (size_t band = 0; band < crossover; ++band)
+            {
+                auto block = bands[band];
+                compensation[getCompensationIndex (band, crossover)].process (ProcessContextReplacing<SampleType> (block));
+            }
+        }
+    }
+    else
+    {
+        delayLine.process (ProcessContextReplacing<SampleType> (highestBand));
+
+        for (size_t band = 0; band < numCrossovers; ++band)
+        {
+            bands[band].copyFrom (input);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto channelBlock = bands[band].getSingleChannelBlock (channel);
+                bandFilters[band * spec.numChannels + channel].process (ProcessContextReplacing<SampleType> (channelBlock));
+            }
+
+            highestBand.subtract (bands[band]);
+        }
+    }
+}
+
+//==============================================================================
+template class MultibandCrossover<float>;
+template class MultibandCrossover<double>;
+
+} // namespace dsp
+} // namespace juce
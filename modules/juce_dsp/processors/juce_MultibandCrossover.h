@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+enum class MultibandCrossoverMode
+{
+    minimumPhase,
+    linearPhase
+};
+
+/**
+    Splits a signal into any number of frequency bands which sum back to the
+    original signal, for use in multiband processors.
+
+    In minimumPhase mode, each crossover is a Linkwitz-Riley 4th order split,
+    processed with LinkwitzRileyFilter. Every band is compensated with the
+    all-pass responses of the crossovers that it didn't go through, so the bands
+    sum to an all-pass response with a flat magnitude and no latency.
+
+    In linearPhase mode, each band is filtered with a linear phase FIR filter,
+    using FFT convolution for float samples. The filters are designed so that the
+    bands sum to a pure delay of getLatencyInSamples() samples, which makes the
+    reconstruction exact. Use a longer filter order for crossovers at low
+    frequencies, which need steeper slopes.
+
+    @see LinkwitzRileyFilter, FIR::Filter
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultibandCrossover
+{
+public:
+    //==============================================================================
+    using Mode = MultibandCrossoverMode;
+
+    //==============================================================================
+    /** Creates a two-band crossover at 1 kHz. */
+    MultibandCrossover();
+
+    //==============================================================================
+    /** Sets the processing mode. This will allocate memory, so call it before
+        prepare() rather than during playback.
+    */
+    void setMode (Mode newMode);
+
+    /** Sets the number of bands, which must be at least 2. New crossovers are placed
+        an octave above the previous highest one. This will allocate memory, so call
+        it before prepare() rather than during playback.
+    */
+    void setNumBands (int newNumBands);
+
+    /** Sets one of the crossover frequencies in Hz, where crossover i separates
+        band i from band i + 1. The frequencies must be in increasing order.
+
+        In linearPhase mode this redesigns the FIR filters, so it shouldn't be called
+        during playback.
+    */
+    void setCrossoverFrequency (int crossoverIndex, SampleType newFrequencyHz);
+
+    /** Sets the order of the FIR filters used in linearPhase mode, which must be
+        even. The latency of that mode is half of this order. The default is 4096.
+    */
+    void setLinearPhaseFilterOrder (int newOrder);
+
+    //==============================================================================
+    /** Returns the processing mode. */
+    Mode getMode() const noexcept                   { return mode; }
+
+    /** Returns the number of bands. */
+    int getNumBands() const noexcept                { return (int) crossoverFrequencies.size() + 1; }
+
+    /** Returns one of the crossover frequencies in Hz. */
+    SampleType getCrossoverFrequency (int crossoverIndex) const noexcept;
+
+    /** Returns the latency of the crossover in samples, which is zero in
+        minimumPhase mode.
+    */
+    int getLatencyInSamples() const noexcept        { return mode == Mode::linearPhase ? linearPhaseOrder / 2 : 0; }
+
+    //==============================================================================
+    /** Initialises the crossover. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the crossover. */
+    void reset();
+
+    //==============================================================================
+    /** Splits a block of samples into bands.
+
+        @param input    the signal to split
+        @param bands    an array of getNumBands() blocks which will receive the bands,
+                        in order of increasing frequency. Each one must have the same
+                        size as the input, and none may overlap it.
+    */
+    void process (const AudioBlock<const SampleType>& input, const AudioBlock<SampleType>* bands) noexcept;
+
+private:
+    //==============================================================================
+    void designLinearPhaseFilters();
+    size_t getCompensationIndex (size_t band, size_t crossover) const noexcept   { return crossover * (crossover - 1) / 2 + band; }
+
+    //==============================================================================
+    std::vector<SampleType> crossoverFrequencies { static_cast<SampleType> (1000.0) };
+
+    std::vector<LinkwitzRileyFilter<SampleType>> splitters, compensation;
+
+    std::vector<FIR::Filter<SampleType>> bandFilters;
+    DelayLine<SampleType, DelayLineInterpolationTypes::None> delayLine;
+
+    ProcessSpec spec { 44100.0, 512, 2 };
+    bool isPrepared = false;
+    Mode mode = Mode::minimumPhase;
+    int linearPhaseOrder = 4096;
+
+    JUCE_LEAK_DETECTOR (MultibandCrossover)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class MultibandCrossoverTest : public UnitTest
+{
+public:
+    MultibandCrossoverTest()
+        : UnitTest ("Multiband Crossover", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Minimum phase bands sum to an all-pass response");
+        {
+            MultibandCrossover<float> crossover;
+            crossover.setNumBands (4);
+
+            for (int i = 0; i < 3; ++i)
+                crossover.setCrossoverFrequency (i, frequencies[i]);
+
+            crossover.prepare (spec);
+            expectEquals (crossover.getLatencyInSamples(), 0);
+
+            const auto input = createSignal();
+            const auto sum = processAndSum (crossover, input);
+
+            AudioBuffer<float> expected (input);
+            AudioBlock<float> expectedBlock (expected);
+
+            for (auto frequency : frequencies)
+            {
+                LinkwitzRileyFilter<float> allpass;
+                allpass.setType (LinkwitzRileyFilterType::allpass);
+                allpass.prepare (spec);
+                allpass.setCutoffFrequency (frequency);
+                allpass.process (ProcessContextReplacing<float> (expectedBlock));
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (sum.getSample (channel, i), expected.getSample (channel, i), 1.0e-5f);
+        }
+
+        beginTest ("Linear phase bands sum to a delay");
+        {
+            MultibandCrossover<float> crossover;
+            crossover.setMode (MultibandCrossoverMode::linearPhase);
+            crossover.setLinearPhaseFilterOrder (512);
+            crossover.setNumBands (4);
+
+            for (int i = 0; i < 3; ++i)
+                crossover.setCrossoverFrequency (i, frequencies[i]);
+
+            crossover.prepare (spec);
+
+            const auto latency = crossover.getLatencyInSamples();
+            expectEquals (latency, 256);
+
+            const auto input = createSignal();
+            const auto sum = processAndSum (crossover, input);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (sum.getSample (channel, i),
+                                               i < latency ? 0.0f : input.getSample (channel, i - latency), 1.0e-5f);
+        }
+
+        beginTest ("Bands contain their own frequencies");
+        {
+            for (auto mode : { MultibandCrossoverMode::minimumPhase, MultibandCrossoverMode::linearPhase })
+            {
+                MultibandCrossover<float> crossover;
+                crossover.setMode (mode);
+                crossover.setLinearPhaseFilterOrder (1024);
+                crossover.setNumBands (3);
+                crossover.setCrossoverFrequency (0, 500.0f);
+                crossover.setCrossoverFrequency (1, 5000.0f);
+                crossover.prepare (spec);
+
+                const float testFrequencies[] = { 100.0f, 1500.0f, 15000.0f };
+
+                for (int expectedBand = 0; expectedBand < 3; ++expectedBand)
+                {
+                    crossover.reset();
+
+                    AudioBuffer<float> input (numChannels, numSamples);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        for (int i = 0; i < numSamples; ++i)
+                            input.setSample (channel, i, std::sin (MathConstants<float>::twoPi * testFrequencies[expectedBand]
+                                                                     * (float) i / (float) spec.sampleRate));
+
+                    std::vector<AudioBuffer<float>> bands;
+                    process (crossover, input, bands);
+
+                    // look at the second half, after the filters have settled
+                    for (int band = 0; band < 3; ++band)
+                    {
+                        const auto rms = bands[(size_t) band].getRMSLevel (0, numSamples / 2, numSamples / 2);
+
+                        if (band == expectedBand)
+                            expect (rms > 0.6f);
+                        else
+                            expect (rms < 0.1f);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr int numChannels = 2;
+    static constexpr int numSamples = 4000;
+    static constexpr float frequencies[] = { 200.0f, 2000.0f, 8000.0f };
+
+    const ProcessSpec spec { 44100.0, 512, (uint32) numChannels };
+
+    static AudioBuffer<float> createSignal()
+    {
+        Random random (0xc055);
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    void process (MultibandCrossover<float>& crossover, const AudioBuffer<float>& input, std::vector<AudioBuffer<float>>& bands)
+    {
+        const auto numBands = (size_t) crossover.getNumBands();
+        bands.assign (numBands, AudioBuffer<float> (numChannels, numSamples));
+
+        std::vector<AudioBlock<float>> bandBlocks (numBands);
+
+        for (int start = 0; start < numSamples; start += (int) spec.maximumBlockSize)
+        {
+            const auto len = (size_t) jmin ((int) spec.maximumBlockSize, numSamples - start);
+
+            for (size_t band = 0; band < numBands; ++band)
+                bandBlocks[band] = AudioBlock<float> (bands[band]).getSubBlock ((size_t) start, len);
+
+            crossover.process (AudioBlock<const float> (input).getSubBlock ((size_t) start, len), bandBlocks.data());
+        }
+    }
+
+    AudioBuffer<float> processAndSum (MultibandCrossover<float>& crossover, const AudioBuffer<float>& input)
+    {
+        std::vector<AudioBuffer<float>> bands;
+        process (crossover, input, bands);
+
+        AudioBuffer<float> sum (numChannels, numSamples);
+        sum.clear();
+
+        for (auto& band : bands)
+            for (int channel = 0; channel < numChannels; ++channel)
+                sum.addFrom (channel, 0, band, channel, 0, numSamples);
+
+        return sum;
+    }
+};
+
+constexpr float MultibandCrossoverTest::frequencies[];
+
+static MultibandCrossoverTest multibandCrossoverUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -66,6 +66,16 @@ void Compressor<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Compressor<SampleType>::setLookahead (SampleType newLookahead)
+{
+    jassert (newLookahead >= static_cast<SampleType> (0.0)
+             && newLookahead <= static_cast<SampleType> (DynamicsHelpers::maximumLookaheadMs));
+
+    lookaheadTime = newLookahead;
+    update();
+}
+
 //==============================================================================
 template <typename SampleType>
 void Compressor<SampleType>::prepare (const ProcessSpec& spec)
@@ -76,6 +86,7 @@ void Compressor<SampleType>::prepare (const ProcessSpec& spec)
     sampleRate = spec.sampleRate;
 
     envelopeFilter.prepare (spec);
+    lookahead.prepare (spec);
 
     update();
     reset();
@@ -85,6 +96,7 @@ template <typename SampleType>
 void Compressor<SampleType>::reset()
 {
     envelopeFilter.reset();
+    lookahead.reset();
 }
 
 //==============================================================================
@@ -111,6 +123,8 @@ void Compressor<SampleType>::update()
 
     envelopeFilter.setAttackTime (attackTime);
     envelopeFilter.setReleaseTime (releaseTime);
+
+    lookahead.setDelay (roundToInt (lookaheadTime * sampleRate / 1000.0));
 }
 
 //==============================================================================
@@ -55,6 +55,24 @@ public:
     /** Sets the release time in milliseconds of the compressor.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets the lookahead time in milliseconds, up to a maximum of 20 ms.
+
+        The audio is delayed by this amount while the gain is calculated from the
+        undelayed input, so the compressor can react before a transient is heard. This
+        adds latency, which is reported by getLatencyInSamples(). Changing the
+        lookahead time clears the delayed audio.
+    */
+    void setLookahead (SampleType newLookahead);
+
+    /** When the channels are linked, every channel is processed with the same gain,
+        derived from the loudest channel. This keeps the stereo image stable.
+        By default the channels are processed independently.
+    */
+    void setChannelLinking (bool shouldLinkChannels) noexcept   { linkChannels = shouldLinkChannels; }
+
+    /** Returns the latency introduced by the lookahead, in samples. */
+    int getLatencyInSamples() const noexcept                    { return lookahead.getDelay(); }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -67,31 +85,24 @@ public:
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
     {
-        const auto& inputBlock = context.getInputBlock();
-        auto& outputBlock      = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
-        const auto numSamples  = outputBlock.getNumSamples();
-
-        jassert (inputBlock.getNumChannels() == numChannels);
-        jassert (inputBlock.getNumSamples()  == numSamples);
-
-        if (context.isBypassed)
+        DynamicsHelpers::process (context, linkChannels, lookahead,
+                                  [this] (int channel, const SampleType* input, SampleType* gains, size_t numSamples)
         {
-            outputBlock.copyFrom (inputBlock);
-            return;
-        }
-
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
-        }
+            envelopeFilter.processSamples (channel, input, gains, numSamples);
+            DynamicsHelpers::computeGains (gains, gains, numSamples, thresholdInverse,
+                                           ratioInverse - static_cast<SampleType> (1.0));
+        });
+
+       #if JUCE_SNAP_TO_ZERO
+        envelopeFilter.snapToZero();
+       #endif
     }
 
-    /** Performs the processing operation on a single sample at a time. */
+    /** Performs the processing operation on a single sample at a time.
+
+        This doesn't apply any lookahead or channel linking, so use process() when
+        either of those is needed.
+    */
     SampleType processSample (int channel, SampleType inputValue);
 
 private:
@@ -102,8 +113,11 @@ private:
     SampleType threshold, thresholdInverse, ratioInverse;
     BallisticsFilter<SampleType> envelopeFilter;
 
+    DynamicsHelpers::LookaheadDelay<SampleType> lookahead;
+    bool linkChannels = false;
+
     double sampleRate = 44100.0;
-    SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0;
+    SampleType thresholddB = 0.0, ratio = 1.0, attackTime = 1.0, releaseTime = 100.0, lookaheadTime = 0.0;
 };
 
 } // namespace dsp
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class DynamicsProcessorsTest : public UnitTest
+{
+public:
+    DynamicsProcessorsTest()
+        : UnitTest ("Dynamics processors", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        beginTest ("Fast log2 and exp2");
+        {
+            for (auto x = 1.0e-6f; x < 1.0e6f; x *= 1.37f)
+                expectWithinAbsoluteError (DynamicsHelpers::fastLog2 (x), std::log2 (x), 1.0e-5f);
+
+            for (auto x = -100.0f; x < 100.0f; x += 0.173f)
+            {
+                const auto expected = std::exp2 (x);
+                expectWithinAbsoluteError (DynamicsHelpers::fastExp2 (x), expected, expected * 1.0e-6f);
+            }
+        }
+
+        beginTest ("Compressor blocks match per-sample processing");
+        {
+            Compressor<float> blockwise, reference;
+
+            for (auto* compressor : { &blockwise, &reference })
+            {
+                compressor->setThreshold (-20.0f);
+                compressor->setRatio (4.0f);
+                compressor->setAttack (1.0f);
+                compressor->setRelease (50.0f);
+            }
+
+            expectBlocksMatchSamples (blockwise, reference);
+        }
+
+        beginTest ("Noise gate blocks match per-sample processing");
+        {
+            NoiseGate<float> blockwise, reference;
+
+            for (auto* gate : { &blockwise, &reference })
+            {
+                gate->setThreshold (-12.0f);
+                gate->setRatio (5.0f);
+                gate->setAttack (2.0f);
+                gate->setRelease (30.0f);
+            }
+
+            expectBlocksMatchSamples (blockwise, reference);
+        }
+
+        beginTest ("Lookahead delays the audio");
+        {
+            Compressor<float> compressor;
+            compressor.setRatio (1.0f);
+            compressor.setLookahead (5.0f);
+            compressor.prepare ({ sampleRate, (uint32) numSamples, 2 });
+
+            const auto latency = compressor.getLatencyInSamples();
+            expectEquals (latency, roundToInt (sampleRate * 0.005));
+
+            auto input = createSignal();
+            AudioBuffer<float> output (input);
+
+            for (int start = 0, blockSize = 100; start < numSamples; start += blockSize, blockSize = 400 - blockSize)
+            {
+                const auto num = jmin (blockSize, numSamples - start);
+                AudioBlock<float> block (output.getArrayOfWritePointers(), 2, (size_t) start, (size_t) num);
+                compressor.process (ProcessContextReplacing<float> (block));
+            }
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectEquals (output.getSample (channel, i),
+                                  i < latency ? 0.0f : input.getSample (channel, i - latency));
+        }
+
+        beginTest ("Linked channels share the same gain");
+        {
+            Compressor<float> compressor;
+            compressor.setThreshold (-30.0f);
+            compressor.setRatio (8.0f);
+            compressor.setChannelLinking (true);
+            compressor.prepare ({ sampleRate, (uint32) numSamples, 2 });
+
+            auto input = createSignal();
+            input.copyFrom (1, 0, input, 0, 0, numSamples);
+            input.applyGain (1, 0, numSamples, 0.1f);
+
+            AudioBuffer<float> output (input);
+            AudioBlock<float> block (output);
+            compressor.process (ProcessContextReplacing<float> (block));
+
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (output.getSample (1, i), output.getSample (0, i) * 0.1f, 1.0e-6f);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int numSamples = 3000;
+
+    static AudioBuffer<float> createSignal()
+    {
+        AudioBuffer<float> buffer (2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // a decaying burst followed by a quiet tail, so that the detectors
+            // go through both their attack and release phases
+            const auto level = i < 1500 ? std::exp ((float) -i / 500.0f) : 0.01f;
+
+            buffer.setSample (0, i, level * std::sin ((float) i * 0.05f));
+            buffer.setSample (1, i, 0.5f * level * std::sin ((float) i * 0.031f));
+        }
+
+        return buffer;
+    }
+
+    template <typename Processor>
+    void expectBlocksMatchSamples (Processor& blockwise, Processor& reference)
+    {
+        const ProcessSpec spec { sampleRate, (uint32) numSamples, 2 };
+        blockwise.prepare (spec);
+        reference.prepare (spec);
+
+        auto input = createSignal();
+        AudioBuffer<float> output (input);
+        AudioBlock<float> block (output);
+        blockwise.process (ProcessContextReplacing<float> (block));
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto expected = reference.processSample (channel, input.getSample (channel, i));
+                expectWithinAbsoluteError (output.getSample (channel, i), expected, 1.0e-5f);
+            }
+        }
+    }
+};
+
+static DynamicsProcessorsTest dynamicsProcessorsUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+#ifndef DOXYGEN
+namespace DynamicsHelpers // Internal helpers shared by the dynamics processors
+{
+    /** The number of samples the dynamics processors render in one go. */
+    constexpr size_t maximumChunkSize = 256;
+
+    /** The longest lookahead time in milliseconds that the dynamics processors support. */
+    constexpr double maximumLookaheadMs = 20.0;
+
+    //==============================================================================
+    /** A fast base-2 logarithm, accurate to about 1e-7 for positive normal floats.
+        Values smaller than 1e-30 are clamped, so this never returns -inf.
+    */
+    inline float fastLog2 (float x) noexcept
+    {
+        x = jmax (x, 1.0e-30f);
+
+        uint32 bits;
+        std::memcpy (&bits, &x, sizeof (bits));
+
+        auto exponent = (float) ((int) (bits >> 23) - 127);
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+
+        float mantissa;
+        std::memcpy (&mantissa, &bits, sizeof (mantissa));
+
+        // fold the mantissa into [sqrt (0.5), sqrt (2)) to keep the series short
+        const auto fold = mantissa > 1.41421356f;
+        mantissa = fold ? mantissa * 0.5f : mantissa;
+        exponent = fold ? exponent + 1.0f : exponent;
+
+        // log2 (m) = 2 atanh (t) / ln (2), with t = (m - 1) / (m + 1)
+        const auto t = (mantissa - 1.0f) / (mantissa + 1.0f);
+        const auto t2 = t * t;
+
+        return exponent + t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078016f + t2 * 0.412198583f)));
+    }
+
+    /** A fast base-2 exponential, accurate to about 1e-7 relative error.
+        The input is clamped to [-126, 126], so the result is always a normal float.
+    */
+    inline float fastExp2 (float x) noexcept
+    {
+        x = jlimit (-126.0f, 126.0f, x);
+
+        const auto integer = std::floor (x + 0.5f);
+        const auto f = (x - integer) * 0.693147181f;
+
+        const auto fraction = 1.0f + f * (1.0f + f * (0.5f + f * (1.0f / 6.0f + f * (1.0f / 24.0f
+                                   + f * (1.0f / 120.0f + f * (1.0f / 720.0f))))));
+
+        const auto bits = (uint32) ((int) integer + 127) << 23;
+
+        float scale;
+        std::memcpy (&scale, &bits, sizeof (scale));
+
+        return fraction * scale;
+    }
+
+    inline double fastLog2 (double x) noexcept   { return std::log2 (jmax (x, 1.0e-300)); }
+    inline double fastExp2 (double x) noexcept   { return std::exp2 (x); }
+
+    //==============================================================================
+    /** Turns a block of envelope values into gains, in the log domain.
+
+        Each gain is pow (envelope / threshold, exponent), limited so that it never
+        exceeds unity. A compressor uses an exponent of (1 / ratio - 1), and an
+        expander or gate uses (ratio - 1).
+    */
+    template <typename SampleType>
+    void computeGains (const SampleType* envelope, SampleType* gains, size_t numSamples,
+                       SampleType thresholdInverse, SampleType exponent) noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto level = fastLog2 (envelope[i] * thresholdInverse);
+            gains[i] = fastExp2 (jmin (static_cast<SampleType> (0), exponent * level));
+        }
+    }
+
+    //==============================================================================
+    /** Delays the audio passing through a dynamics processor, so that its gain
+        changes can react to transients before they are heard.
+    */
+    template <typename SampleType>
+    class LookaheadDelay
+    {
+    public:
+        void prepare (const ProcessSpec& spec)
+        {
+            maximumDelay = (int) std::ceil (spec.sampleRate * maximumLookaheadMs / 1000.0);
+
+            state  .setSize ((int) spec.numChannels, maximumDelay);
+            scratch.setSize (1, maximumDelay);
+
+            delay = jmin (delay, maximumDelay);
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            state.clear();
+        }
+
+        /** Changing the delay clears the delayed samples, so should be avoided during playback. */
+        void setDelay (int newDelayInSamples) noexcept
+        {
+            newDelayInSamples = jlimit (0, maximumDelay, newDelayInSamples);
+
+            if (newDelayInSamples != delay)
+            {
+                delay = newDelayInSamples;
+                reset();
+            }
+        }
+
+        int getDelay() const noexcept   { return delay; }
+
+        /** Delays a block of samples on one channel. The input and output may be the same. */
+        void process (size_t channel, const SampleType* input, SampleType* output, size_t numSamples) noexcept
+        {
+            jassert (isPositiveAndBelow (channel, (size_t) state.getNumChannels()));
+
+            const auto numDelayed = (size_t) delay;
+            auto* delayed = state.getWritePointer ((int) channel);
+            auto* temp = scratch.getWritePointer (0);
+
+            if (numSamples >= numDelayed)
+            {
+                const auto numPassed = numSamples - numDelayed;
+
+                FloatVectorOperations::copy (temp, input + numPassed, (int) numDelayed);
+                std::memmove (output + numDelayed, input, numPassed * sizeof (SampleType));
+                FloatVectorOperations::copy (output, delayed, (int) numDelayed);
+                FloatVectorOperations::copy (delayed, temp, (int) numDelayed);
+            }
+            else
+            {
+                FloatVectorOperations::copy (temp, input, (int) numSamples);
+                FloatVectorOperations::copy (output, delayed, (int) numSamples);
+                std::memmove (delayed, delayed + numSamples, (numDelayed - numSamples) * sizeof (SampleType));
+                FloatVectorOperations::copy (delayed + numDelayed - numSamples, temp, (int) numSamples);
+            }
+        }
+
+    private:
+        AudioBuffer<SampleType> state, scratch;
+        int maximumDelay = 0, delay = 0;
+    };
+
+    //==============================================================================
+    /** Runs a dynamics processor over a processing context in chunks.
+
+        The gain computer is called as computeGains (channel, input, gains, numSamples).
+        It must write one gain per input sample, using the envelope state of the given
+        channel. When the channels are linked, it's called once per chunk for channel 0
+        with the loudest rectified sample of all channels, and the resulting gains are
+        applied to every channel.
+    */
+    template <typename SampleType, typename ProcessContext, typename GainComputer>
+    void process (const ProcessContext& context, bool linkChannels,
+                  LookaheadDelay<SampleType>& lookahead, GainComputer&& computeGains) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        SampleType gains[maximumChunkSize], detector[maximumChunkSize];
+        const auto useLookahead = lookahead.getDelay() > 0;
+
+        for (size_t start = 0; start < numSamples; start += maximumChunkSize)
+        {
+            const auto num = jmin (maximumChunkSize, numSamples - start);
+
+            if (linkChannels && numChannels > 0)
+            {
+                FloatVectorOperations::abs (detector, inputBlock.getChannelPointer (0) + start, (int) num);
+
+                for (size_t channel = 1; channel < numChannels; ++channel)
+                {
+                    FloatVectorOperations::abs (gains, inputBlock.getChannelPointer (channel) + start, (int) num);
+                    FloatVectorOperations::max (detector, detector, gains, (int) num);
+                }
+
+                computeGains (0, detector, gains, num);
+            }
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* input  = inputBlock .getChannelPointer (channel) + start;
+                auto* output = outputBlock.getChannelPointer (channel) + start;
+
+                if (! linkChannels)
+                    computeGains ((int) channel, input, gains, num);
+
+                if (useLookahead)
+                {
+                    lookahead.process (channel, input, output, num);
+                    FloatVectorOperations::multiply (output, gains, (int) num);
+                }
+                else
+                {
+                    FloatVectorOperations::multiply (output, input, gains, (int) num);
+                }
+            }
+        }
+    }
+}
+#endif
+
+} // namespace dsp
+} // namespace juce
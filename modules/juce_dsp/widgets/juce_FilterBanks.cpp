@@ -0,0 +1,453 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+FirstOrderTPTFilterBank<SampleType>::FirstOrderTPTFilterBank()
+{
+    setType (filterType);
+}
+
+template <typename SampleType>
+void FirstOrderTPTFilterBank<SampleType>::setType (Type newType) noexcept
+{
+    filterType = newType;
+
+    switch (filterType)
+    {
+        case Type::lowpass:   inputMix = 0;  outputMix = 1;  break;
+        case Type::highpass:  inputMix = 1;  outputMix = -1; break;
+        case Type::allpass:   inputMix = -1; outputMix = 2;  break;
+        default:              jassertfalse;                  break;
+    }
+}
+
+template <typename SampleType>
+void FirstOrderTPTFilterBank<SampleType>::setCutoffFrequency (int filterIndex, SampleType newFrequencyHz) noexcept
+{
+    jassert (isPositiveAndBelow (filterIndex, getNumFilters()));
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (sampleRate * 0.5)));
+
+    cutoffFrequencies[(size_t) filterIndex] = newFrequencyHz;
+    coefficientSmoother.setTargetValue (filterIndex, calculateCoefficient (newFrequencyHz));
+}
+
+//==============================================================================
+template <typename SampleType>
+void FirstOrderTPTFilterBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+
+    const auto numFilters = (size_t) spec.numChannels;
+
+    state            .resize (numFilters);
+    cutoffFrequencies.resize (numFilters, static_cast<SampleType> (1000.0));
+    coefficients     .resize (numFilters);
+    increments       .resize (numFilters);
+    interleaved      .resize (numFilters * FilterBankHelpers::controlInterval);
+
+    coefficientSmoother.setNumValues ((int) numFilters);
+    coefficientSmoother.reset ((int) FilterBankHelpers::controlInterval);
+
+    for (size_t i = 0; i < numFilters; ++i)
+        coefficientSmoother.setTargetValue ((int) i, calculateCoefficient (cutoffFrequencies[i]));
+
+    reset();
+}
+
+template <typename SampleType>
+void FirstOrderTPTFilterBank<SampleType>::reset() noexcept
+{
+    std::fill (state.begin(), state.end(), static_cast<SampleType> (0));
+
+    for (int i = 0; i < getNumFilters(); ++i)
+        coefficientSmoother.setCurrentAndTargetValue (i, coefficientSmoother.getTargetValue (i));
+}
+
+template <typename SampleType>
+void FirstOrderTPTFilterBank<SampleType>::snapToZero() noexcept
+{
+    for (auto& s : state)
+        util::snapToZero (s);
+}
+
+//==============================================================================
+template <typename SampleType>
+void FirstOrderTPTFilterBank<SampleType>::processChunk (SampleType* chunk, size_t numFilters, size_t numSamples) noexcept
+{
+    FilterBankHelpers::startRamps (coefficientSmoother, coefficients.data(), increments.data(), numFilters, numSamples);
+
+    auto* s   = state.data();
+    auto* G   = coefficients.data();
+    auto* inc = increments.data();
+
+    const auto xMix = inputMix, yMix = outputMix;
+
+    for (size_t n = 0; n < numSamples; ++n)
+    {
+        auto* x = chunk + n * numFilters;
+
+        for (size_t i = 0; i < numFilters; ++i)
+        {
+            G[i] += inc[i];
+
+            const auto input = x[i];
+            const auto v = G[i] * (input - s[i]);
+            const auto y = v + s[i];
+            s[i] = y + v;
+
+            x[i] = xMix * input + yMix * y;
+        }
+    }
+}
+
+template <typename SampleType>
+SampleType FirstOrderTPTFilterBank<SampleType>::calculateCoefficient (SampleType frequencyHz) const noexcept
+{
+    auto g = SampleType (std::tan (juce::MathConstants<double>::pi * frequencyHz / sampleRate));
+    return g / (1 + g);
+}
+
+//==============================================================================
+template <typename SampleType>
+StateVariableTPTFilterBank<SampleType>::StateVariableTPTFilterBank()
+{
+    setType (filterType);
+}
+
+template <typename SampleType>
+void StateVariableTPTFilterBank<SampleType>::setType (Type newType) noexcept
+{
+    filterType = newType;
+
+    lowpassMix  = filterType == Type::lowpass  ? 1 : 0;
+    bandpassMix = filterType == Type::bandpass ? 1 : 0;
+    highpassMix = filterType == Type::highpass ? 1 : 0;
+}
+
+template <typename SampleType>
+void StateVariableTPTFilterBank<SampleType>::setCutoffFrequency (int filterIndex, SampleType newFrequencyHz) noexcept
+{
+    jassert (isPositiveAndBelow (filterIndex, getNumFilters()));
+    jassert (isPositiveAndBelow (newFrequencyHz, static_cast<SampleType> (sampleRate * 0.5)));
+
+    cutoffFrequencies[(size_t) filterIndex] = newFrequencyHz;
+    coefficientSmoother.setTargetValue (filterIndex, calculateCoefficient (newFrequencyHz));
+}
+
+template <typename SampleType>
+void StateVariableTPTFilterBank<SampleType>::setResonance (int filterIndex, SampleType newResonance) noexcept
+{
+    jassert (isPositiveAndBelow (filterIndex, getNumFilters()));
+    jassert (newResonance > static_cast<SampleType> (0));
+
+    resonances[(size_t) filterIndex] = newResonance;
+    R2[(size_t) filterIndex] = static_cast<SampleType> (1.0 / newResonance);
+}
+
+//==============================================================================
+template <typename SampleType>
+void StateVariableTPTFilterBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+
+    const auto numFilters = (size_t) spec.numChannels;
+    const auto defaultResonance = static_cast<SampleType> (1.0 / std::sqrt (2.0));
+
+    s1               .resize (numFilters);
+    s2               .resize (numFilters);
+    cutoffFrequencies.resize (numFilters, static_cast<SampleType> (1000.0));
+    resonances       .resize (numFilters, defaultResonance);
+    R2               .resize (numFilters, static_cast<SampleType> (1) / defaultResonance);
+    coefficients     .resize (numFilters);
+    increments       .resize (numFilters);
+    interleaved      .resize (numFilters * FilterBankHelpers::controlInterval);
+
+    coefficientSmoother.setNumValues ((int) numFilters);
+    coefficientSmoother.reset ((int) FilterBankHelpers::controlInterval);
+
+    for (size_t i = 0; i < numFilters; ++i)
+        coefficientSmoother.setTargetValue ((int) i, calculateCoefficient (cutoffFrequencies[i]));
+
+    reset();
+}
+
+template <typename SampleType>
+void StateVariableTPTFilterBank<SampleType>::reset() noexcept
+{
+    for (auto v : { &s1, &s2 })
+        std::fill (v->begin(), v->end(), static_cast<SampleType> (0));
+
+    for (int i = 0; i < getNumFilters(); ++i)
+        coefficientSmoother.setCurrentAndTargetValue (i, coefficientSmoother.getTargetValue (i));
+}
+
+template <typename SampleType>
+void StateVariableTPTFilterBank<SampleType>::snapToZero() noexcept
+{
+    for (auto v : { &s1, &s2 })
+        for (auto& element : *v)
+            util::snapToZero (element);
+}
+
+//==============================================================================
+template <typename SampleType>
+void StateVariableTPTFilterBank<SampleType>::processChunk (SampleType* chunk, size_t numFilters, size_t numSamples) noexcept
+{
+    FilterBankHelpers::startRamps (coefficientSmoother, coefficients.data(), increments.data(), numFilters, numSamples);
+
+    auto* ls1 = s1.data();
+    auto* ls2 = s2.data();
+    auto* lR2 = R2.data();
+    auto* g   = coefficients.data();
+    auto* inc = increments.data();
+
+    const auto lpMix = lowpassMix, bpMix = bandpassMix, hpMix = highpassMix;
+
+    for (size_t n = 0; n < numSamples; ++n)
+    {
+        auto* x = chunk + n * numFilters;
+
+        for (size_t i = 0; i < numFilters; ++i)
+        {
+            g[i] += inc[i];
+
+            const auto h = static_cast<SampleType> (1) / (static_cast<SampleType> (1) + lR2[i] * g[i] + g[i] * g[i]);
+
+            const auto yHP = h * (x[i] - ls1[i] * (g[i] + lR2[i]) - ls2[i]);
+
+            const auto yBP = yHP * g[i] + ls1[i];
+            ls1[i]         = yHP * g[i] + yBP;
+
+            const auto yLP = yBP * g[i] + ls2[i];
+            ls2[i]         = yBP * g[i] + yLP;
+
+            x[i] = lpMix * yLP + bpMix * yBP + hpMix * yHP;
+        }
+    }
+}
+
+template <typename SampleType>
+SampleType StateVariableTPTFilterBank<SampleType>::calculateCoefficient (SampleType frequencyHz) const noexcept
+{
+    return static_cast<SampleType> (std::tan (juce::MathConstants<double>::pi * frequencyHz / sampleRate));
+}
+
+//==============================================================================
+template <typename SampleType>
+LadderFilterBank<SampleType>::LadderFilterBank()
+{
+    setDrive (SampleType (1.2));
+
+    mode = Mode::LPF24;
+    setMode (Mode::LPF12);
+}
+
+template <typename SampleType>
+void LadderFilterBank<SampleType>::setMode (Mode newMode) noexcept
+{
+    if (newMode == mode)
+        return;
+
+    switch (newMode)
+    {
+        case Mode::LPF12:   A = {{ SampleType (0), SampleType (0),  SampleType (1), SampleType (0),  SampleType (0) }}; comp = SampleType (0.5);  break;
+        case Mode::HPF12:   A = {{ SampleType (1), SampleType (-2), SampleType (1), SampleType (0),  SampleType (0) }}; comp = SampleType (0);    break;
+        case Mode::BPF12:   A = {{ SampleType (0), SampleType (0), SampleType (-1), SampleType (1),  SampleType (0) }}; comp = SampleType (0.5);  break;
+        case Mode::LPF24:   A = {{ SampleType (0), SampleType (0),  SampleType (0), SampleType (0),  SampleType (1) }}; comp = SampleType (0.5);  break;
+        case Mode::HPF24:   A = {{ SampleType (1), SampleType (-4), SampleType (6), SampleType (-4), SampleType (1) }}; comp = SampleType (0);    break;
+        case Mode::BPF24:   A = {{ SampleType (0), SampleType (0),  SampleType (1), SampleType (-2), SampleType (1) }}; comp = SampleType (0.5);  break;
+        default:            jassertfalse;                                                                                                         break;
+    }
+
+    static constexpr auto outputGain = SampleType (1.2);
+
+    for (auto& a : A)
+        a *= outputGain;
+
+    mode = newMode;
+    reset();
+}
+
+template <typename SampleType>
+void LadderFilterBank<SampleType>::setCutoffFrequencyHz (int filterIndex, SampleType newCutoff) noexcept
+{
+    jassert (isPositiveAndBelow (filterIndex, getNumFilters()));
+    jassert (newCutoff > SampleType (0));
+
+    cutoffFrequencies[(size_t) filterIndex] = newCutoff;
+    cutoffTransformSmoother.setTargetValue (filterIndex, std::exp (newCutoff * cutoffFreqScaler));
+}
+
+template <typename SampleType>
+void LadderFilterBank<SampleType>::setResonance (int filterIndex, SampleType newResonance) noexcept
+{
+    jassert (isPositiveAndBelow (filterIndex, getNumFilters()));
+    jassert (newResonance >= SampleType (0) && newResonance <= SampleType (1));
+
+    scaledResonanceSmoother.setTargetValue (filterIndex, jmap (newResonance, SampleType (0.1), SampleType (1.0)));
+}
+
+template <typename SampleType>
+void LadderFilterBank<SampleType>::setDrive (SampleType newDrive) noexcept
+{
+    jassert (newDrive >= SampleType (1));
+
+    drive = newDrive;
+    gain = std::pow (drive, SampleType (-2.642))   * SampleType (0.6103) + SampleType (0.3903);
+    drive2 = drive                                 * SampleType (0.04)   + SampleType (0.96);
+    gain2 = std::pow (drive2, SampleType (-2.642)) * SampleType (0.6103) + SampleType (0.3903);
+}
+
+//==============================================================================
+template <typename SampleType>
+void LadderFilterBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    cutoffFreqScaler = SampleType (-2.0 * juce::MathConstants<double>::pi / sampleRate);
+
+    const auto numFilters = (size_t) spec.numChannels;
+
+    for (auto& s : state)
+        s.resize (numFilters);
+
+    cutoffFrequencies  .resize (numFilters, SampleType (200));
+    cutoffTransforms   .resize (numFilters);
+    cutoffIncrements   .resize (numFilters);
+    scaledResonances   .resize (numFilters);
+    resonanceIncrements.resize (numFilters);
+    interleaved        .resize (numFilters * FilterBankHelpers::controlInterval);
+
+    static constexpr double smootherRampTimeSec = 0.05;
+
+    for (auto* smoother : { &cutoffTransformSmoother, &scaledResonanceSmoother })
+    {
+        const auto numPrepared = smoother->getNumValues();
+        smoother->setNumValues ((int) numFilters);
+
+        for (auto i = numPrepared; i < (int) numFilters; ++i)
+            smoother->setCurrentAndTargetValue (i, SampleType (0.1));
+
+        smoother->reset (sampleRate, smootherRampTimeSec);
+    }
+
+    for (size_t i = 0; i < numFilters; ++i)
+        cutoffTransformSmoother.setCurrentAndTargetValue ((int) i, std::exp (cutoffFrequencies[i] * cutoffFreqScaler));
+
+    reset();
+}
+
+template <typename SampleType>
+void LadderFilterBank<SampleType>::reset() noexcept
+{
+    for (auto& s : state)
+        std::fill (s.begin(), s.end(), SampleType (0));
+
+    for (int i = 0; i < getNumFilters(); ++i)
+    {
+        cutoffTransformSmoother.setCurrentAndTargetValue (i, cutoffTransformSmoother.getTargetValue (i));
+        scaledResonanceSmoother.setCurrentAndTargetValue (i, scaledResonanceSmoother.getTargetValue (i));
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void LadderFilterBank<SampleType>::processChunk (SampleType* chunk, size_t numFilters, size_t numSamples) noexcept
+{
+    FilterBankHelpers::startRamps (cutoffTransformSmoother, cutoffTransforms.data(), cutoffIncrements.data(), numFilters, numSamples);
+    FilterBankHelpers::startRamps (scaledResonanceSmoother, scaledResonances.data(), resonanceIncrements.data(), numFilters, numSamples);
+
+    auto* s0 = state[0].data();
+    auto* s1 = state[1].data();
+    auto* s2 = state[2].data();
+    auto* s3 = state[3].data();
+    auto* s4 = state[4].data();
+
+    auto* a1s     = cutoffTransforms.data();
+    auto* a1Inc   = cutoffIncrements.data();
+    auto* resos   = scaledResonances.data();
+    auto* resoInc = resonanceIncrements.data();
+
+    // local copies, so that the compiler knows the samples can't alias them
+    const auto mix = A;
+    const auto inputDrive = drive, feedbackDrive = drive2, inputGain = gain, feedbackGain = gain2, compensation = comp;
+
+    for (size_t n = 0; n < numSamples; ++n)
+    {
+        auto* x = chunk + n * numFilters;
+
+        for (size_t i = 0; i < numFilters; ++i)
+        {
+            a1s[i]   += a1Inc[i];
+            resos[i] += resoInc[i];
+
+            const auto a1 = a1s[i];
+            const auto g = a1 * SampleType (-1) + SampleType (1);
+            const auto b0 = g * SampleType (0.76923076923);
+            const auto b1 = g * SampleType (0.23076923076);
+
+            const auto dx = inputGain * saturate (inputDrive * x[i]);
+            const auto a  = dx + resos[i] * SampleType (-4) * (feedbackGain * saturate (feedbackDrive * s4[i]) - dx * compensation);
+
+            const auto b = b1 * s0[i] + a1 * s1[i] + b0 * a;
+            const auto c = b1 * s1[i] + a1 * s2[i] + b0 * b;
+            const auto d = b1 * s2[i] + a1 * s3[i] + b0 * c;
+            const auto e = b1 * s3[i] + a1 * s4[i] + b0 * d;
+
+            s0[i] = a;
+            s1[i] = b;
+            s2[i] = c;
+            s3[i] = d;
+            s4[i] = e;
+
+            x[i] = a * mix[0] + b * mix[1] + c * mix[2] + d * mix[3] + e * mix[4];
+        }
+    }
+}
+
+//==============================================================================
+template class FirstOrderTPTFilterBank<float>;
+template class FirstOrderTPTFilterBank<double>;
+template class StateVariableTPTFilterBank<float>;
+template class StateVariableTPTFilterBank<double>;
+template class LadderFilterBank<float>;
+template class LadderFilterBank<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,401 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+#ifndef DOXYGEN
+namespace FilterBankHelpers // Internal helpers shared by the filter banks
+{
+    /** The number of samples between coefficient updates. The coefficients are
+        interpolated linearly within each of these chunks.
+    */
+    constexpr size_t controlInterval = 32;
+
+    /** Reads the start of a linear coefficient ramp for each filter, then advances
+        the smoothers by a chunk so that the ramps end at the new current values.
+    */
+    template <typename SampleType>
+    void startRamps (SmoothedValueBank<SampleType>& smoother, SampleType* values,
+                     SampleType* increments, size_t numFilters, size_t numSamples) noexcept
+    {
+        for (size_t i = 0; i < numFilters; ++i)
+            values[i] = smoother.getCurrentValue ((int) i);
+
+        smoother.skip ((int) numSamples);
+        const auto scale = static_cast<SampleType> (1) / static_cast<SampleType> (numSamples);
+
+        for (size_t i = 0; i < numFilters; ++i)
+            increments[i] = (smoother.getCurrentValue ((int) i) - values[i]) * scale;
+    }
+
+    /** Runs a filter bank over a processing context, one channel per filter.
+
+        The channels are interleaved in chunks of controlInterval samples, so that the
+        filter kernel can run across all of the filters for each sample in turn. That
+        inner loop has no dependencies between filters, which lets the compiler pack
+        the filters into SIMD lanes. The kernel is called as
+        processChunk (interleavedSamples, numFilters, numSamples).
+    */
+    template <typename SampleType, typename ProcessContext, typename ChunkProcessor>
+    void process (const ProcessContext& context, std::vector<SampleType>& interleaved,
+                  size_t numPreparedFilters, ChunkProcessor&& processChunk) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numFilters  = outputBlock.getNumChannels();
+        const auto numSamples  = outputBlock.getNumSamples();
+
+        jassert (numFilters <= numPreparedFilters);
+        jassert (inputBlock.getNumChannels() == numFilters);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+        ignoreUnused (numPreparedFilters);
+
+        if (context.isBypassed)
+        {
+            outputBlock.copyFrom (inputBlock);
+            return;
+        }
+
+        auto* chunk = interleaved.data();
+
+        for (size_t start = 0; start < numSamples; start += controlInterval)
+        {
+            const auto num = jmin (controlInterval, numSamples - start);
+
+            for (size_t filter = 0; filter < numFilters; ++filter)
+            {
+                auto* input = inputBlock.getChannelPointer (filter) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    chunk[i * numFilters + filter] = input[i];
+            }
+
+            processChunk (chunk, numFilters, num);
+
+            for (size_t filter = 0; filter < numFilters; ++filter)
+            {
+                auto* output = outputBlock.getChannelPointer (filter) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    output[i] = chunk[i * numFilters + filter];
+            }
+        }
+    }
+}
+#endif
+
+//==============================================================================
+/**
+    A bank of independent FirstOrderTPTFilters, one for each channel of the
+    processed block, which is useful for running a filter per synth voice.
+
+    Every filter shares the same type but has its own cutoff frequency. Cutoff
+    changes are interpolated linearly over 32 samples, so they can be modulated
+    continuously without zipper noise. The filters are processed side by side,
+    so that the compiler can pack them into SIMD registers.
+
+    see FirstOrderTPTFilter, StateVariableTPTFilterBank, LadderFilterBank
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class FirstOrderTPTFilterBank
+{
+public:
+    //==============================================================================
+    using Type = FirstOrderTPTFilterType;
+
+    //==============================================================================
+    /** Constructor. Call prepare() to set the number of filters before use. */
+    FirstOrderTPTFilterBank();
+
+    //==============================================================================
+    /** Sets the type of all of the filters. */
+    void setType (Type newType) noexcept;
+
+    /** Sets the cutoff frequency of one of the filters.
+
+        @param filterIndex      the filter, which is also the channel it processes
+        @param newFrequencyHz   cutoff frequency in Hz
+    */
+    void setCutoffFrequency (int filterIndex, SampleType newFrequencyHz) noexcept;
+
+    //==============================================================================
+    /** Returns the type of the filters. */
+    Type getType() const noexcept                                   { return filterType; }
+
+    /** Returns the cutoff frequency of one of the filters. */
+    SampleType getCutoffFrequency (int filterIndex) const noexcept  { return cutoffFrequencies[(size_t) filterIndex]; }
+
+    /** Returns the number of filters in the bank. */
+    int getNumFilters() const noexcept                              { return (int) state.size(); }
+
+    //==============================================================================
+    /** Initialises the bank, creating one filter for each channel in the spec. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the filters, and jumps any
+        cutoff changes that are still being interpolated to their targets.
+    */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context.
+        Each channel is processed by the filter with the same index.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        FilterBankHelpers::process (context, interleaved, state.size(),
+                                    [this] (SampleType* chunk, size_t numFilters, size_t numSamples)
+        {
+            processChunk (chunk, numFilters, numSamples);
+        });
+
+       #if JUCE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
+    /** Ensure that the state variables are rounded to zero if the state
+        variables are denormals.
+    */
+    void snapToZero() noexcept;
+
+private:
+    //==============================================================================
+    void processChunk (SampleType*, size_t, size_t) noexcept;
+    SampleType calculateCoefficient (SampleType frequencyHz) const noexcept;
+
+    //==============================================================================
+    std::vector<SampleType> state, cutoffFrequencies, coefficients, increments, interleaved;
+    SmoothedValueBank<SampleType> coefficientSmoother;
+
+    double sampleRate = 44100.0;
+    Type filterType = Type::lowpass;
+    SampleType inputMix = 0, outputMix = 1;
+};
+
+//==============================================================================
+/**
+    A bank of independent StateVariableTPTFilters, one for each channel of the
+    processed block, which is useful for running a filter per synth voice.
+
+    Every filter shares the same type but has its own cutoff frequency and
+    resonance. Cutoff changes are interpolated linearly over 32 samples, so they
+    can be modulated continuously without zipper noise. The filters are processed
+    side by side, so that the compiler can pack them into SIMD registers.
+
+    see StateVariableTPTFilter, FirstOrderTPTFilterBank, LadderFilterBank
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class StateVariableTPTFilterBank
+{
+public:
+    //==============================================================================
+    using Type = StateVariableTPTFilterType;
+
+    //==============================================================================
+    /** Constructor. Call prepare() to set the number of filters before use. */
+    StateVariableTPTFilterBank();
+
+    //==============================================================================
+    /** Sets the type of all of the filters. */
+    void setType (Type newType) noexcept;
+
+    /** Sets the cutoff frequency of one of the filters.
+
+        @param filterIndex      the filter, which is also the channel it processes
+        @param newFrequencyHz   cutoff frequency in Hz
+    */
+    void setCutoffFrequency (int filterIndex, SampleType newFrequencyHz) noexcept;
+
+    /** Sets the resonance of one of the filters.
+
+        @see StateVariableTPTFilter::setResonance
+    */
+    void setResonance (int filterIndex, SampleType newResonance) noexcept;
+
+    //==============================================================================
+    /** Returns the type of the filters. */
+    Type getType() const noexcept                                   { return filterType; }
+
+    /** Returns the cutoff frequency of one of the filters. */
+    SampleType getCutoffFrequency (int filterIndex) const noexcept  { return cutoffFrequencies[(size_t) filterIndex]; }
+
+    /** Returns the resonance of one of the filters. */
+    SampleType getResonance (int filterIndex) const noexcept        { return resonances[(size_t) filterIndex]; }
+
+    /** Returns the number of filters in the bank. */
+    int getNumFilters() const noexcept                              { return (int) s1.size(); }
+
+    //==============================================================================
+    /** Initialises the bank, creating one filter for each channel in the spec. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the filters, and jumps any
+        cutoff changes that are still being interpolated to their targets.
+    */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context.
+        Each channel is processed by the filter with the same index.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        FilterBankHelpers::process (context, interleaved, s1.size(),
+                                    [this] (SampleType* chunk, size_t numFilters, size_t numSamples)
+        {
+            processChunk (chunk, numFilters, numSamples);
+        });
+
+       #if JUCE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
+    /** Ensure that the state variables are rounded to zero if the state
+        variables are denormals.
+    */
+    void snapToZero() noexcept;
+
+private:
+    //==============================================================================
+    void processChunk (SampleType*, size_t, size_t) noexcept;
+    SampleType calculateCoefficient (SampleType frequencyHz) const noexcept;
+
+    //==============================================================================
+    std::vector<SampleType> s1, s2, cutoffFrequencies, resonances, R2,
+                            coefficients, increments, interleaved;
+    SmoothedValueBank<SampleType> coefficientSmoother;
+
+    double sampleRate = 44100.0;
+    Type filterType = Type::lowpass;
+    SampleType lowpassMix = 1, bandpassMix = 0, highpassMix = 0;
+};
+
+//==============================================================================
+/**
+    A bank of independent LadderFilters, one for each channel of the processed
+    block, which is useful for running a filter per synth voice.
+
+    Every filter shares the same mode and drive but has its own cutoff frequency
+    and resonance, which are smoothed like those of LadderFilter. The filters are
+    processed side by side, so that the compiler can pack them into SIMD
+    registers, and the saturation uses a polynomial tanh approximation rather than
+    a lookup table so that it can be vectorised too.
+
+    see LadderFilter, FirstOrderTPTFilterBank, StateVariableTPTFilterBank
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class LadderFilterBank
+{
+public:
+    //==============================================================================
+    using Mode = LadderFilterMode;
+
+    //==============================================================================
+    /** Constructor. Call prepare() to set the number of filters before use. */
+    LadderFilterBank();
+
+    /** Sets the mode of all of the filters. */
+    void setMode (Mode newMode) noexcept;
+
+    /** Sets the cutoff frequency of one of the filters.
+
+        @param filterIndex  the filter, which is also the channel it processes
+        @param newCutoff    cutoff frequency in Hz
+    */
+    void setCutoffFrequencyHz (int filterIndex, SampleType newCutoff) noexcept;
+
+    /** Sets the resonance of one of the filters.
+
+        @param filterIndex   the filter, which is also the channel it processes
+        @param newResonance  a value between 0 and 1; higher values increase the resonance and can result in self oscillation!
+    */
+    void setResonance (int filterIndex, SampleType newResonance) noexcept;
+
+    /** Sets the amount of saturation in all of the filters.
+
+        @param newDrive saturation amount; it can be any number greater than or equal to one. Higher values result in more distortion.
+    */
+    void setDrive (SampleType newDrive) noexcept;
+
+    /** Returns the number of filters in the bank. */
+    int getNumFilters() const noexcept    { return (int) cutoffFrequencies.size(); }
+
+    //==============================================================================
+    /** Initialises the bank, creating one filter for each channel in the spec. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the filters. */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context.
+        Each channel is processed by the filter with the same index.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        FilterBankHelpers::process (context, interleaved, cutoffFrequencies.size(),
+                                    [this] (SampleType* chunk, size_t numFilters, size_t numSamples)
+        {
+            processChunk (chunk, numFilters, numSamples);
+        });
+    }
+
+private:
+    //==============================================================================
+    void processChunk (SampleType*, size_t, size_t) noexcept;
+
+    static SampleType saturate (SampleType x) noexcept
+    {
+        return FastMathApproximations::tanh (jlimit (SampleType (-5), SampleType (5), x));
+    }
+
+    //==============================================================================
+    static constexpr size_t numStates = 5;
+    std::array<std::vector<SampleType>, numStates> state;
+    std::array<SampleType, numStates> A;
+
+    std::vector<SampleType> cutoffFrequencies, cutoffTransforms, cutoffIncrements,
+                            scaledResonances, resonanceIncrements, interleaved;
+    SmoothedValueBank<SampleType> cutoffTransformSmoother, scaledResonanceSmoother;
+
+    SampleType drive, drive2, gain, gain2, comp;
+    SampleType cutoffFreqScaler;
+    double sampleRate = 44100.0;
+    Mode mode;
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class FilterBanksTest : public UnitTest
+{
+public:
+    FilterBanksTest()
+        : UnitTest ("Filter banks", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        beginTest ("FirstOrderTPTFilterBank matches FirstOrderTPTFilter");
+        {
+            for (auto type : { FirstOrderTPTFilterType::lowpass, FirstOrderTPTFilterType::highpass, FirstOrderTPTFilterType::allpass })
+            {
+                FirstOrderTPTFilterBank<float> bank;
+                bank.prepare ({ sampleRate, (uint32) numSamples, numFilters });
+                bank.setType (type);
+
+                for (int i = 0; i < (int) numFilters; ++i)
+                    bank.setCutoffFrequency (i, cutoffs[i]);
+
+                bank.reset();
+
+                expectBankMatchesFilters (bank, [type] (int i)
+                {
+                    auto filter = std::make_unique<FirstOrderTPTFilter<float>>();
+                    filter->setType (type);
+                    filter->setCutoffFrequency (cutoffs[i]);
+                    return filter;
+                }, 1.0e-5f);
+            }
+        }
+
+        beginTest ("StateVariableTPTFilterBank matches StateVariableTPTFilter");
+        {
+            for (auto type : { StateVariableTPTFilterType::lowpass, StateVariableTPTFilterType::bandpass, StateVariableTPTFilterType::highpass })
+            {
+                StateVariableTPTFilterBank<float> bank;
+                bank.prepare ({ sampleRate, (uint32) numSamples, numFilters });
+                bank.setType (type);
+
+                for (int i = 0; i < (int) numFilters; ++i)
+                {
+                    bank.setCutoffFrequency (i, cutoffs[i]);
+                    bank.setResonance (i, resonances[i]);
+                }
+
+                bank.reset();
+
+                expectBankMatchesFilters (bank, [type] (int i)
+                {
+                    auto filter = std::make_unique<StateVariableTPTFilter<float>>();
+                    filter->setType (type);
+                    filter->setCutoffFrequency (cutoffs[i]);
+                    filter->setResonance (resonances[i]);
+                    return filter;
+                }, 1.0e-4f);
+            }
+        }
+
+        beginTest ("LadderFilterBank matches LadderFilter");
+        {
+            for (auto mode : { LadderFilterMode::LPF12, LadderFilterMode::HPF24, LadderFilterMode::BPF24 })
+            {
+                LadderFilterBank<float> bank;
+                bank.setMode (mode);
+                bank.prepare ({ sampleRate, (uint32) numSamples, numFilters });
+
+                for (int i = 0; i < (int) numFilters; ++i)
+                {
+                    bank.setCutoffFrequencyHz (i, cutoffs[i]);
+                    bank.setResonance (i, 0.5f);
+                }
+
+                bank.reset();
+
+                // the bank saturates with a polynomial rather than a lookup table,
+                // so only expect it to be close
+                expectBankMatchesFilters (bank, [mode] (int i)
+                {
+                    auto filter = std::make_unique<LadderFilter<float>>();
+                    filter->setMode (mode);
+                    filter->setCutoffFrequencyHz (cutoffs[i]);
+                    filter->setResonance (0.5f);
+                    return filter;
+                }, 1.0e-2f);
+            }
+        }
+
+        beginTest ("Modulating one filter doesn't affect the others");
+        {
+            StateVariableTPTFilterBank<float> modulated, reference;
+
+            for (auto* bank : { &modulated, &reference })
+                bank->prepare ({ sampleRate, (uint32) numSamples, numFilters });
+
+            auto input = createSignal();
+            AudioBuffer<float> modulatedOutput (input), referenceOutput (input);
+
+            for (int start = 0; start < numSamples; start += 50)
+            {
+                modulated.setCutoffFrequency (1, 200.0f + (float) start);
+
+                AudioBlock<float> modulatedBlock (modulatedOutput.getArrayOfWritePointers(), numFilters, (size_t) start, 50);
+                AudioBlock<float> referenceBlock (referenceOutput.getArrayOfWritePointers(), numFilters, (size_t) start, 50);
+                modulated.process (ProcessContextReplacing<float> (modulatedBlock));
+                reference.process (ProcessContextReplacing<float> (referenceBlock));
+            }
+
+            for (int channel : { 0, 2 })
+                for (int i = 0; i < numSamples; ++i)
+                    expectEquals (modulatedOutput.getSample (channel, i), referenceOutput.getSample (channel, i));
+
+            expect (modulatedOutput.getSample (1, numSamples - 1) != referenceOutput.getSample (1, numSamples - 1));
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int numSamples = 1000;
+    static constexpr uint32 numFilters = 3;
+
+    static constexpr float cutoffs[]    = { 300.0f, 2000.0f, 9000.0f };
+    static constexpr float resonances[] = { 0.5f, 0.70710678f, 4.0f };
+
+    static AudioBuffer<float> createSignal()
+    {
+        AudioBuffer<float> buffer ((int) numFilters, numSamples);
+        Random random (0x1234);
+
+        for (int channel = 0; channel < (int) numFilters; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, random.nextFloat() - 0.5f);
+
+        return buffer;
+    }
+
+    template <typename Bank, typename CreateFilter>
+    void expectBankMatchesFilters (Bank& bank, CreateFilter&& createFilter, float tolerance)
+    {
+        auto input = createSignal();
+        AudioBuffer<float> output (input);
+
+        // use an odd block size, so that the control-rate chunks don't line up with the blocks
+        for (int start = 0; start < numSamples; start += 77)
+        {
+            AudioBlock<float> block (output.getArrayOfWritePointers(), numFilters,
+                                     (size_t) start, (size_t) jmin (77, numSamples - start));
+            bank.process (ProcessContextReplacing<float> (block));
+        }
+
+        for (int i = 0; i < (int) numFilters; ++i)
+        {
+            auto filter = createFilter (i);
+            filter->prepare ({ sampleRate, (uint32) numSamples, 1 });
+
+            AudioBuffer<float> expected (1, numSamples);
+            expected.copyFrom (0, 0, input, i, 0, numSamples);
+
+            AudioBlock<float> block (expected);
+            filter->process (ProcessContextReplacing<float> (block));
+
+            for (int n = 0; n < numSamples; ++n)
+                expectWithinAbsoluteError (output.getSample (i, n), expected.getSample (0, n), tolerance);
+        }
+    }
+};
+
+constexpr float FilterBanksTest::cutoffs[];
+constexpr float FilterBanksTest::resonances[];
+
+static FilterBanksTest filterBanksUnitTest;
+
+} // namespace dsp
+} // namespace juce
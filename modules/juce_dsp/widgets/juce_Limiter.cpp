@@ -43,6 +43,19 @@ void Limiter<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Limiter<SampleType>::setLookahead (SampleType newLookahead)
+{
+    secondStageCompressor.setLookahead (newLookahead);
+}
+
+template <typename SampleType>
+void Limiter<SampleType>::setChannelLinking (bool shouldLinkChannels) noexcept
+{
+    firstStageCompressor .setChannelLinking (shouldLinkChannels);
+    secondStageCompressor.setChannelLinking (shouldLinkChannels);
+}
+
 //==============================================================================
 template <typename SampleType>
 void Limiter<SampleType>::prepare (const ProcessSpec& spec)
@@ -49,6 +49,21 @@ public:
     /** Sets the release time in milliseconds of the limiter.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets the lookahead time in milliseconds, up to a maximum of 20 ms.
+
+        The final limiting stage then reacts to peaks before they are heard, at the
+        cost of the latency reported by getLatencyInSamples().
+    */
+    void setLookahead (SampleType newLookahead);
+
+    /** Sets whether every channel is limited with the same gain, derived from the
+        loudest channel. By default the channels are processed independently.
+    */
+    void setChannelLinking (bool shouldLinkChannels) noexcept;
+
+    /** Returns the latency introduced by the lookahead, in samples. */
+    int getLatencyInSamples() const noexcept    { return secondStageCompressor.getLatencyInSamples(); }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
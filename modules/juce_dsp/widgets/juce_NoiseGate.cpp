@@ -69,6 +69,16 @@ void NoiseGate<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void NoiseGate<SampleType>::setLookahead (SampleType newLookahead)
+{
+    jassert (newLookahead >= static_cast<SampleType> (0.0)
+             && newLookahead <= static_cast<SampleType> (DynamicsHelpers::maximumLookaheadMs));
+
+    lookaheadTime = newLookahead;
+    update();
+}
+
 //==============================================================================
 template <typename SampleType>
 void NoiseGate<SampleType>::prepare (const ProcessSpec& spec)
@@ -80,6 +90,7 @@ void NoiseGate<SampleType>::prepare (const ProcessSpec& spec)
 
     RMSFilter.prepare (spec);
     envelopeFilter.prepare (spec);
+    lookahead.prepare (spec);
 
     update();
     reset();
@@ -90,6 +101,7 @@ void NoiseGate<SampleType>::reset()
 {
     RMSFilter.reset();
     envelopeFilter.reset();
+    lookahead.reset();
 }
 
 //==============================================================================
@@ -119,6 +131,8 @@ void NoiseGate<SampleType>::update()
 
     envelopeFilter.setAttackTime  (attackTime);
     envelopeFilter.setReleaseTime (releaseTime);
+
+    lookahead.setDelay (roundToInt (lookaheadTime * sampleRate / 1000.0));
 }
 
 //==============================================================================
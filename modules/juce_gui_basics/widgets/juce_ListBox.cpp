@@ -38,7 +38,7 @@ public:
             m->paintListBoxItem (row, g, getWidth(), getHeight(), selected);
     }
 
-    void update (const int newRow, const bool nowSelected)
+    void update (const int newRow, const bool nowSelected, const bool forceRefresh)
     {
         if (row != newRow || selected != nowSelected)
         {
@@ -46,6 +46,12 @@ public:
             row = newRow;
             selected = nowSelected;
         }
+        else if (! forceRefresh)
+        {
+            // this row component is already showing the right row, so there's no
+            // need to ask the model to rebuild its custom component again
+            return;
+        }
 
         if (auto* m = owner.getModel())
         {
@@ -211,7 +217,7 @@ public:
         auto newX = content.getX();
         auto newY = content.getY();
         auto newW = jmax (owner.minimumRowWidth, getMaximumVisibleWidth());
-        auto newH = owner.totalItems * owner.getRowHeight();
+        auto newH = owner.getRowTop (owner.totalItems);
 
         if (newY + newH < getMaximumVisibleHeight() && newH > getMaximumVisibleHeight())
             newY = getMaximumVisibleHeight() - newH;
@@ -233,8 +239,32 @@ public:
             auto y = getViewPositionY();
             auto w = content.getWidth();
 
-            const int numNeeded = 2 + getMaximumVisibleHeight() / rowH;
-            rows.removeRange (numNeeded, rows.size());
+            int numNeeded;
+
+            if (owner.variableRowHeights)
+            {
+                firstIndex = owner.getRowAtY (y);
+                firstWholeIndex = owner.getRowTop (firstIndex) < y ? firstIndex + 1 : firstIndex;
+                lastWholeIndex = owner.getRowAtY (y + getMaximumVisibleHeight() - 1);
+                numNeeded = lastWholeIndex - firstIndex + 2;
+
+                // When the rows have different heights, the number needed changes as the list
+                // scrolls, so the pool is only allowed to grow here. Shrinking it would re-map
+                // every row to a different component, so that's left until the next full refresh.
+                if (needsFullRefresh)
+                    rows.removeRange (numNeeded, rows.size());
+                else
+                    numNeeded = jmax (numNeeded, rows.size());
+            }
+            else
+            {
+                numNeeded = 2 + getMaximumVisibleHeight() / rowH;
+                rows.removeRange (numNeeded, rows.size());
+
+                firstIndex = y / rowH;
+                firstWholeIndex = (y + rowH - 1) / rowH;
+                lastWholeIndex = (y + getMaximumVisibleHeight() - 1) / rowH;
+            }
 
             while (numNeeded > rows.size())
             {
@@ -243,20 +273,18 @@ public:
                 content.addAndMakeVisible (newRow);
             }
 
-            firstIndex = y / rowH;
-            firstWholeIndex = (y + rowH - 1) / rowH;
-            lastWholeIndex = (y + getMaximumVisibleHeight() - 1) / rowH;
-
             for (int i = 0; i < numNeeded; ++i)
             {
                 const int row = i + firstIndex;
 
                 if (auto* rowComp = getComponentForRow (row))
                 {
-                    rowComp->setBounds (0, row * rowH, w, rowH);
-                    rowComp->update (row, owner.isRowSelected (row));
+                    rowComp->setBounds (0, owner.getRowTop (row), w, owner.getHeightOfRow (row));
+                    rowComp->update (row, owner.isRowSelected (row), needsFullRefresh);
                 }
             }
+
+            needsFullRefresh = false;
         }
 
         if (owner.headerComponent != nullptr)
@@ -267,14 +295,14 @@ public:
                                               owner.headerComponent->getHeight());
     }
 
-    void selectRow (const int row, const int rowH, const bool dontScroll,
+    void selectRow (const int row, const bool dontScroll,
                     const int lastSelectedRow, const int totalRows, const bool isMouseClick)
     {
         hasUpdated = false;
 
         if (row < firstWholeIndex && ! dontScroll)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowTop (row));
         }
         else if (row >= lastWholeIndex && ! dontScroll)
         {
@@ -285,12 +313,12 @@ public:
                  && ! isMouseClick)
             {
                 setViewPosition (getViewPositionX(),
-                                 jlimit (0, jmax (0, totalRows - rowsOnScreen), row) * rowH);
+                                 owner.getRowTop (jlimit (0, jmax (0, totalRows - rowsOnScreen), row)));
             }
             else
             {
                 setViewPosition (getViewPositionX(),
-                                 jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                                 jmax (0, owner.getRowTop (row + 1) - getMaximumVisibleHeight()));
             }
         }
 
@@ -298,19 +326,27 @@ public:
             updateContents();
     }
 
-    void scrollToEnsureRowIsOnscreen (const int row, const int rowH)
+    void scrollToEnsureRowIsOnscreen (const int row)
     {
         if (row < firstWholeIndex)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowTop (row));
         }
         else if (row >= lastWholeIndex)
         {
             setViewPosition (getViewPositionX(),
-                             jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                             jmax (0, owner.getRowTop (row + 1) - getMaximumVisibleHeight()));
         }
     }
 
+    /** Makes the next call to updateContents() refresh every row, even the ones
+        whose row number and selection state haven't changed.
+    */
+    void refreshAllRowsOnNextUpdate() noexcept
+    {
+        needsFullRefresh = true;
+    }
+
     void paint (Graphics& g) override
     {
         if (isOpaque())
@@ -338,7 +374,7 @@ private:
     ListBox& owner;
     OwnedArray<RowComponent> rows;
     int firstIndex = 0, firstWholeIndex = 0, lastWholeIndex = 0;
-    bool hasUpdated = false;
+    bool hasUpdated = false, needsFullRefresh = true;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListViewport)
 };
@@ -469,6 +505,9 @@ void ListBox::updateContent()
         selectionChanged = true;
     }
 
+    updateRowPositions();
+
+    viewport->refreshAllRowsOnNextUpdate();
     viewport->updateVisibleArea (isVisible());
     viewport->resized();
 
@@ -503,7 +542,7 @@ void ListBox::selectRowInternal (const int row,
             if (getHeight() == 0 || getWidth() == 0)
                 dontScroll = true;
 
-            viewport->selectRow (row, getRowHeight(), dontScroll,
+            viewport->selectRow (row, dontScroll,
                                  lastRowSelected, totalItems, isMouseClick);
 
             lastRowSelected = row;
@@ -634,7 +673,7 @@ int ListBox::getRowContainingPosition (const int x, const int y) const noexcept
 {
     if (isPositiveAndBelow (x, getWidth()))
     {
-        const int row = (viewport->getViewPositionY() + y - viewport->getY()) / rowHeight;
+        const int row = getRowAtY (viewport->getViewPositionY() + y - viewport->getY());
 
         if (isPositiveAndBelow (row, totalItems))
             return row;
@@ -646,7 +685,19 @@ int ListBox::getRowContainingPosition (const int x, const int y) const noexcept
 int ListBox::getInsertionIndexForPosition (const int x, const int y) const noexcept
 {
     if (isPositiveAndBelow (x, getWidth()))
-        return jlimit (0, totalItems, (viewport->getViewPositionY() + y + rowHeight / 2 - viewport->getY()) / rowHeight);
+    {
+        auto contentY = viewport->getViewPositionY() + y - viewport->getY();
+
+        if (! variableRowHeights)
+            return jlimit (0, totalItems, (contentY + rowHeight / 2) / rowHeight);
+
+        auto row = getRowAtY (contentY);
+
+        if (row >= 0 && contentY >= getRowTop (row) + getHeightOfRow (row) / 2)
+            ++row;
+
+        return jlimit (0, totalItems, row);
+    }
 
     return -1;
 }
@@ -666,13 +717,13 @@ int ListBox::getRowNumberOfComponent (Component* const rowComponent) const noexc
 
 Rectangle<int> ListBox::getRowPosition (int rowNumber, bool relativeToComponentTopLeft) const noexcept
 {
-    auto y = viewport->getY() + rowHeight * rowNumber;
+    auto y = viewport->getY() + getRowTop (rowNumber);
 
     if (relativeToComponentTopLeft)
         y -= viewport->getViewPositionY();
 
     return { viewport->getX(), y,
-             viewport->getViewedComponent()->getWidth(), rowHeight };
+             viewport->getViewedComponent()->getWidth(), getHeightOfRow (rowNumber) };
 }
 
 void ListBox::setVerticalPosition (const double proportion)
@@ -698,13 +749,14 @@ int ListBox::getVisibleRowWidth() const noexcept
 
 void ListBox::scrollToEnsureRowIsOnscreen (const int row)
 {
-    viewport->scrollToEnsureRowIsOnscreen (row, getRowHeight());
+    viewport->scrollToEnsureRowIsOnscreen (row);
 }
 
 //==============================================================================
 bool ListBox::keyPressed (const KeyPress& key)
 {
-    const int numVisibleRows = viewport->getHeight() / getRowHeight();
+    const int numVisibleRows = variableRowHeights ? getNumRowsOnScreen()
+                                                  : viewport->getHeight() / getRowHeight();
 
     const bool multiple = multipleSelection
                             && lastRowSelected >= 0
@@ -823,7 +875,106 @@ void ListBox::setRowHeight (const int newHeight)
 
 int ListBox::getNumRowsOnScreen() const noexcept
 {
-    return viewport->getMaximumVisibleHeight() / rowHeight;
+    if (! variableRowHeights)
+        return viewport->getMaximumVisibleHeight() / rowHeight;
+
+    auto top = viewport->getViewPositionY();
+    auto bottom = top + viewport->getMaximumVisibleHeight();
+    auto firstWholeRow = getRowAtY (top);
+
+    if (getRowTop (firstWholeRow) < top)
+        ++firstWholeRow;
+
+    return jmax (0, getRowAtY (bottom) - firstWholeRow);
+}
+
+void ListBox::setVariableRowHeightsEnabled (bool shouldBeEnabled)
+{
+    if (variableRowHeights != shouldBeEnabled)
+    {
+        variableRowHeights = shouldBeEnabled;
+        updateContent();
+    }
+}
+
+void ListBox::rowHeightChanged (int rowNumber)
+{
+    if (! (variableRowHeights && isPositiveAndBelow (rowNumber, totalItems)
+            && rowStarts.size() == totalItems + 1))
+        return;
+
+    auto delta = getHeightFromModel (rowNumber) - getHeightOfRow (rowNumber);
+
+    if (delta != 0)
+    {
+        for (int i = rowNumber + 1; i <= totalItems; ++i)
+            rowStarts.getReference (i) += delta;
+
+        viewport->updateVisibleArea (true);
+    }
+}
+
+//==============================================================================
+int ListBox::getHeightFromModel (int rowNumber) const
+{
+    auto h = model != nullptr ? model->getHeightForRow (rowNumber) : 0;
+    return h > 0 ? h : rowHeight;
+}
+
+void ListBox::updateRowPositions()
+{
+    rowStarts.clearQuick();
+
+    if (variableRowHeights)
+    {
+        rowStarts.ensureStorageAllocated (totalItems + 1);
+        rowStarts.add (0);
+
+        for (int i = 0, y = 0; i < totalItems; ++i)
+            rowStarts.add (y += getHeightFromModel (i));
+    }
+}
+
+int ListBox::getRowTop (int rowNumber) const noexcept
+{
+    if (! variableRowHeights || rowStarts.isEmpty())
+        return rowNumber * rowHeight;
+
+    if (rowNumber <= 0)
+        return rowNumber * rowHeight;
+
+    auto numRows = rowStarts.size() - 1;
+
+    if (rowNumber > numRows)
+        return rowStarts.getLast() + (rowNumber - numRows) * rowHeight;
+
+    return rowStarts.getUnchecked (rowNumber);
+}
+
+int ListBox::getHeightOfRow (int rowNumber) const noexcept
+{
+    if (variableRowHeights && isPositiveAndBelow (rowNumber, rowStarts.size() - 1))
+        return rowStarts.getUnchecked (rowNumber + 1) - rowStarts.getUnchecked (rowNumber);
+
+    return rowHeight;
+}
+
+int ListBox::getRowAtY (int y) const noexcept
+{
+    if (! variableRowHeights || rowStarts.isEmpty())
+        return y / rowHeight;
+
+    if (y < 0)
+        return -1;
+
+    auto numRows = rowStarts.size() - 1;
+    auto total = rowStarts.getLast();
+
+    if (y >= total)
+        return numRows + (y - total) / rowHeight;
+
+    // rowStarts is sorted, so the row is the last one that starts at or above y
+    return (int) (std::upper_bound (rowStarts.begin(), rowStarts.end(), y) - rowStarts.begin()) - 1;
 }
 
 void ListBox::setMinimumContentWidth (const int newMinimumWidth)
@@ -956,5 +1107,6 @@ void ListBoxModel::listWasScrolled() {}
 var ListBoxModel::getDragSourceDescription (const SparseSet<int>&)      { return {}; }
 String ListBoxModel::getTooltipForRow (int)                             { return {}; }
 MouseCursor ListBoxModel::getMouseCursorForRow (int)                    { return MouseCursor::NormalCursor; }
+int ListBoxModel::getHeightForRow (int)                                 { return 0; }
 
 } // namespace juce
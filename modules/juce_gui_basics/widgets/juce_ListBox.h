@@ -157,6 +157,19 @@ public:
 
     /** You can override this to return a custom mouse cursor for each row. */
     virtual MouseCursor getMouseCursorForRow (int row);
+
+    /** If the list has variable row heights enabled, this is called to find out how tall
+        each row should be.
+
+        Returning 0 (which is what the default implementation does) means that the row
+        will use the list's default height, as set by ListBox::setRowHeight().
+
+        The heights are read when ListBox::updateContent() is called, so if a row's height
+        changes after that, call ListBox::rowHeightChanged() or ListBox::updateContent().
+
+        @see ListBox::setVariableRowHeightsEnabled
+    */
+    virtual int getHeightForRow (int rowNumber);
 };
 
 
@@ -442,10 +455,41 @@ public:
     void setRowHeight (int newHeight);
 
     /** Returns the height of a row in the list.
+
+        If variable row heights are enabled, this is the default height used by any rows
+        for which the model doesn't specify one.
+
         @see setRowHeight
     */
     int getRowHeight() const noexcept                   { return rowHeight; }
 
+    /** Enables or disables rows of different heights.
+
+        When enabled, the list will call ListBoxModel::getHeightForRow() for each of its rows
+        whenever updateContent() is called, and keeps a running total of the heights so that
+        finding the row at a given position stays fast, even for very long lists.
+
+        By default this is disabled, and all rows have the height set by setRowHeight().
+
+        @see ListBoxModel::getHeightForRow, rowHeightChanged
+    */
+    void setVariableRowHeightsEnabled (bool shouldBeEnabled);
+
+    /** Returns true if variable row heights have been enabled.
+        @see setVariableRowHeightsEnabled
+    */
+    bool areVariableRowHeightsEnabled() const noexcept  { return variableRowHeights; }
+
+    /** Tells the list that the height of one of its rows has changed.
+
+        This re-reads the row's height from ListBoxModel::getHeightForRow() and moves any
+        rows below it, without having to query the model for the height of every other row.
+        It has no effect unless variable row heights are enabled.
+
+        @see setVariableRowHeightsEnabled
+    */
+    void rowHeightChanged (int rowNumber);
+
     /** Returns the number of rows actually visible.
 
         This is the number of whole rows which will fit on-screen, so the value might
@@ -577,13 +621,20 @@ private:
     std::unique_ptr<Component> headerComponent;
     std::unique_ptr<MouseListener> mouseMoveSelector;
     SparseSet<int> selected;
+    Array<int> rowStarts;
     int totalItems = 0, rowHeight = 22, minimumRowWidth = 0;
     int outlineThickness = 0;
     int lastRowSelected = -1;
     bool multipleSelection = false, alwaysFlipSelection = false, hasDoneInitialUpdate = false, selectOnMouseDown = true;
+    bool variableRowHeights = false;
 
     void selectRowInternal (int rowNumber, bool dontScrollToShowThisRow,
                             bool deselectOthersFirst, bool isMouseClick);
+    int getHeightFromModel (int rowNumber) const;
+    void updateRowPositions();
+    int getRowTop (int rowNumber) const noexcept;
+    int getHeightOfRow (int rowNumber) const noexcept;
+    int getRowAtY (int y) const noexcept;
 
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // This method's bool parameter has changed: see the new method signature.
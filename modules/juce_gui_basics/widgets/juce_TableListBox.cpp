@@ -423,6 +423,11 @@ void TableListBox::listWasScrolled()
         model->listWasScrolled();
 }
 
+int TableListBox::getHeightForRow (int rowNumber)
+{
+    return model != nullptr ? model->getHeightForRow (rowNumber) : 0;
+}
+
 void TableListBox::tableColumnsChanged (TableHeaderComponent*)
 {
     setMinimumContentWidth (header->getTotalWidth());
@@ -477,6 +482,7 @@ void TableListBoxModel::selectedRowsChanged (int)                       {}
 void TableListBoxModel::deleteKeyPressed (int)                          {}
 void TableListBoxModel::returnKeyPressed (int)                          {}
 void TableListBoxModel::listWasScrolled()                               {}
+int TableListBoxModel::getHeightForRow (int)                            { return 0; }
 
 String TableListBoxModel::getCellTooltip (int /*rowNumber*/, int /*columnId*/)    { return {}; }
 var TableListBoxModel::getDragSourceDescription (const SparseSet<int>&)           { return {}; }
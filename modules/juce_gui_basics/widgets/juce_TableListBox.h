@@ -153,6 +153,14 @@ public:
     /** Returns a tooltip for a particular cell in the table. */
     virtual String getCellTooltip (int rowNumber, int columnId);
 
+    /** If the table has variable row heights enabled, this returns the height of a row.
+
+        Returning 0 (the default) means that the row uses the table's default row height.
+
+        @see ListBox::setVariableRowHeightsEnabled, ListBoxModel::getHeightForRow
+    */
+    virtual int getHeightForRow (int rowNumber);
+
     //==============================================================================
     /** Override this to be informed when rows are selected or deselected.
         @see ListBox::selectedRowsChanged()
@@ -323,6 +331,8 @@ public:
     /** @internal */
     void listWasScrolled() override;
     /** @internal */
+    int getHeightForRow (int rowNumber) override;
+    /** @internal */
     void tableColumnsChanged (TableHeaderComponent*) override;
     /** @internal */
     void tableColumnsResized (TableHeaderComponent*) override;
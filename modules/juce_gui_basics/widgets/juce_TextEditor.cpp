@@ -93,6 +93,7 @@ public:
 
                     if (! CharacterFunctions::isWhitespace (first.atomText[0]))
                     {
+                        totalLength += first.numChars;
                         lastAtom.atomText += first.atomText;
                         lastAtom.numChars = (uint16) (lastAtom.numChars + first.numChars);
                         lastAtom.width = font.getStringWidthFloat (lastAtom.getText (passwordChar));
@@ -105,6 +106,7 @@ public:
 
             while (i < other.atoms.size())
             {
+                totalLength += other.atoms.getReference(i).numChars;
                 atoms.add (other.atoms.getReference(i));
                 ++i;
             }
@@ -127,6 +129,8 @@ public:
                     section2->atoms.add (atoms.getUnchecked (j));
 
                 atoms.removeRange (i, atoms.size());
+                section2->totalLength = totalLength - indexToBreakAt;
+                totalLength = indexToBreakAt;
                 break;
             }
 
@@ -147,6 +151,8 @@ public:
                     section2->atoms.add (atoms.getUnchecked (j));
 
                 atoms.removeRange (i + 1, atoms.size());
+                section2->totalLength = totalLength - indexToBreakAt;
+                totalLength = indexToBreakAt;
                 break;
             }
 
@@ -187,12 +193,7 @@ public:
 
     int getTotalLength() const noexcept
     {
-        int total = 0;
-
-        for (auto& atom : atoms)
-            total += atom.numChars;
-
-        return total;
+        return totalLength;
     }
 
     void setFont (const Font& newFont, const juce_wchar passwordCharToUse)
@@ -214,6 +215,8 @@ public:
     juce_wchar passwordChar;
 
 private:
+    int totalLength = 0;
+
     void initialiseAtoms (const String& textToParse)
     {
         auto text = textToParse.getCharPointer();
@@ -266,17 +269,93 @@ private:
             atom.width = font.getStringWidthFloat (atom.getText (passwordChar));
             atom.numChars = (uint16) numChars;
             atoms.add (atom);
+
+            totalLength += atom.numChars;
         }
     }
 
     JUCE_LEAK_DETECTOR (UniformTextSection)
 };
 
+//==============================================================================
+// Remembers the state of the layout at the start of some of the paragraphs, so that an
+// Iterator can begin near the text it's interested in rather than at the very start.
+// Because the layout of a paragraph only depends on the text that comes before it, an
+// edit only needs to discard the checkpoints that follow it.
+struct TextEditor::LayoutCache
+{
+    struct Checkpoint
+    {
+        int sectionIndex, atomIndex, indexInText, nextIndex;
+        float lineY, lineHeight, maxDescent, atomX, atomRight, justificationOffsetX;
+    };
+
+    void checkParameters (float newWordWrapWidth, float newTextWidth, Justification newJustification,
+                          juce_wchar newPasswordCharacter, float newLineSpacing, float newFontHeight)
+    {
+        if (newWordWrapWidth != wordWrapWidth || newTextWidth != textWidth
+             || newJustification != justification || newPasswordCharacter != passwordCharacter
+             || newLineSpacing != lineSpacing || newFontHeight != fontHeight)
+        {
+            wordWrapWidth = newWordWrapWidth;
+            textWidth = newTextWidth;
+            justification = newJustification;
+            passwordCharacter = newPasswordCharacter;
+            lineSpacing = newLineSpacing;
+            fontHeight = newFontHeight;
+            clear();
+        }
+    }
+
+    void clear()
+    {
+        checkpoints.clear();
+    }
+
+    // Removes any checkpoints that could be affected by a change to the text at this index
+    void invalidateFrom (int index)
+    {
+        checkpoints.erase (std::upper_bound (checkpoints.begin(), checkpoints.end(), index,
+                                             [] (int i, const Checkpoint& c) { return i < c.nextIndex; }),
+                           checkpoints.end());
+    }
+
+    void add (const Checkpoint& c)
+    {
+        if (c.nextIndex >= (checkpoints.empty() ? 0 : checkpoints.back().nextIndex) + minCharsBetweenCheckpoints)
+            checkpoints.push_back (c);
+    }
+
+    const Checkpoint* findLastBeforeIndex (int index) const
+    {
+        auto c = std::upper_bound (checkpoints.begin(), checkpoints.end(), index,
+                                   [] (int i, const Checkpoint& cp) { return i < cp.nextIndex; });
+
+        return c == checkpoints.begin() ? nullptr : &*(c - 1);
+    }
+
+    const Checkpoint* findLastAboveY (float y) const
+    {
+        auto c = std::partition_point (checkpoints.begin(), checkpoints.end(),
+                                       [y] (const Checkpoint& cp) { return cp.lineY + cp.lineHeight <= y; });
+
+        return c == checkpoints.begin() ? nullptr : &*(c - 1);
+    }
+
+    static constexpr int minCharsBetweenCheckpoints = 512;
+
+    std::vector<Checkpoint> checkpoints;
+    float wordWrapWidth = 0, textWidth = 0, lineSpacing = 0, fontHeight = 0;
+    Justification justification { 0 };
+    juce_wchar passwordCharacter = 0;
+};
+
 //==============================================================================
 struct TextEditor::Iterator
 {
     Iterator (const TextEditor& ed)
       : sections (ed.sections),
+        layoutCache (*ed.layoutCache),
         justification (ed.justification),
         bottomRight ((float) ed.getMaximumTextWidth(), (float) ed.getMaximumTextHeight()),
         wordWrapWidth ((float) ed.getWordWrapWidth()),
@@ -286,6 +365,9 @@ struct TextEditor::Iterator
     {
         jassert (wordWrapWidth > 0);
 
+        layoutCache.checkParameters (wordWrapWidth, bottomRight.x, justification,
+                                     passwordCharacter, lineSpacing, ed.currentFont.getHeight());
+
         if (! sections.isEmpty())
         {
             currentSection = sections.getUnchecked (sectionIndex);
@@ -300,9 +382,25 @@ struct TextEditor::Iterator
     Iterator (const Iterator&) = default;
     Iterator& operator= (const Iterator&) = delete;
 
+    //==============================================================================
+    // Skips forward to the last cached paragraph that starts at or before this index
+    void skipToIndex (int index)
+    {
+        restoreCheckpoint (layoutCache.findLastBeforeIndex (index));
+    }
+
+    // Skips forward to the last cached paragraph whose preceding line ends above this y position
+    void skipToY (float y)
+    {
+        restoreCheckpoint (layoutCache.findLastAboveY (y));
+    }
+
     //==============================================================================
     bool next()
     {
+        if (atom != nullptr && atom != &tempAtom && atom->isNewLine() && sectionIndex < sections.size())
+            addCheckpoint();
+
         if (atom == &tempAtom)
         {
             auto numRemaining = tempAtom.atomText.length() - tempAtom.numChars;
@@ -689,6 +787,7 @@ struct TextEditor::Iterator
 
 private:
     const OwnedArray<UniformTextSection>& sections;
+    LayoutCache& layoutCache;
     const UniformTextSection* currentSection = nullptr;
     int sectionIndex = 0, atomIndex = 0;
     Justification justification;
@@ -700,6 +799,42 @@ private:
     const bool underlineWhitespace;
     TextAtom tempAtom;
 
+    // A checkpoint is taken just after a new-line atom has been returned, which is the
+    // last point at which the iterator's state only depends on the text before it.
+    void addCheckpoint() const
+    {
+        layoutCache.add ({ sectionIndex, atomIndex, indexInText, indexInText + atom->numChars,
+                           lineY, lineHeight, maxDescent, atomX, atomRight, justificationOffsetX });
+    }
+
+    void restoreCheckpoint (const LayoutCache::Checkpoint* c)
+    {
+        if (c == nullptr || (atom != nullptr && c->indexInText <= indexInText))
+            return;
+
+        auto* section = sections[c->sectionIndex];
+
+        if (section == nullptr || ! isPositiveAndNotGreaterThan (c->atomIndex, section->atoms.size())
+             || c->atomIndex == 0 || ! section->atoms.getReference (c->atomIndex - 1).isNewLine())
+        {
+            jassertfalse; // the cache has got out of step with the text!
+            layoutCache.clear();
+            return;
+        }
+
+        currentSection = section;
+        sectionIndex = c->sectionIndex;
+        atomIndex = c->atomIndex;
+        atom = &(section->atoms.getReference (atomIndex - 1));
+        indexInText = c->indexInText;
+        lineY = c->lineY;
+        lineHeight = c->lineHeight;
+        maxDescent = c->maxDescent;
+        atomX = c->atomX;
+        atomRight = c->atomRight;
+        justificationOffsetX = c->justificationOffsetX;
+    }
+
     void moveToEndOfLastAtom()
     {
         if (atom != nullptr)
@@ -904,6 +1039,7 @@ namespace TextEditorDefs
 //==============================================================================
 TextEditor::TextEditor (const String& name, juce_wchar passwordChar)
     : Component (name),
+      layoutCache (new LayoutCache()),
       passwordCharacter (passwordChar)
 {
     setMouseCursor (MouseCursor::IBeamCursor);
@@ -1062,6 +1198,7 @@ void TextEditor::applyFontToAllText (const Font& newFont, bool changeCurrentFont
         uts->colour = overallColour;
     }
 
+    layoutCache->clear();
     coalesceSimilarSections();
     checkLayout();
     scrollToMakeSureCursorIsVisible();
@@ -1306,6 +1443,7 @@ void TextEditor::repaintText (Range<int> range)
         }
 
         Iterator i (*this);
+        i.skipToIndex (range.getStart());
 
         Point<float> anchor;
         auto lh = currentFont.getHeight();
@@ -1436,7 +1574,10 @@ void TextEditor::checkLayout()
 {
     if (getWordWrapWidth() > 0)
     {
-        auto textBottom = Iterator (*this).getTotalTextHeight() + topIndent;
+        Iterator i (*this);
+        i.skipToIndex (std::numeric_limits<int>::max());
+
+        auto textBottom = i.getTotalTextHeight() + topIndent;
         auto textRight = getMaximumTextWidth() + leftIndent + rightEdgeSpace;
 
         textHolder->setSize (textRight, textBottom);
@@ -1646,6 +1787,7 @@ void TextEditor::drawContent (Graphics& g)
         }
 
         Iterator i (*this);
+        i.skipToY ((float) clip.getY());
         Colour selectedTextColour;
 
         if (! selection.isEmpty())
@@ -1689,6 +1831,7 @@ void TextEditor::drawContent (Graphics& g)
         for (auto& underlinedSection : underlinedSections)
         {
             Iterator i2 (*this);
+            i2.skipToY ((float) clip.getY());
 
             while (i2.next() && i2.lineY < (float) clip.getBottom())
             {
@@ -2254,6 +2397,7 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
         {
             repaintText ({ insertIndex, getTotalNumChars() }); // must do this before and after changing the data, in case
                                                                // a line gets moved due to word wrap
+            layoutCache->invalidateFrom (insertIndex);
 
             int index = 0;
             int nextIndex = 0;
@@ -2295,6 +2439,8 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
 
 void TextEditor::reinsert (int insertIndex, const OwnedArray<UniformTextSection>& sectionsToInsert)
 {
+    layoutCache->invalidateFrom (insertIndex);
+
     int index = 0;
     int nextIndex = 0;
 
@@ -2336,6 +2482,8 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
 {
     if (! range.isEmpty())
     {
+        layoutCache->invalidateFrom (range.getStart());
+
         int index = 0;
 
         for (int i = 0; i < sections.size(); ++i)
@@ -2503,6 +2651,7 @@ void TextEditor::getCharPosition (int index, Point<float>& anchor, float& lineHe
         }
         else
         {
+            i.skipToIndex (index);
             i.getCharPosition (index, anchor, lineHeight);
         }
     }
@@ -2512,7 +2661,10 @@ int TextEditor::indexAtPosition (const float x, const float y)
 {
     if (getWordWrapWidth() > 0)
     {
-        for (Iterator i (*this); i.next();)
+        Iterator i (*this);
+        i.skipToY (y);
+
+        while (i.next())
         {
             if (y < i.lineY + i.lineHeight)
             {
@@ -2589,6 +2741,8 @@ void TextEditor::splitSection (const int sectionIndex, const int charToSplitAt)
 
 void TextEditor::coalesceSimilarSections()
 {
+    int index = 0;
+
     for (int i = 0; i < sections.size() - 1; ++i)
     {
         auto* s1 = sections.getUnchecked (i);
@@ -2597,11 +2751,126 @@ void TextEditor::coalesceSimilarSections()
         if (s1->font == s2->font
              && s1->colour == s2->colour)
         {
+            // The atoms of s2 and all the sections after it are about to move, so any
+            // cached layout positions that refer to them have to go
+            layoutCache->invalidateFrom (index + s1->getTotalLength());
+
             s1->append (*s2);
             sections.remove (i + 1);
             --i;
         }
+        else
+        {
+            index += s1->getTotalLength();
+        }
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct TextEditorTests  : public UnitTest
+{
+    TextEditorTests()
+        : UnitTest ("TextEditor", UnitTestCategories::gui)
+    {}
+
+    void runTest() override
+    {
+        TextEditor editor;
+        editor.setMultiLine (true);
+
+        // tall enough that the editor never needs to scroll
+        editor.setBounds (0, 0, 300, 20000);
+
+        beginTest ("Appending text");
+        {
+            for (int i = 0; i < 120; ++i)
+            {
+                appendLine (editor, i, (i & 1) != 0 ? Colours::red : Colours::blue);
+
+                // the lookups here fill the layout cache, which the following edits must update
+                if (i % 20 == 0)
+                    expectMatchesFreshLayout (editor);
+            }
+
+            expectMatchesFreshLayout (editor);
+        }
+
+        beginTest ("Inserting text");
+        {
+            for (int i = 0; i < 10; ++i)
+            {
+                editor.setColour (TextEditor::textColourId, (i & 1) != 0 ? Colours::green : Colours::red);
+                editor.setCaretPosition (editor.getTotalNumChars() * (10 - i) / 11);
+                editor.insertTextAtCaret ("Some inserted text\nwith a new-line ");
+                expectMatchesFreshLayout (editor);
+            }
+        }
+
+        beginTest ("Changing the colour of all text");
+        {
+            editor.applyColourToAllText (Colours::white);
+            expectMatchesFreshLayout (editor);
+
+            // this merges all of the sections, which now have the same colour
+            appendLine (editor, 1000, Colours::white);
+            expectMatchesFreshLayout (editor);
+        }
+
+        beginTest ("Changing the font of all text");
+        {
+            editor.applyFontToAllText (Font (22.0f));
+            expectMatchesFreshLayout (editor);
+
+            appendLine (editor, 2000, Colours::yellow);
+            expectMatchesFreshLayout (editor);
+
+            editor.setCaretPosition (100);
+            editor.insertTextAtCaret ("More text\n");
+            expectMatchesFreshLayout (editor);
+        }
+    }
+
+    static void appendLine (TextEditor& editor, int lineNumber, Colour colour)
+    {
+        editor.setColour (TextEditor::textColourId, colour);
+        editor.moveCaretToEnd();
+        editor.insertTextAtCaret ("Line " + String (lineNumber) + " of the text, which is long enough to wrap onto another line\n");
+    }
+
+    // Compares the editor's layout with one made from scratch, which can't be affected
+    // by anything left in the layout cache by earlier edits
+    void expectMatchesFreshLayout (TextEditor& editor)
+    {
+        TextEditor reference;
+        reference.setMultiLine (true);
+        reference.setBounds (editor.getBounds());
+        reference.setFont (editor.getFont());
+        reference.setText (editor.getText(), false);
+
+        const auto numChars = editor.getTotalNumChars();
+        expectEquals (reference.getTotalNumChars(), numChars);
+
+        for (int i = 0; i <= numChars; i += 13)
+        {
+            editor.setCaretPosition (i);
+            reference.setCaretPosition (i);
+
+            expect (editor.getCaretRectangle() == reference.getCaretRectangle(),
+                    "Caret position differs at index " + String (i));
+        }
+
+        const auto textHeight = reference.getTextHeight();
+
+        for (int y = 0; y < textHeight; y += 9)
+            for (auto x : { 2, 150, 290 })
+                expectEquals (editor.getTextIndexAt (x, y), reference.getTextIndexAt (x, y));
+    }
+};
+
+static TextEditorTests textEditorTests;
+
+#endif
+
 } // namespace juce
@@ -159,10 +159,7 @@ public:
         {
             owner.recalculateIfNeeded();
 
-            if (! owner.rootItemVisible)
-                y += owner.rootItem->itemHeight;
-
-            if (auto* ti = owner.rootItem->findItemRecursively (y))
+            if (auto* ti = owner.findItemAtY (y))
             {
                 itemPosition = ti->getItemPosition (false);
                 return ti;
@@ -181,27 +178,24 @@ public:
             i->shouldKeep = false;
 
         {
-            auto* item = owner.rootItem;
-            int y = (item != nullptr && ! owner.rootItemVisible) ? -item->itemHeight : 0;
+            owner.updateRowsIfNeeded();
+
+            auto firstVisible = std::partition_point (owner.rows.begin(), owner.rows.end(),
+                                                      [visibleTop] (const TreeViewItem* item) { return item->y + item->itemHeight < visibleTop; });
 
-            while (item != nullptr && y < visibleBottom)
+            for (auto r = firstVisible; r != owner.rows.end() && (*r)->y < visibleBottom; ++r)
             {
-                y += item->itemHeight;
+                auto* item = *r;
 
-                if (y >= visibleTop)
+                if (auto* ri = findItem (item->uid))
                 {
-                    if (auto* ri = findItem (item->uid))
-                    {
-                        ri->shouldKeep = true;
-                    }
-                    else if (auto* comp = item->createItemComponent())
-                    {
-                        items.add (new RowItem (item, comp, item->uid));
-                        addAndMakeVisible (comp);
-                    }
+                    ri->shouldKeep = true;
+                }
+                else if (auto* comp = item->createItemComponent())
+                {
+                    items.add (new RowItem (item, comp, item->uid));
+                    addAndMakeVisible (comp);
                 }
-
-                item = item->getNextVisibleItem (true);
             }
         }
 
@@ -471,6 +465,7 @@ void TreeView::setRootItem (TreeViewItem* const newRootItem)
             newRootItem->setOwnerView (this);
 
         needsRecalculating = true;
+        rowsNeedUpdating = true;
         recalculateIfNeeded();
 
         if (rootItem != nullptr && (defaultOpenness || ! rootItemVisible))
@@ -568,18 +563,18 @@ TreeViewItem* TreeView::getSelectedItem (const int index) const noexcept
 
 int TreeView::getNumRowsInTree() const
 {
-    return rootItem != nullptr ? (rootItem->getNumRows() - (rootItemVisible ? 0 : 1)) : 0;
+    updateRowsIfNeeded();
+    return rootItem != nullptr ? (rows.size() - (rootItemVisible ? 0 : 1)) : 0;
 }
 
 TreeViewItem* TreeView::getItemOnRow (int index) const
 {
+    updateRowsIfNeeded();
+
     if (! rootItemVisible)
         ++index;
 
-    if (rootItem != nullptr && index >= 0)
-        return rootItem->getItemOnRow (index);
-
-    return nullptr;
+    return rows[index];
 }
 
 TreeViewItem* TreeView::getItemAt (int y) const noexcept
@@ -636,6 +631,7 @@ void TreeView::restoreOpennessState (const XmlElement& newState, const bool rest
         rootItem->restoreOpennessState (newState);
 
         needsRecalculating = true;
+        rowsNeedUpdating = true;
         recalculateIfNeeded();
 
         if (newState.hasAttribute ("scrollPos"))
@@ -837,6 +833,7 @@ bool TreeView::keyPressed (const KeyPress& key)
 void TreeView::itemsChanged() noexcept
 {
     needsRecalculating = true;
+    rowsNeedUpdating = true;
     repaint();
     viewport->getContentComp()->triggerAsyncUpdate();
 }
@@ -867,6 +864,42 @@ void TreeView::recalculateIfNeeded()
     }
 }
 
+// The visible items are kept in a flat array in display order, so that looking up a row
+// or the item at a given y position doesn't need to walk the whole tree each time.
+// It's rebuilt lazily whenever the structure or openness of the tree has changed.
+void TreeView::updateRowsIfNeeded() const
+{
+    if (rowsNeedUpdating)
+    {
+        rowsNeedUpdating = false;
+
+        const ScopedLock sl (nodeAlterationLock);
+
+        rows.clearQuick();
+
+        if (rootItem != nullptr)
+            rootItem->addVisibleRows (rows);
+    }
+}
+
+TreeViewItem* TreeView::findItemAtY (int y) const
+{
+    updateRowsIfNeeded();
+
+    auto next = std::upper_bound (rows.begin(), rows.end(), y,
+                                  [] (int targetY, const TreeViewItem* item) { return targetY < item->y; });
+
+    if (next != rows.begin())
+    {
+        auto* item = *(next - 1);
+
+        if (y < item->y + item->itemHeight)
+            return item;
+    }
+
+    return nullptr;
+}
+
 //==============================================================================
 struct TreeView::InsertPoint
 {
@@ -1597,22 +1630,23 @@ void TreeViewItem::paintRecursively (Graphics& g, int width)
     {
         auto clip = g.getClipBounds();
 
-        for (auto* ti : subItems)
+        auto firstVisible = std::partition_point (subItems.begin(), subItems.end(),
+                                                  [this, &clip] (const TreeViewItem* ti) { return ti->y - y + ti->totalHeight < clip.getY(); });
+
+        for (auto s = firstVisible; s != subItems.end(); ++s)
         {
+            auto* ti = *s;
             auto relY = ti->y - y;
 
             if (relY >= clip.getBottom())
                 break;
 
-            if (relY + ti->totalHeight >= clip.getY())
-            {
-                Graphics::ScopedSaveState ss (g);
+            Graphics::ScopedSaveState ss (g);
 
-                g.setOrigin (0, relY);
+            g.setOrigin (0, relY);
 
-                if (g.reduceClipRegion (0, 0, width, ti->totalHeight))
-                    ti->paintRecursively (g, width);
-            }
+            if (g.reduceClipRegion (0, 0, width, ti->totalHeight))
+                ti->paintRecursively (g, width);
         }
     }
 }
@@ -1635,67 +1669,14 @@ TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
                                  : parentItem->getTopLevelItem();
 }
 
-int TreeViewItem::getNumRows() const noexcept
+void TreeViewItem::addVisibleRows (Array<TreeViewItem*>& rows)
 {
-    int num = 1;
+    rowIndex = rows.size();
+    rows.add (this);
 
     if (isOpen())
         for (auto* i : subItems)
-            num += i->getNumRows();
-
-    return num;
-}
-
-TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
-{
-    if (index == 0)
-        return this;
-
-    if (index > 0 && isOpen())
-    {
-        --index;
-
-        for (auto* i : subItems)
-        {
-            if (index == 0)
-                return i;
-
-            auto numRows = i->getNumRows();
-
-            if (numRows > index)
-                return i->getItemOnRow (index);
-
-            index -= numRows;
-        }
-    }
-
-    return nullptr;
-}
-
-TreeViewItem* TreeViewItem::findItemRecursively (int targetY) noexcept
-{
-    if (isPositiveAndBelow (targetY, totalHeight))
-    {
-        auto h = itemHeight;
-
-        if (targetY < h)
-            return this;
-
-        if (isOpen())
-        {
-            targetY -= h;
-
-            for (auto* i : subItems)
-            {
-                if (targetY < i->totalHeight)
-                    return i->findItemRecursively (targetY);
-
-                targetY -= i->totalHeight;
-            }
-        }
-    }
-
-    return nullptr;
+            i->addVisibleRows (rows);
 }
 
 int TreeViewItem::countSelectedItemsRecursively (int depth) const noexcept
@@ -1737,22 +1718,18 @@ int TreeViewItem::getRowNumberInTree() const noexcept
 {
     if (parentItem != nullptr && ownerView != nullptr)
     {
-        if (! parentItem->isOpen())
-            return parentItem->getRowNumberInTree();
-
-        int n = 1 + parentItem->getRowNumberInTree();
+        ownerView->updateRowsIfNeeded();
 
-        int ourIndex = parentItem->subItems.indexOf (this);
-        jassert (ourIndex >= 0);
+        auto& rows = ownerView->rows;
+        auto* item = this;
 
-        while (--ourIndex >= 0)
-            n += parentItem->subItems [ourIndex]->getNumRows();
+        // an item inside a closed parent shares the row of its closest visible parent
+        while (item->parentItem != nullptr
+                && ! (isPositiveAndBelow (item->rowIndex, rows.size()) && rows.getUnchecked (item->rowIndex) == item))
+            item = item->parentItem;
 
-        if (parentItem->parentItem == nullptr
-             && ! ownerView->rootItemVisible)
-            --n;
-
-        return n;
+        if (item->parentItem != nullptr)
+            return item->rowIndex - (ownerView->rootItemVisible ? 0 : 1);
     }
 
     return 0;
@@ -1764,24 +1741,6 @@ void TreeViewItem::setLinesDrawnForSubItems (const bool drawLines) noexcept
     drawLinesSet = true;
 }
 
-TreeViewItem* TreeViewItem::getNextVisibleItem (const bool recurse) const noexcept
-{
-    if (recurse && isOpen() && ! subItems.isEmpty())
-        return subItems.getFirst();
-
-    if (parentItem != nullptr)
-    {
-        const int nextIndex = parentItem->subItems.indexOf (this) + 1;
-
-        if (nextIndex >= parentItem->subItems.size())
-            return parentItem->getNextVisibleItem (false);
-
-        return parentItem->subItems [nextIndex];
-    }
-
-    return nullptr;
-}
-
 static String escapeSlashesInTreeViewItemName (const String& s)
 {
     return s.replaceCharacter ('/', '\\');
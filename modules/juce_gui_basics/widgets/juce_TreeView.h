@@ -123,6 +123,7 @@ public:
     void sortSubItems (ElementComparator& comparator)
     {
         subItems.sort (comparator);
+        treeHasChanged();
     }
 
     //==============================================================================
@@ -582,7 +583,7 @@ private:
     TreeViewItem* parentItem = nullptr;
     OwnedArray<TreeViewItem> subItems;
     int y = 0, itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0;
-    int uid = 0;
+    int uid = 0, rowIndex = -1;
     bool selected           : 1;
     bool redrawNeeded       : 1;
     bool drawLinesInside    : 1;
@@ -598,14 +599,11 @@ private:
     void setOwnerView (TreeView*) noexcept;
     void paintRecursively (Graphics&, int width);
     TreeViewItem* getTopLevelItem() noexcept;
-    TreeViewItem* findItemRecursively (int y) noexcept;
     TreeViewItem* getDeepestOpenParentItem() noexcept;
-    int getNumRows() const noexcept;
-    TreeViewItem* getItemOnRow (int index) noexcept;
+    void addVisibleRows (Array<TreeViewItem*>&);
     void deselectAllRecursively (TreeViewItem* itemToIgnore);
     int countSelectedItemsRecursively (int depth) const noexcept;
     TreeViewItem* getSelectedItemWithIndex (int index) noexcept;
-    TreeViewItem* getNextVisibleItem (bool recurse) const noexcept;
     TreeViewItem* findItemFromIdentifierString (const String&);
     void restoreToDefaultOpenness();
     bool isFullyOpen() const noexcept;
@@ -904,9 +902,13 @@ private:
     int indentSize = -1;
     bool defaultOpenness = false, needsRecalculating = true, rootItemVisible = true;
     bool multiSelectEnabled = false, openCloseButtonsVisible = true;
+    mutable bool rowsNeedUpdating = true;
+    mutable Array<TreeViewItem*> rows;
 
     void itemsChanged() noexcept;
     void recalculateIfNeeded();
+    void updateRowsIfNeeded() const;
+    TreeViewItem* findItemAtY (int y) const;
     void updateButtonUnderMouse (const MouseEvent&);
     struct InsertPoint;
     void showDragHighlight (const InsertPoint&) noexcept;
@@ -32,10 +32,8 @@ public:
     CodeDocumentLine (const String::CharPointerType startOfLine,
                       const String::CharPointerType endOfLine,
                       const int lineLen,
-                      const int numNewLineChars,
-                      const int startInFile)
+                      const int numNewLineChars)
         : line (startOfLine, endOfLine),
-          lineStartInFile (startInFile),
           lineLength (lineLen),
           lineLengthWithoutNewLines (lineLen - numNewLineChars)
     {
@@ -50,7 +48,6 @@ public:
         while (! (finished || t.isEmpty()))
         {
             auto startOfLine = t;
-            auto startOfLineInFile = charNumInFile;
             int lineLength = 0;
             int numNewLineChars = 0;
 
@@ -89,8 +86,7 @@ public:
                 }
             }
 
-            newLines.add (new CodeDocumentLine (startOfLine, t, lineLength,
-                                                numNewLineChars, startOfLineInFile));
+            newLines.add (new CodeDocumentLine (startOfLine, t, lineLength, numNewLineChars));
         }
 
         jassert (charNumInFile == text.length());
@@ -121,7 +117,408 @@ public:
     }
 
     String line;
-    int lineStartInFile, lineLength, lineLengthWithoutNewLines;
+    int lineLength, lineLengthWithoutNewLines;
+};
+
+//==============================================================================
+/*  Holds the document's lines in chunks of a few hundred, with Fenwick trees over
+    the chunks' line and character counts.
+
+    Finding the line that contains a character position, or the character position
+    at which a line starts, is a logarithmic search over the chunks followed by a
+    binary search inside one chunk. Edits only touch the chunks that contain the
+    affected lines, so unlike a flat array of lines with absolute start offsets,
+    nothing after the edited region needs to be updated.
+*/
+struct CodeDocument::LineIndex
+{
+    LineIndex() = default;
+
+    int size() const noexcept                { return totalLines; }
+    int getNumCharacters() const noexcept    { return totalChars; }
+
+    CodeDocumentLine* getLine (int index) const noexcept
+    {
+        if (! isPositiveAndBelow (index, totalLines))
+            return nullptr;
+
+        auto& loc = locateLine (index);
+        return chunks.getUnchecked (loc.chunk)->lines.getUnchecked (index - loc.firstLine);
+    }
+
+    CodeDocumentLine* getLast() const noexcept
+    {
+        return getLine (totalLines - 1);
+    }
+
+    int getLineStart (int index) const noexcept
+    {
+        if (totalLines == 0)
+            return 0;
+
+        if (index >= totalLines)
+            return totalChars;
+
+        auto& loc = locateLine (jmax (0, index));
+        return loc.firstChar + chunks.getUnchecked (loc.chunk)->lineStarts[(size_t) (index - loc.firstLine)];
+    }
+
+    /** Returns the line containing a character position, clamped to the last line. */
+    int findLineContaining (int position) const noexcept
+    {
+        if (totalLines == 0 || position <= 0)
+            return 0;
+
+        if (position >= totalChars)
+            return totalLines - 1;
+
+        auto remainder = position;
+        auto chunkIndex = charCounts.find (remainder);
+        auto& starts = chunks.getUnchecked (chunkIndex)->lineStarts;
+        auto indexInChunk = (int) (std::upper_bound (starts.begin(), starts.end(), remainder) - starts.begin()) - 1;
+
+        return lineCounts.getPrefix (chunkIndex) + indexInChunk;
+    }
+
+    int getMaximumLineLength() const noexcept
+    {
+        int result = 0;
+
+        for (auto* c : chunks)
+            result = jmax (result, c->maximumLineLength);
+
+        return result;
+    }
+
+    //==============================================================================
+    /** Replaces numToRemove lines starting at index with newLines, taking ownership of them. */
+    void replace (int index, int numToRemove, const Array<CodeDocumentLine*>& newLines)
+    {
+        jassert (index >= 0 && index + numToRemove <= totalLines);
+
+        if (numToRemove > 0)
+            remove (index, numToRemove);
+
+        if (newLines.isEmpty())
+            return;
+
+        if (chunks.isEmpty())
+        {
+            chunks.add (new Chunk());
+            needsRebuilding = true;
+        }
+
+        // Inserting at the very end goes into the last chunk
+        auto chunkIndex = chunks.size() - 1;
+        auto indexInChunk = chunks.getLast()->lines.size();
+
+        if (index < totalLines)
+        {
+            auto& loc = locateLine (index);
+            chunkIndex = loc.chunk;
+            indexInChunk = index - loc.firstLine;
+        }
+
+        auto& chunk = *chunks.getUnchecked (chunkIndex);
+        auto oldChars = chunk.numChars;
+
+        chunk.lines.insertArray (indexInChunk, newLines.begin(), newLines.size());
+        totalLines += newLines.size();
+
+        if (chunk.lines.size() > maxLinesPerChunk)
+        {
+            split (chunkIndex);
+        }
+        else
+        {
+            chunk.update();
+            chunkChanged (chunkIndex, newLines.size(), chunk.numChars - oldChars);
+        }
+
+        finishEdit();
+    }
+
+    void remove (int index, int numToRemove)
+    {
+        numToRemove = jmin (numToRemove, totalLines - index);
+
+        if (numToRemove <= 0)
+            return;
+
+        auto& loc = locateLine (index);
+        auto chunkIndex = loc.chunk;
+        auto indexInChunk = index - loc.firstLine;
+
+        while (numToRemove > 0)
+        {
+            auto& chunk = *chunks.getUnchecked (chunkIndex);
+            auto num = jmin (numToRemove, chunk.lines.size() - indexInChunk);
+            auto oldChars = chunk.numChars;
+
+            chunk.lines.removeRange (indexInChunk, num);
+            totalLines -= num;
+            numToRemove -= num;
+            indexInChunk = 0;
+
+            if (chunk.lines.isEmpty())
+            {
+                totalChars -= oldChars;
+                chunks.remove (chunkIndex);
+                needsRebuilding = true;
+            }
+            else
+            {
+                chunk.update();
+                chunkChanged (chunkIndex, -num, chunk.numChars - oldChars);
+                ++chunkIndex;
+            }
+        }
+
+        mergeIfSmall (jmin (chunkIndex, chunks.size() - 1));
+        finishEdit();
+    }
+
+    void add (CodeDocumentLine* lineToAdd)
+    {
+        replace (totalLines, 0, Array<CodeDocumentLine*> (lineToAdd));
+    }
+
+    /** Must be called after changing the text of a line in-place. */
+    void lineChanged (int index)
+    {
+        auto& loc = locateLine (index);
+        auto chunkIndex = loc.chunk;
+        auto& chunk = *chunks.getUnchecked (chunkIndex);
+        auto oldChars = chunk.numChars;
+
+        chunk.update();
+        chunkChanged (chunkIndex, 0, chunk.numChars - oldChars);
+        finishEdit();
+    }
+
+private:
+    //==============================================================================
+    static constexpr int maxLinesPerChunk = 512;
+    static constexpr int linesPerSplitChunk = 256;
+
+    struct Chunk
+    {
+        OwnedArray<CodeDocumentLine> lines;
+        std::vector<int> lineStarts;
+        int numChars = 0, maximumLineLength = 0;
+
+        void update()
+        {
+            lineStarts.resize ((size_t) lines.size());
+            numChars = 0;
+            maximumLineLength = 0;
+
+            for (int i = 0; i < lines.size(); ++i)
+            {
+                auto len = lines.getUnchecked (i)->lineLength;
+                lineStarts[(size_t) i] = numChars;
+                numChars += len;
+                maximumLineLength = jmax (maximumLineLength, len);
+            }
+        }
+    };
+
+    struct FenwickTree
+    {
+        void rebuild (const std::vector<int>& values)
+        {
+            auto n = values.size();
+            tree.assign (n + 1, 0);
+
+            for (size_t i = 1; i <= n; ++i)
+            {
+                tree[i] += values[i - 1];
+                auto parent = i + (i & (~i + 1));
+
+                if (parent <= n)
+                    tree[parent] += tree[i];
+            }
+
+            topBit = 1;
+
+            while (topBit * 2 <= n)
+                topBit *= 2;
+        }
+
+        void add (int index, int delta) noexcept
+        {
+            for (auto i = (size_t) index + 1; i < tree.size(); i += (i & (~i + 1)))
+                tree[i] += delta;
+        }
+
+        /** Returns the sum of the first count values. */
+        int getPrefix (int count) const noexcept
+        {
+            int sum = 0;
+
+            for (auto i = (size_t) count; i > 0; i -= (i & (~i + 1)))
+                sum += tree[i];
+
+            return sum;
+        }
+
+        /** Returns the index of the value that contains target (i.e. the last index whose
+            prefix is <= target) and subtracts that prefix from target.
+        */
+        int find (int& target) const noexcept
+        {
+            size_t pos = 0;
+
+            for (auto step = topBit; step > 0; step >>= 1)
+            {
+                if (pos + step < tree.size() && tree[pos + step] <= target)
+                {
+                    pos += step;
+                    target -= tree[pos];
+                }
+            }
+
+            return (int) pos;
+        }
+
+        std::vector<int> tree;
+        size_t topBit = 1;
+    };
+
+    struct Location
+    {
+        int chunk = 0, firstLine = 0, firstChar = 0;
+    };
+
+    OwnedArray<Chunk> chunks;
+    FenwickTree lineCounts, charCounts;
+    int totalLines = 0, totalChars = 0;
+    bool needsRebuilding = false;
+
+    // Most lookups are close to the previous one, so the last chunk found is
+    // remembered and checked first.
+    mutable Location lastLocation;
+
+    const Location& locateLine (int index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, totalLines) && ! needsRebuilding);
+
+        auto& loc = lastLocation;
+
+        if (isPositiveAndBelow (loc.chunk, chunks.size()))
+        {
+            auto numInChunk = chunks.getUnchecked (loc.chunk)->lines.size();
+
+            if (index >= loc.firstLine && index < loc.firstLine + numInChunk)
+                return loc;
+
+            if (index >= loc.firstLine + numInChunk && loc.chunk + 1 < chunks.size()
+                 && index < loc.firstLine + numInChunk + chunks.getUnchecked (loc.chunk + 1)->lines.size())
+            {
+                loc.firstChar += chunks.getUnchecked (loc.chunk)->numChars;
+                loc.firstLine += numInChunk;
+                ++loc.chunk;
+                return loc;
+            }
+        }
+
+        auto remainder = index;
+        loc.chunk = lineCounts.find (remainder);
+        loc.firstLine = index - remainder;
+        loc.firstChar = charCounts.getPrefix (loc.chunk);
+        return loc;
+    }
+
+    void chunkChanged (int chunkIndex, int lineDelta, int charDelta)
+    {
+        totalChars += charDelta;
+
+        if (! needsRebuilding)
+        {
+            lineCounts.add (chunkIndex, lineDelta);
+            charCounts.add (chunkIndex, charDelta);
+        }
+    }
+
+    void split (int chunkIndex)
+    {
+        auto& source = *chunks.getUnchecked (chunkIndex);
+        auto numLines = source.lines.size();
+        Array<Chunk*> newChunks;
+
+        for (int start = linesPerSplitChunk; start < numLines; start += linesPerSplitChunk)
+        {
+            auto* newChunk = new Chunk();
+            newChunks.add (newChunk);
+
+            for (int i = start; i < jmin (start + linesPerSplitChunk, numLines); ++i)
+                newChunk->lines.add (source.lines.getUnchecked (i));
+
+            newChunk->update();
+        }
+
+        source.lines.removeRange (linesPerSplitChunk, numLines - linesPerSplitChunk, false);
+        totalChars -= source.numChars;
+        source.update();
+        totalChars += source.numChars;
+
+        for (auto* c : newChunks)
+            totalChars += c->numChars;
+
+        chunks.insertArray (chunkIndex + 1, newChunks.begin(), newChunks.size());
+        needsRebuilding = true;
+    }
+
+    void mergeIfSmall (int chunkIndex)
+    {
+        if (! isPositiveAndBelow (chunkIndex, chunks.size()))
+            return;
+
+        for (auto first : { chunkIndex - 1, chunkIndex })
+        {
+            if (first < 0 || first + 1 >= chunks.size())
+                continue;
+
+            auto& a = *chunks.getUnchecked (first);
+            auto& b = *chunks.getUnchecked (first + 1);
+
+            if (a.lines.size() + b.lines.size() <= linesPerSplitChunk)
+            {
+                for (auto* l : b.lines)
+                    a.lines.add (l);
+
+                b.lines.clear (false);
+                chunks.remove (first + 1);
+                a.update();
+                needsRebuilding = true;
+                return;
+            }
+        }
+    }
+
+    void finishEdit()
+    {
+        lastLocation = {};
+
+        if (! needsRebuilding)
+            return;
+
+        std::vector<int> lineValues, charValues;
+        lineValues.reserve ((size_t) chunks.size());
+        charValues.reserve ((size_t) chunks.size());
+
+        for (auto* c : chunks)
+        {
+            lineValues.push_back (c->lines.size());
+            charValues.push_back (c->numChars);
+        }
+
+        lineCounts.rebuild (lineValues);
+        charCounts.rebuild (charValues);
+        needsRebuilding = false;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LineIndex)
 };
 
 //==============================================================================
@@ -163,7 +560,7 @@ bool CodeDocument::Iterator::reinitialiseCharPtr() const
 
     if (charPointer.getAddress() == nullptr)
     {
-        if (auto* l = document->lines[line])
+        if (auto* l = document->lines->getLine (line))
             charPointer = l->line.getCharPointer();
         else
             return false;
@@ -216,7 +613,7 @@ void CodeDocument::Iterator::skipToStartOfLine() noexcept
     if (! reinitialiseCharPtr())
         return;
 
-    if (auto* l = document->lines [line])
+    if (auto* l = document->lines->getLine (line))
     {
         auto startPtr = l->line.getCharPointer();
         position -= (int) startPtr.lengthUpTo (charPointer);
@@ -232,7 +629,7 @@ juce_wchar CodeDocument::Iterator::peekNextChar() const noexcept
     if (auto c = *charPointer)
         return c;
 
-    if (auto* l = document->lines [line + 1])
+    if (auto* l = document->lines->getLine (line + 1))
         return l->line[0];
 
     return 0;
@@ -245,7 +642,7 @@ juce_wchar CodeDocument::Iterator::previousChar() noexcept
 
     for (;;)
     {
-        if (auto* l = document->lines[line])
+        if (auto* l = document->lines->getLine (line))
         {
             if (charPointer != l->line.getCharPointer())
             {
@@ -260,7 +657,7 @@ juce_wchar CodeDocument::Iterator::previousChar() noexcept
 
         --line;
 
-        if (auto* prev = document->lines[line])
+        if (auto* prev = document->lines->getLine (line))
             charPointer = prev->line.getCharPointer().findTerminatingNull();
     }
 
@@ -272,12 +669,12 @@ juce_wchar CodeDocument::Iterator::peekPreviousChar() const noexcept
     if (! reinitialiseCharPtr())
         return 0;
 
-    if (auto* l = document->lines[line])
+    if (auto* l = document->lines->getLine (line))
     {
         if (charPointer != l->line.getCharPointer())
             return *(charPointer - 1);
 
-        if (auto* prev = document->lines[line - 1])
+        if (auto* prev = document->lines->getLine (line - 1))
             return *(prev->line.getCharPointer().findTerminatingNull() - 1);
     }
 
@@ -292,7 +689,7 @@ void CodeDocument::Iterator::skipWhitespace() noexcept
 
 bool CodeDocument::Iterator::isEOF() const noexcept
 {
-    return charPointer.getAddress() == nullptr && line >= document->lines.size();
+    return charPointer.getAddress() == nullptr && line >= document->lines->size();
 }
 
 bool CodeDocument::Iterator::isSOF() const noexcept
@@ -302,7 +699,7 @@ bool CodeDocument::Iterator::isSOF() const noexcept
 
 CodeDocument::Position CodeDocument::Iterator::toPosition() const
 {
-    if (auto* l = document->lines[line])
+    if (auto* l = document->lines->getLine (line))
     {
         reinitialiseCharPtr();
         int indexInLine = 0;
@@ -319,9 +716,9 @@ CodeDocument::Position CodeDocument::Iterator::toPosition() const
 
     if (isEOF())
     {
-        if (auto* last = document->lines.getLast())
+        if (auto* last = document->lines->getLast())
         {
-            auto lineIndex = document->lines.size() - 1;
+            auto lineIndex = document->lines->size() - 1;
             return CodeDocument::Position (*document, lineIndex, last->lineLength);
         }
     }
@@ -400,7 +797,9 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 {
     jassert (owner != nullptr);
 
-    if (owner->lines.size() == 0)
+    auto& lines = *owner->lines;
+
+    if (lines.size() == 0)
     {
         line = 0;
         indexInLine = 0;
@@ -408,26 +807,26 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
     }
     else
     {
-        if (newLineNum >= owner->lines.size())
+        if (newLineNum >= lines.size())
         {
-            line = owner->lines.size() - 1;
+            line = lines.size() - 1;
 
-            auto& l = *owner->lines.getUnchecked (line);
+            auto& l = *lines.getLine (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = lines.getLineStart (line) + indexInLine;
         }
         else
         {
             line = jmax (0, newLineNum);
 
-            auto& l = *owner->lines.getUnchecked (line);
+            auto& l = *lines.getLine (line);
 
             if (l.lineLengthWithoutNewLines > 0)
                 indexInLine = jlimit (0, l.lineLengthWithoutNewLines, newIndexInLine);
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = lines.getLineStart (line) + indexInLine;
         }
     }
 }
@@ -440,40 +839,15 @@ void CodeDocument::Position::setPosition (const int newPosition)
     indexInLine = 0;
     characterPos = 0;
 
-    if (newPosition > 0)
+    if (newPosition > 0 && owner->lines->size() > 0)
     {
-        int lineStart = 0;
-        auto lineEnd = owner->lines.size();
+        auto& lines = *owner->lines;
 
-        for (;;)
-        {
-            if (lineEnd - lineStart < 4)
-            {
-                for (int i = lineStart; i < lineEnd; ++i)
-                {
-                    auto& l = *owner->lines.getUnchecked (i);
-                    auto index = newPosition - l.lineStartInFile;
+        line = lines.findLineContaining (newPosition);
 
-                    if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
-                    {
-                        line = i;
-                        indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
-                    }
-                }
-
-                break;
-            }
-            else
-            {
-                auto midIndex = (lineStart + lineEnd + 1) / 2;
-
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
-                    lineStart = midIndex;
-                else
-                    lineEnd = midIndex;
-            }
-        }
+        auto lineStart = lines.getLineStart (line);
+        indexInLine = jmin (lines.getLine (line)->lineLengthWithoutNewLines, newPosition - lineStart);
+        characterPos = lineStart + indexInLine;
     }
 }
 
@@ -486,12 +860,11 @@ void CodeDocument::Position::moveBy (int characterDelta)
         setPosition (getPosition());
 
         // If moving right, make sure we don't get stuck between the \r and \n characters..
-        if (line < owner->lines.size())
+        if (auto* l = owner->lines->getLine (line))
         {
-            auto& l = *owner->lines.getUnchecked (line);
 
-            if (indexInLine + characterDelta < l.lineLength
-                 && indexInLine + characterDelta >= l.lineLengthWithoutNewLines + 1)
+            if (indexInLine + characterDelta < l->lineLength
+                 && indexInLine + characterDelta >= l->lineLengthWithoutNewLines + 1)
                 ++characterDelta;
         }
     }
@@ -515,7 +888,7 @@ CodeDocument::Position CodeDocument::Position::movedByLines (const int deltaLine
 
 juce_wchar CodeDocument::Position::getCharacter() const
 {
-    if (auto* l = owner->lines [line])
+    if (auto* l = owner->lines->getLine (line))
         return l->line [getIndexInLine()];
 
     return 0;
@@ -523,7 +896,7 @@ juce_wchar CodeDocument::Position::getCharacter() const
 
 String CodeDocument::Position::getLineText() const
 {
-    if (auto* l = owner->lines [line])
+    if (auto* l = owner->lines->getLine (line))
         return l->line;
 
     return {};
@@ -553,7 +926,9 @@ void CodeDocument::Position::setPositionMaintained (const bool isMaintained)
 }
 
 //==============================================================================
-CodeDocument::CodeDocument() : undoManager (std::numeric_limits<int>::max(), 10000)
+CodeDocument::CodeDocument()
+    : lines (std::make_unique<LineIndex>()),
+      undoManager (std::numeric_limits<int>::max(), 10000)
 {
 }
 
@@ -564,7 +939,7 @@ CodeDocument::~CodeDocument()
 String CodeDocument::getAllContent() const
 {
     return getTextBetween (Position (*this, 0),
-                           Position (*this, lines.size(), 0));
+                           Position (*this, lines->size(), 0));
 }
 
 String CodeDocument::getTextBetween (const Position& start, const Position& end) const
@@ -577,7 +952,7 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 
     if (startLine == endLine)
     {
-        if (auto* line = lines [startLine])
+        if (auto* line = lines->getLine (startLine))
             return line->line.substring (start.getIndexInLine(), end.getIndexInLine());
 
         return {};
@@ -586,11 +961,11 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
     MemoryOutputStream mo;
     mo.preallocate ((size_t) (end.getPosition() - start.getPosition() + 4));
 
-    auto maxLine = jmin (lines.size() - 1, endLine);
+    auto maxLine = jmin (lines->size() - 1, endLine);
 
     for (int i = jmax (0, startLine); i <= maxLine; ++i)
     {
-        auto& line = *lines.getUnchecked(i);
+        auto& line = *lines->getLine (i);
         auto len = line.lineLength;
 
         if (i == startLine)
@@ -614,15 +989,17 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 
 int CodeDocument::getNumCharacters() const noexcept
 {
-    if (auto* lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
+    return lines->getNumCharacters();
+}
 
-    return 0;
+int CodeDocument::getNumLines() const noexcept
+{
+    return lines->size();
 }
 
 String CodeDocument::getLine (const int lineIndex) const noexcept
 {
-    if (auto* line = lines[lineIndex])
+    if (auto* line = lines->getLine (lineIndex))
         return line->line;
 
     return {};
@@ -631,12 +1008,7 @@ String CodeDocument::getLine (const int lineIndex) const noexcept
 int CodeDocument::getMaximumLineLength() noexcept
 {
     if (maximumLineLength < 0)
-    {
-        maximumLineLength = 0;
-
-        for (auto* l : lines)
-            maximumLineLength = jmax (maximumLineLength, l->lineLength);
-    }
+        maximumLineLength = lines->getMaximumLineLength();
 
     return maximumLineLength;
 }
@@ -700,9 +1072,9 @@ bool CodeDocument::loadFromStream (InputStream& stream)
 
 bool CodeDocument::writeToStream (OutputStream& stream)
 {
-    for (auto* l : lines)
+    for (int i = 0; i < lines->size(); ++i)
     {
-        auto temp = l->line; // use a copy to avoid bloating the memory footprint of the stored string.
+        auto temp = lines->getLine (i)->line; // use a copy to avoid bloating the memory footprint of the stored string.
         const char* utf8 = temp.toUTF8();
 
         if (! stream.write (utf8, strlen (utf8)))
@@ -856,21 +1228,20 @@ void CodeDocument::findLineContaining  (const Position& pos, Position& s, Positi
 
 void CodeDocument::checkLastLineStatus()
 {
-    while (lines.size() > 0
-            && lines.getLast()->lineLength == 0
-            && (lines.size() == 1 || ! lines.getUnchecked (lines.size() - 2)->endsWithLineBreak()))
+    while (lines->size() > 0
+            && lines->getLast()->lineLength == 0
+            && (lines->size() == 1 || ! lines->getLine (lines->size() - 2)->endsWithLineBreak()))
     {
         // remove any empty lines at the end if the preceding line doesn't end in a newline.
-        lines.removeLast();
+        lines->remove (lines->size() - 1, 1);
     }
 
-    const CodeDocumentLine* const lastLine = lines.getLast();
+    const CodeDocumentLine* const lastLine = lines->getLast();
 
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
         // check that there's an empty line at the end if the preceding one ends in a newline..
-        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
-                                         lastLine->lineStartInFile + lastLine->lineLength));
+        lines->add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0));
     }
 }
 
@@ -922,7 +1293,7 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
             Position pos (*this, insertPos);
             auto firstAffectedLine = pos.getLineNumber();
 
-            auto* firstLine = lines[firstAffectedLine];
+            auto* firstLine = lines->getLine (firstAffectedLine);
             auto textInsideOriginalLine = text;
 
             if (firstLine != nullptr)
@@ -938,21 +1309,7 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
             CodeDocumentLine::createLines (newLines, textInsideOriginalLine);
             jassert (newLines.size() > 0);
 
-            auto* newFirstLine = newLines.getUnchecked (0);
-            newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
-            lines.set (firstAffectedLine, newFirstLine);
-
-            if (newLines.size() > 1)
-                lines.insertArray (firstAffectedLine + 1, newLines.getRawDataPointer() + 1, newLines.size() - 1);
-
-            int lineStart = newFirstLine->lineStartInFile;
-
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
-            {
-                auto& l = *lines.getUnchecked (i);
-                l.lineStartInFile = lineStart;
-                lineStart += l.lineLength;
-            }
+            lines->replace (firstAffectedLine, firstLine != nullptr ? 1 : 0, newLines);
 
             checkLastLineStatus();
             auto newTextLength = text.length();
@@ -1016,31 +1373,26 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
         maximumLineLength = -1;
         auto firstAffectedLine = startPosition.getLineNumber();
         auto endLine = endPosition.getLineNumber();
-        auto& firstLine = *lines.getUnchecked (firstAffectedLine);
+        auto& firstLine = *lines->getLine (firstAffectedLine);
 
         if (firstAffectedLine == endLine)
         {
             firstLine.line = firstLine.line.substring (0, startPosition.getIndexInLine())
                            + firstLine.line.substring (endPosition.getIndexInLine());
             firstLine.updateLength();
+            lines->lineChanged (firstAffectedLine);
         }
         else
         {
-            auto& lastLine = *lines.getUnchecked (endLine);
+            auto& lastLine = *lines->getLine (endLine);
 
             firstLine.line = firstLine.line.substring (0, startPosition.getIndexInLine())
                             + lastLine.line.substring (endPosition.getIndexInLine());
             firstLine.updateLength();
+            lines->lineChanged (firstAffectedLine);
 
             int numLinesToRemove = endLine - firstAffectedLine;
-            lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
-        }
-
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            auto& l = *lines.getUnchecked (i);
-            auto& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
+            lines->remove (firstAffectedLine + 1, numLinesToRemove);
         }
 
         checkLastLineStatus();
@@ -1287,6 +1639,76 @@ struct CodeDocumentTest  : public UnitTest
                 expectEquals (p3.getIndexInLine(), d.getLine (d.getNumLines() - 1).length(), comment3);
             }
         }
+
+        {
+            beginTest ("Random edits on a large document");
+
+            auto r = getRandom();
+
+            const auto makeText = [&r] (int numLines)
+            {
+                String text;
+
+                for (int i = 0; i < numLines; ++i)
+                {
+                    text << String::repeatedString ("x", r.nextInt (40)) << i;
+
+                    if (r.nextInt (4) != 0)
+                        text << "\n";
+                }
+
+                return text;
+            };
+
+            String reference (makeText (5000));
+
+            CodeDocument d;
+            d.replaceAllContent (reference);
+
+            for (int i = 0; i < 300; ++i)
+            {
+                auto pos = r.nextInt (reference.length() + 1);
+
+                if (r.nextBool())
+                {
+                    auto text = makeText (r.nextInt (1000));
+                    d.insertText (pos, text);
+                    reference = reference.substring (0, pos) + text + reference.substring (pos);
+                }
+                else
+                {
+                    auto end = jmin (reference.length(), pos + r.nextInt (r.nextBool() ? 100 : 20000));
+                    d.deleteSection (pos, end);
+                    reference = reference.substring (0, pos) + reference.substring (end);
+                }
+
+                expectEquals (d.getNumCharacters(), reference.length());
+            }
+
+            expectEquals (d.getAllContent(), reference);
+            expectEquals (d.getNumLines(), StringArray::fromLines (reference).size());
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto pos = r.nextInt (reference.length() + 1);
+                CodeDocument::Position p (d, pos);
+
+                expectEquals (p.getPosition(), pos);
+                expect (CodeDocument::Position (d, p.getLineNumber(), p.getIndexInLine()) == p);
+                expectEquals (p.getCharacter(), reference[pos]);
+            }
+
+            int maxLength = 0;
+
+            for (int i = 0; i < d.getNumLines(); ++i)
+                maxLength = jmax (maxLength, d.getLine (i).length());
+
+            expectEquals (d.getMaximumLineLength(), maxLength);
+
+            d.deleteSection (0, d.getNumCharacters());
+            expectEquals (d.getNumLines(), 0);
+            expectEquals (d.getNumCharacters(), 0);
+        }
     }
 };
 
@@ -35,8 +35,10 @@ class CodeDocumentLine;
 
     When using a CodeEditorComponent, it takes one of these as its source object.
 
-    The CodeDocument stores its content as an array of lines, which makes it
-    quick to insert and delete.
+    The CodeDocument stores its content as a list of lines, grouped into chunks
+    with a balanced index of their line and character counts. Finding a line or
+    a character position and editing the text are all logarithmic in the size of
+    the document, so very large files remain responsive.
 
     @see CodeEditorComponent
 
@@ -201,7 +203,7 @@ public:
     int getNumCharacters() const noexcept;
 
     /** Returns the number of lines in the document. */
-    int getNumLines() const noexcept                    { return lines.size(); }
+    int getNumLines() const noexcept;
 
     /** Returns the number of characters in the longest line of the document. */
     int getMaximumLineLength() noexcept;
@@ -429,10 +431,11 @@ private:
     //==============================================================================
     struct InsertAction;
     struct DeleteAction;
+    struct LineIndex;
     friend class Iterator;
     friend class Position;
 
-    OwnedArray<CodeDocumentLine> lines;
+    std::unique_ptr<LineIndex> lines;
     Array<Position*> positionsToMaintain;
     UndoManager undoManager;
     int currentActionIndex = 0, indexOfSavedState = -1;
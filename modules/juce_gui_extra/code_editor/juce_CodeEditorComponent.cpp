@@ -268,12 +268,12 @@ private:
 
     void codeDocumentTextInserted (const String& newText, int pos) override
     {
-        owner.codeDocumentChanged (pos, pos + newText.length());
+        owner.codeDocumentChanged (pos, pos + newText.length(), newText.length());
     }
 
     void codeDocumentTextDeleted (int start, int end) override
     {
-        owner.codeDocumentChanged (start, end);
+        owner.codeDocumentChanged (start, end, start - end);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
@@ -528,6 +528,9 @@ void CodeEditorComponent::rebuildLineTokens()
 
     jassert (numNeeded == lines.size());
 
+    if (! pendingCachedPositions.isEmpty())
+        updateCachedIterators (firstLineOnScreen);
+
     CodeDocument::Iterator source (document);
     getIteratorForPosition (CodeDocument::Position (document, firstLineOnScreen, 0).getPosition(), source);
 
@@ -549,12 +552,12 @@ void CodeEditorComponent::rebuildLineTokens()
         gutter->documentChanged (document, firstLineOnScreen);
 }
 
-void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int endIndex)
+void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int endIndex, const int lengthChange)
 {
     const CodeDocument::Position affectedTextStart (document, startIndex);
     const CodeDocument::Position affectedTextEnd (document, endIndex);
 
-    retokenise (startIndex, endIndex);
+    retokeniseEditedRegion (startIndex, lengthChange > 0 ? startIndex : endIndex, lengthChange);
 
     updateCaretPosition();
     columnToTryToMaintain = -1;
@@ -581,6 +584,43 @@ void CodeEditorComponent::retokenise (int startIndex, int endIndex)
     rebuildLineTokensAsync();
 }
 
+void CodeEditorComponent::retokeniseEditedRegion (int start, int oldEnd, int lengthChange)
+{
+    // The token boundaries that were cached after the edited text are kept, moved by
+    // the change in length. Tokenising restarts from before the edit, and as soon as it
+    // lands on one of these old boundaries again, everything after it must be unchanged,
+    // so the rest of the cache can be restored instead of re-tokenising the whole document.
+    auto firstLineToBeInvalid = CodeDocument::Position (document, start).getLineNumber();
+    auto invalidStart = CodeDocument::Position (document, jmax (0, firstLineToBeInvalid - 1), 0).getPosition();
+
+    int firstToRemove;
+    for (firstToRemove = cachedIterators.size(); --firstToRemove >= 0;)
+        if (cachedIterators.getUnchecked (firstToRemove).getLine() < firstLineToBeInvalid)
+            break;
+
+    firstToRemove = jmax (0, firstToRemove - 1);
+
+    Array<int> oldPositions;
+
+    for (int i = firstToRemove; i < cachedIterators.size(); ++i)
+        oldPositions.add (cachedIterators.getReference (i).getPosition());
+
+    oldPositions.addArray (pendingCachedPositions);
+
+    cachedIterators.removeRange (firstToRemove, cachedIterators.size());
+    pendingCachedPositions.clearQuick();
+
+    for (auto pos : oldPositions)
+    {
+        if (pos < invalidStart)
+            pendingCachedPositions.add (pos);
+        else if (pos >= oldEnd && pos > start)
+            pendingCachedPositions.add (pos + lengthChange);
+    }
+
+    rebuildLineTokensAsync();
+}
+
 //==============================================================================
 void CodeEditorComponent::updateCaretPosition()
 {
@@ -1565,6 +1605,34 @@ void CodeEditorComponent::clearCachedIterators (const int firstLineToBeInvalid)
             break;
 
     cachedIterators.removeRange (jmax (0, i - 1), cachedIterators.size());
+    pendingCachedPositions.clear();
+}
+
+bool CodeEditorComponent::restorePendingCachedIterators (const CodeDocument::Iterator& source)
+{
+    auto position = source.getPosition();
+    int numPassed = 0;
+
+    while (numPassed < pendingCachedPositions.size() && pendingCachedPositions.getUnchecked (numPassed) < position)
+        ++numPassed;
+
+    pendingCachedPositions.removeRange (0, numPassed);
+
+    if (pendingCachedPositions.isEmpty() || pendingCachedPositions.getFirst() != position)
+        return false;
+
+    for (int i = 1; i < pendingCachedPositions.size(); ++i)
+    {
+        CodeDocument::Iterator t (CodeDocument::Position (document, pendingCachedPositions.getUnchecked (i)));
+
+        if (t.getPosition() != pendingCachedPositions.getUnchecked (i))
+            break;
+
+        cachedIterators.add (t);
+    }
+
+    pendingCachedPositions.clear();
+    return true;
 }
 
 void CodeEditorComponent::updateCachedIterators (int maxLineNum)
@@ -1592,7 +1660,7 @@ void CodeEditorComponent::updateCachedIterators (int maxLineNum)
             {
                 codeTokeniser->readNextToken (t);
 
-                if (t.getLine() >= targetLine)
+                if (t.getLine() >= targetLine || restorePendingCachedIterators (t))
                     break;
 
                 if (t.isEOF())
@@ -421,10 +421,13 @@ private:
     OwnedArray<CodeEditorLine> lines;
     void rebuildLineTokens();
     void rebuildLineTokensAsync();
-    void codeDocumentChanged (int start, int end);
+    void codeDocumentChanged (int start, int end, int lengthChange);
 
     Array<CodeDocument::Iterator> cachedIterators;
+    Array<int> pendingCachedPositions;
     void clearCachedIterators (int firstLineToBeInvalid);
+    void retokeniseEditedRegion (int start, int oldEnd, int lengthChange);
+    bool restorePendingCachedIterators (const CodeDocument::Iterator&);
     void updateCachedIterators (int maxLineNum);
     void getIteratorForPosition (int position, CodeDocument::Iterator&);
 